@@ -0,0 +1,250 @@
+#include <cstdio>
+#include <chrono>
+#include <algorithm>
+#ifdef _WIN32
+#include <malloc.h>
+#elif defined( __APPLE__ )
+#include <malloc/malloc.h>
+#else
+#include <malloc.h>
+#endif
+
+#include "AllocationProfiler.h"
+
+namespace base {
+
+size_t AllocationProfiler::s_sample_rate = 0;
+std::array< std::atomic< uint8_t >, AllocationProfiler::FILTER_SIZE > AllocationProfiler::s_filter = {};
+std::mutex AllocationProfiler::s_rings_mutex;
+std::vector< std::unique_ptr< AllocationProfiler::ring_t > > AllocationProfiler::s_rings = {};
+std::atomic< uint64_t > AllocationProfiler::s_next_sequence = 0;
+std::atomic< size_t > AllocationProfiler::s_dropped_events_count = 0;
+std::mutex AllocationProfiler::s_state_mutex;
+std::unordered_map< const void*, AllocationProfiler::live_t > AllocationProfiler::s_live = {};
+std::unordered_map< const AllocationProfiler::callsite_t*, AllocationProfiler::callsite_stats_t > AllocationProfiler::s_callsites = {};
+std::vector< AllocationProfiler::event_t > AllocationProfiler::s_pending_frees = {};
+
+void AllocationProfiler::Start( const size_t sample_rate ) {
+	s_sample_rate = std::max< size_t >( sample_rate, 1 );
+	s_is_enabled = true;
+}
+
+void AllocationProfiler::OnSampledAlloc( const void* ptr, const size_t size, const callsite_t* callsite ) {
+	if ( !s_random_state ) {
+		s_random_state = std::chrono::steady_clock::now().time_since_epoch().count() ^ (uint64_t)&s_random_state;
+		if ( !s_random_state ) {
+			s_random_state = 1;
+		}
+	}
+
+	// every allocation that crosses sample point is sampled, distances between sample points are random (so that they don't align with allocation patterns)
+	// and average to sample rate, so every sample point stands for sample rate bytes
+	ssize_t bytes_until_sample = s_bytes_until_sample - size;
+	size_t sample_points = 0;
+	while ( bytes_until_sample <= 0 ) {
+		// xorshift
+		s_random_state ^= s_random_state << 13;
+		s_random_state ^= s_random_state >> 7;
+		s_random_state ^= s_random_state << 17;
+		bytes_until_sample += 1 + s_random_state % ( s_sample_rate * 2 );
+		sample_points++;
+	}
+	s_bytes_until_sample = bytes_until_sample;
+
+	// mark before pointer is returned, so that any thread that frees it will see it
+	auto& filter = s_filter[ GetFilterIndex( ptr ) ];
+	uint8_t filter_value = filter.load( std::memory_order_relaxed );
+	while ( filter_value < 255 && !filter.compare_exchange_weak( filter_value, filter_value + 1, std::memory_order_relaxed ) ) {}
+
+	if ( !Push(
+		{
+			s_next_sequence++,
+			ptr,
+			callsite,
+			size,
+			sample_points * s_sample_rate
+		}
+	) ) {
+		// saturated filter entries are never decremented
+		if ( filter_value < 255 ) {
+			filter--;
+		}
+	}
+}
+
+void AllocationProfiler::OnSampledFree( const void* ptr ) {
+	// may be false positive, it's sorted out when building snapshot
+	Push(
+		{
+			s_next_sequence++,
+			ptr,
+			nullptr,
+			0,
+			0
+		}
+	);
+}
+
+AllocationProfiler::ring_t* AllocationProfiler::GetCurrentRing() {
+	if ( !s_current_ring ) {
+		auto* ring = new ring_t;
+		std::lock_guard< std::mutex > guard( s_rings_mutex );
+		s_rings.push_back( std::unique_ptr< ring_t >( ring ) );
+		s_current_ring = ring;
+	}
+	return s_current_ring;
+}
+
+const bool AllocationProfiler::Push( const event_t& event ) {
+	auto* ring = GetCurrentRing();
+	const size_t head = ring->head.load( std::memory_order_relaxed );
+	if ( head - ring->tail.load( std::memory_order_acquire ) >= RING_SIZE ) {
+		s_dropped_events_count++;
+		return false;
+	}
+	ring->events[ head % RING_SIZE ] = event;
+	ring->head.store( head + 1, std::memory_order_release );
+	return true;
+}
+
+const AllocationProfiler::snapshot_t AllocationProfiler::GetSnapshot() {
+	std::lock_guard< std::mutex > guard( s_state_mutex );
+
+	std::vector< event_t > events = {};
+	events.swap( s_pending_frees );
+	{
+		std::lock_guard< std::mutex > rings_guard( s_rings_mutex );
+		for ( const auto& ring : s_rings ) {
+			const size_t head = ring->head.load( std::memory_order_acquire );
+			size_t tail = ring->tail.load( std::memory_order_relaxed );
+			while ( tail != head ) {
+				events.push_back( ring->events[ tail % RING_SIZE ] );
+				tail++;
+			}
+			ring->tail.store( tail, std::memory_order_release );
+		}
+	}
+
+	// frees must be processed after allocations of same pointers
+	std::sort(
+		events.begin(), events.end(), []( const event_t& a, const event_t& b ) -> bool {
+			return a.sequence < b.sequence;
+		}
+	);
+
+	const auto f_get_count = []( const size_t size, const size_t weight ) -> size_t {
+		return size
+			? std::max< size_t >( weight / size, 1 )
+			: 1;
+	};
+
+	const auto f_remove_live = [ &f_get_count ]( const std::unordered_map< const void*, live_t >::iterator& it ) -> void {
+		auto& stats = s_callsites[ it->second.callsite ];
+		stats.live_bytes -= it->second.weight;
+		stats.live_count -= f_get_count( it->second.size, it->second.weight );
+		auto& filter = s_filter[ GetFilterIndex( it->first ) ];
+		if ( filter.load( std::memory_order_relaxed ) < 255 ) {
+			filter--;
+		}
+		s_live.erase( it );
+	};
+
+	for ( auto& event : events ) {
+		auto it = s_live.find( event.ptr );
+		if ( event.callsite ) {
+			if ( it != s_live.end() ) {
+				// free event was dropped
+				f_remove_live( it );
+			}
+			s_live.insert(
+				{
+					event.ptr,
+					{
+						event.callsite,
+						event.size,
+						event.weight
+					}
+				}
+			);
+			const size_t count = f_get_count( event.size, event.weight );
+			auto& stats = s_callsites[ event.callsite ];
+			stats.live_bytes += event.weight;
+			stats.live_count += count;
+			stats.allocated_bytes += event.weight;
+			stats.allocated_count += count;
+		}
+		else {
+			if ( it != s_live.end() ) {
+				f_remove_live( it );
+			}
+			else if ( !event.size ) {
+				// allocation may have been pushed by other thread after its ring was read, it will be there next time
+				// if it's still missing after that then it was a filter false positive
+				event.size++;
+				s_pending_frees.push_back( event );
+			}
+		}
+	}
+
+	snapshot_t snapshot = {};
+	for ( const auto& it : s_callsites ) {
+		// callsites of templates are duplicated per instantiation
+		auto& stats = snapshot[ (std::string)it.first->file + ":" + std::to_string( it.first->line ) ];
+		stats.live_bytes += it.second.live_bytes;
+		stats.live_count += it.second.live_count;
+		stats.allocated_bytes += it.second.allocated_bytes;
+		stats.allocated_count += it.second.allocated_count;
+	}
+	return snapshot;
+}
+
+void AllocationProfiler::WriteReport( const std::string& path, const snapshot_t& snapshot, const snapshot_t* previous ) {
+	std::vector< std::pair< std::string, callsite_stats_t > > sorted( snapshot.begin(), snapshot.end() );
+	std::sort(
+		sorted.begin(), sorted.end(), []( const std::pair< std::string, callsite_stats_t >& a, const std::pair< std::string, callsite_stats_t >& b ) -> bool {
+			return a.second.live_bytes > b.second.live_bytes;
+		}
+	);
+
+	std::string data = "callsite,live_bytes,live_bytes_delta,live_count,live_count_delta,allocated_bytes,allocated_count\n";
+	for ( const auto& it : sorted ) {
+		ssize_t live_bytes_delta = it.second.live_bytes;
+		ssize_t live_count_delta = it.second.live_count;
+		if ( previous ) {
+			const auto previous_it = previous->find( it.first );
+			if ( previous_it != previous->end() ) {
+				live_bytes_delta -= previous_it->second.live_bytes;
+				live_count_delta -= previous_it->second.live_count;
+			}
+		}
+		data += it.first + ',' +
+			std::to_string( it.second.live_bytes ) + ',' +
+			std::to_string( live_bytes_delta ) + ',' +
+			std::to_string( it.second.live_count ) + ',' +
+			std::to_string( live_count_delta ) + ',' +
+			std::to_string( it.second.allocated_bytes ) + ',' +
+			std::to_string( it.second.allocated_count ) + '\n';
+	}
+
+	auto* f = fopen( path.c_str(), "wb" );
+	if ( f ) {
+		fwrite( data.data(), 1, data.size(), f );
+		fclose( f );
+	}
+}
+
+const size_t AllocationProfiler::GetBlockSize( void* ptr ) {
+#ifdef _WIN32
+	return _msize( ptr );
+#elif defined( __APPLE__ )
+	return malloc_size( ptr );
+#else
+	return malloc_usable_size( ptr );
+#endif
+}
+
+const size_t AllocationProfiler::GetDroppedEventsCount() {
+	return s_dropped_events_count.load( std::memory_order_relaxed );
+}
+
+} /* namespace base */
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <atomic>
+#include <array>
+#include <vector>
+#include <unordered_map>
+#include <map>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <cstdlib>
+#include <cstdint>
+#include <sys/types.h>
+
+// unique per call site, costs nothing at runtime (address of constant-initialized static is the id)
+#define ALLOCATION_CALLSITE ( []() -> const base::AllocationProfiler::callsite_t* { \
+    static const base::AllocationProfiler::callsite_t _callsite = { __FILE__, __LINE__ }; \
+    return &_callsite; \
+}() )
+
+namespace base {
+
+// samples allocations (roughly one per sample rate bytes) and keeps track of which sampled ones are still alive
+// sampled allocations are weighted so that totals estimate real heap usage by call site
+// unsampled allocations only decrement thread-local counter, so it's cheap enough to keep on during long sessions
+// must be started before anything is allocated by NEW/malloc that is meant to be tracked, can't be stopped
+class AllocationProfiler {
+public:
+
+	struct callsite_t {
+		const char* file;
+		size_t line;
+	};
+
+	static void Start( const size_t sample_rate );
+	static const bool IsEnabled() {
+		return s_is_enabled.load( std::memory_order_relaxed );
+	}
+
+	static void OnAlloc( const void* ptr, const size_t size, const callsite_t* callsite ) {
+		if ( ptr && IsEnabled() ) {
+			if ( (ssize_t)size < s_bytes_until_sample ) {
+				s_bytes_until_sample -= size;
+			}
+			else {
+				OnSampledAlloc( ptr, size, callsite );
+			}
+		}
+	}
+	static void OnFree( const void* ptr ) {
+		if ( ptr && IsEnabled() && s_filter[ GetFilterIndex( ptr ) ].load( std::memory_order_relaxed ) ) {
+			OnSampledFree( ptr );
+		}
+	}
+
+	// free must be recorded before realloc, otherwise other thread may get same address from malloc and record it first
+	// so call OnFree( old_ptr ) before realloc and this after it
+	static void OnRealloc( const void* old_ptr, const size_t old_size, const void* ptr, const size_t size, const callsite_t* callsite ) {
+		if ( ptr ) {
+			OnAlloc( ptr, size, callsite );
+		}
+		else {
+			// failed realloc keeps old block, so it's still alive
+			OnAlloc( old_ptr, old_size, callsite );
+		}
+	}
+
+	// size of block as seen by allocator (may be slightly larger than requested), for when it isn't known otherwise
+	static const size_t GetBlockSize( void* ptr );
+
+	// used by release malloc/realloc/free macros (debug ones go through memory watcher first)
+	// names are in parentheses so that they aren't expanded by these macros
+	static void* Malloc( const size_t size, const callsite_t* callsite ) {
+		void* ptr = ( malloc )( size );
+		OnAlloc( ptr, size, callsite );
+		return ptr;
+	}
+	static void* Realloc( void* ptr, const size_t size, const callsite_t* callsite ) {
+		const size_t old_size = ptr && IsEnabled()
+			? GetBlockSize( ptr )
+			: 0;
+		OnFree( ptr );
+		void* new_ptr = ( realloc )( ptr, size );
+		OnRealloc( ptr, old_size, new_ptr, size, callsite );
+		return new_ptr;
+	}
+	static void Free( void* ptr ) {
+		OnFree( ptr );
+		( free )( ptr );
+	}
+
+	struct callsite_stats_t {
+		// estimated from samples
+		ssize_t live_bytes = 0;
+		ssize_t live_count = 0;
+		size_t allocated_bytes = 0;
+		size_t allocated_count = 0;
+	};
+	// by "file:line"
+	typedef std::map< std::string, callsite_stats_t > snapshot_t;
+
+	// processes everything that was sampled since previous call and returns current state
+	static const snapshot_t GetSnapshot();
+
+	// writes snapshot as csv sorted by live bytes, with growth since previous snapshot (if given)
+	static void WriteReport( const std::string& path, const snapshot_t& snapshot, const snapshot_t* previous = nullptr );
+
+	// events that didn't fit into ring buffers (if non-zero then snapshots should be taken more often)
+	static const size_t GetDroppedEventsCount();
+
+private:
+
+	inline static std::atomic< bool > s_is_enabled = false;
+	static size_t s_sample_rate;
+
+	inline static thread_local ssize_t s_bytes_until_sample = 0;
+	inline static thread_local uint64_t s_random_state = 0;
+
+	// counting filter of pointers that may be sampled, so that frees of unsampled pointers stay on fast path
+	static const size_t FILTER_SIZE = 1 << 18;
+	static std::array< std::atomic< uint8_t >, FILTER_SIZE > s_filter;
+	static const size_t GetFilterIndex( const void* ptr ) {
+		const uint64_t p = (uint64_t)ptr;
+		return ( ( p >> 4 ) ^ ( p >> 22 ) ) & ( FILTER_SIZE - 1 );
+	}
+
+	static void OnSampledAlloc( const void* ptr, const size_t size, const callsite_t* callsite );
+	static void OnSampledFree( const void* ptr );
+
+	struct event_t {
+		// ordering between threads, because pointer may be freed by other thread than one that allocated it
+		uint64_t sequence;
+		const void* ptr;
+		const callsite_t* callsite; // nullptr for free
+		size_t size; // for free it's how many times it was carried over to next snapshot
+		size_t weight;
+	};
+
+	static const size_t RING_SIZE = 1 << 12;
+
+	// only owner thread writes, events are dropped if ring is full
+	struct ring_t {
+		std::atomic< size_t > head = 0;
+		std::atomic< size_t > tail = 0;
+		event_t events[ RING_SIZE ];
+	};
+
+	static std::mutex s_rings_mutex;
+	static std::vector< std::unique_ptr< ring_t > > s_rings;
+	inline static thread_local ring_t* s_current_ring = nullptr;
+	static ring_t* GetCurrentRing();
+	static const bool Push( const event_t& event );
+
+	static std::atomic< uint64_t > s_next_sequence;
+	static std::atomic< size_t > s_dropped_events_count;
+
+	// state built from events, protected by s_state_mutex
+	struct live_t {
+		const callsite_t* callsite;
+		size_t size;
+		size_t weight;
+	};
+	static std::mutex s_state_mutex;
+	static std::unordered_map< const void*, live_t > s_live;
+	static std::unordered_map< const callsite_t*, callsite_stats_t > s_callsites;
+	// frees whose allocation wasn't seen yet, kept until next snapshot
+	static std::vector< event_t > s_pending_frees;
+
+};
+
+} /* namespace base */
@@ -1,17 +1,31 @@
 #include <atomic>
+#include <chrono>
 
 #include "Base.h"
 
 #include "engine/Engine.h"
 
-#ifdef DEBUG
-debug_stats_t g_debug_stats = {};
-#endif
-
 namespace base {
 
 std::atomic< size_t > g_next_object_id;
 
+LogRateLimiter::LogRateLimiter( const size_t max_per_second )
+	: m_max_per_second( max_per_second ) {}
+
+const bool LogRateLimiter::Allow( size_t& skipped_count ) {
+	// not exact when called from multiple threads at once, but good enough for logging
+	const int64_t second = std::chrono::duration_cast< std::chrono::seconds >( std::chrono::steady_clock::now().time_since_epoch() ).count();
+	if ( m_second.exchange( second ) != second ) {
+		m_count = 0;
+	}
+	if ( m_count++ < m_max_per_second ) {
+		skipped_count = m_skipped_count.exchange( 0 );
+		return true;
+	}
+	m_skipped_count++;
+	return false;
+}
+
 Base::Base()
 	: m_object_id( g_next_object_id++ ) {
 	//
@@ -38,9 +52,13 @@ const std::string& Base::GetLocalName() const {
 	return m_name;
 }
 
-void Base::Log( const std::string& text ) const {
+void Base::LogAt( const log_level_t level, const std::string& text ) const {
 	if ( g_engine != NULL ) {
-		g_engine->GetLogger()->Log( "<" + GetName() + "> " + text );
+		auto* logger = g_engine->GetLogger();
+		// check before formatting
+		if ( logger->IsLevelEnabled( level ) ) {
+			logger->Log( level, "<" + GetName() + "> " + text );
+		}
 	}
 }
 
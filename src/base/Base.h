@@ -6,6 +6,11 @@
 
 #include <string>
 #include <stdexcept>
+#include <atomic>
+#include <cstdint>
+
+#include "base/Stats.h"
+#include "base/AllocationProfiler.h"
 
 #define THROW( _text ) throw std::runtime_error( _text )
 
@@ -19,6 +24,41 @@
 
 namespace base {
 
+// messages below LOG_LEVEL_MIN are compiled out, logger can filter more at runtime
+enum log_level_t : uint8_t {
+	LL_DEBUG,
+	LL_INFO,
+	LL_WARNING,
+	LL_ERROR,
+};
+
+// limits how often one call site can log, use through LOG_RATE_LIMITED()
+class LogRateLimiter {
+public:
+	LogRateLimiter( const size_t max_per_second );
+	// skipped_count is number of messages skipped since last allowed one
+	const bool Allow( size_t& skipped_count );
+private:
+	const size_t m_max_per_second;
+	std::atomic< int64_t > m_second = 0;
+	std::atomic< size_t > m_count = 0;
+	std::atomic< size_t > m_skipped_count = 0;
+};
+
+// for spammy call sites (i.e. on every packet)
+#define LOG_RATE_LIMITED( _level, _max_per_second, _text ) { \
+    static base::LogRateLimiter _log_rate_limiter( _max_per_second ); \
+    size_t _log_skipped_count; \
+    if ( _log_rate_limiter.Allow( _log_skipped_count ) ) { \
+        if ( _log_skipped_count ) { \
+            Log( _level, (std::string)( _text ) + " (skipped " + std::to_string( _log_skipped_count ) + " similar messages)" ); \
+        } \
+        else { \
+            Log( _level, _text ); \
+        } \
+    } \
+}
+
 class Base {
 public:
 	Base();
@@ -41,10 +81,20 @@ protected:
 	std::string m_class_name = "";
 	std::string m_name = "";
 
-	void Log( const std::string& text ) const;
+	// debug level
+	void Log( const std::string& text ) const {
+		Log( LL_DEBUG, text );
+	}
+	void Log( const log_level_t level, const std::string& text ) const {
+		if ( level >= LOG_LEVEL_MIN ) {
+			LogAt( level, text );
+		}
+	}
 
 private:
 
+	void LogAt( const log_level_t level, const std::string& text ) const;
+
 #ifdef DEBUG
 	bool m_is_testing = false;
 #endif
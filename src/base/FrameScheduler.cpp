@@ -0,0 +1,115 @@
+#include <thread>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+
+#include "FrameScheduler.h"
+
+namespace base {
+
+FrameScheduler::FrameScheduler() {
+	m_frame_start = m_previous_frame_start = clock_t::now();
+}
+
+void FrameScheduler::SetTargetRate( const float rate ) {
+	m_target_rate = rate;
+	UpdateBudget();
+}
+
+void FrameScheduler::SetVSyncRate( const float rate ) {
+	m_vsync_rate = rate;
+	UpdateBudget();
+}
+
+void FrameScheduler::SetStatsEnabled( const bool is_stats_enabled ) {
+	m_is_stats_enabled = is_stats_enabled;
+}
+
+void FrameScheduler::BeginFrame() {
+	m_previous_frame_start = m_frame_start;
+	m_frame_start = clock_t::now();
+	if ( m_is_stats_enabled ) {
+		m_frame_times[ m_frames_count % FRAME_TIMES_SIZE ] = std::chrono::duration_cast< std::chrono::microseconds >( m_frame_start - m_previous_frame_start ).count();
+		m_frames_count++;
+		if ( !( m_frames_count % STATS_UPDATE_FRAMES ) ) {
+			PublishPercentiles();
+		}
+	}
+}
+
+void FrameScheduler::EndFrame() {
+	const auto elapsed = clock_t::now() - m_frame_start;
+	if ( m_budget == std::chrono::nanoseconds::zero() ) {
+		return; // unlimited
+	}
+	if ( m_is_stats_enabled && elapsed > m_budget ) {
+		STAT_INC( frames_over_budget );
+	}
+
+	if ( m_vsync_rate > 0 ) {
+		// buffer swap will wait for vertical blank anyway, so only sleep through refresh intervals that should be skipped
+		// and wake up half interval earlier to not miss the one that is needed
+		const auto wakeup_at = m_frame_start + m_budget - std::chrono::nanoseconds( (int64_t)( 500000000 / m_vsync_rate ) );
+		if ( wakeup_at > clock_t::now() ) {
+			std::this_thread::sleep_until( wakeup_at );
+		}
+		return;
+	}
+
+	float sleep_len = m_budget.count() - m_sleep_diff;
+	const float elapsed_ns = std::chrono::duration_cast< std::chrono::nanoseconds >( elapsed ).count();
+	if ( elapsed_ns > sleep_len ) {
+		// lagging, no point in catching up
+		m_sleep_diff = 0.0f;
+	}
+	else {
+		sleep_len -= elapsed_ns;
+		const size_t sleep_len_rounded = ceil( sleep_len );
+		m_sleep_diff = sleep_len_rounded - sleep_len;
+		std::this_thread::sleep_for( std::chrono::nanoseconds( sleep_len_rounded ) );
+	}
+}
+
+const std::chrono::nanoseconds FrameScheduler::GetBudget() const {
+	return m_budget;
+}
+
+const bool FrameScheduler::IsOverBudget() const {
+	return m_budget != std::chrono::nanoseconds::zero() && clock_t::now() - m_frame_start > m_budget;
+}
+
+void FrameScheduler::UpdateBudget() {
+	float budget_ns = m_target_rate > 0
+		? 1000000000.0f / m_target_rate
+		: 0.0f;
+	if ( m_vsync_rate > 0 ) {
+		// can't present faster than display refreshes, and should present on whole refresh intervals
+		const float interval_ns = 1000000000.0f / m_vsync_rate;
+		budget_ns = std::max( roundf( budget_ns / interval_ns ), 1.0f ) * interval_ns;
+	}
+	m_budget = std::chrono::nanoseconds( (int64_t)budget_ns );
+}
+
+void FrameScheduler::PublishPercentiles() {
+	std::vector< uint32_t > frame_times(
+		m_frame_times.begin(),
+		m_frame_times.begin() + std::min( m_frames_count, FRAME_TIMES_SIZE )
+	);
+	const auto f_get_percentile = [ &frame_times ]( const size_t percentile ) -> ssize_t {
+		const auto it = frame_times.begin() + ( frame_times.size() - 1 ) * percentile / 100;
+		std::nth_element( frame_times.begin(), it, frame_times.end() );
+		return *it;
+	};
+	// stats only have counters and gauges, so gauges are moved to new values
+#define x( _percentile ) { \
+        const ssize_t value = f_get_percentile( _percentile ); \
+        STAT_CHANGE_BY( frame_time_p##_percentile##_us, value - m_published_percentiles.p##_percentile ); \
+        m_published_percentiles.p##_percentile = value; \
+    }
+	x( 50 )
+	x( 95 )
+	x( 99 )
+#undef x
+}
+
+} /* namespace base */
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <chrono>
+#include <array>
+
+#include "Base.h"
+
+namespace base {
+
+// paces iterations of thread to target rate and keeps account of how much of frame budget was used
+// budget is 1 / target rate, or multiple of refresh interval if vsync is on (because buffer swaps wait for it anyway)
+CLASS( FrameScheduler, Base )
+
+	FrameScheduler();
+
+	// 0 means unlimited
+	void SetTargetRate( const float rate );
+	// refresh rate of display if buffer swaps are synced to it, 0 if not
+	void SetVSyncRate( const float rate );
+	// publish frame time percentiles to stats (only one thread should do it)
+	void SetStatsEnabled( const bool is_stats_enabled );
+
+	void BeginFrame();
+	// sleeps until next frame is due
+	void EndFrame();
+
+	const std::chrono::nanoseconds GetBudget() const;
+	// for deciding if non-critical work can be skipped this frame
+	const bool IsOverBudget() const;
+
+private:
+
+	typedef std::chrono::steady_clock clock_t;
+
+	float m_target_rate = 0.0f;
+	float m_vsync_rate = 0.0f;
+	std::chrono::nanoseconds m_budget = std::chrono::nanoseconds::zero();
+	void UpdateBudget();
+
+	clock_t::time_point m_frame_start = {};
+	clock_t::time_point m_previous_frame_start = {};
+	// sleeps are rounded up, so difference is subtracted from next sleep
+	float m_sleep_diff = 0.0f;
+
+	// frame times (from start of one frame to start of next) in microseconds
+	static const size_t FRAME_TIMES_SIZE = 256;
+	static const size_t STATS_UPDATE_FRAMES = 64;
+	bool m_is_stats_enabled = false;
+	std::array< uint32_t, FRAME_TIMES_SIZE > m_frame_times = {};
+	size_t m_frames_count = 0;
+	struct {
+		ssize_t p50 = 0;
+		ssize_t p95 = 0;
+		ssize_t p99 = 0;
+	} m_published_percentiles;
+	void PublishPercentiles();
+
+};
+
+} /* namespace base */
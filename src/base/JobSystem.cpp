@@ -0,0 +1,290 @@
+#include <chrono>
+#include <algorithm>
+
+#include "JobSystem.h"
+
+#include "Profiler.h"
+
+namespace base {
+
+// to know if submitting thread is one of workers (and which one)
+static thread_local const JobSystem* s_current_job_system = nullptr;
+static thread_local size_t s_current_worker_index = 0;
+
+JobSystem::Group::Group()
+	: m_canceled( m_is_canceled ) {}
+
+JobSystem::Group::Group( const mt_flag_t& canceled )
+	: m_canceled( canceled ) {}
+
+void JobSystem::Group::Cancel() {
+	ASSERT_NOLOG( &m_canceled == &m_is_canceled, "group uses external canceled flag, cancel it instead" );
+	m_is_canceled = true;
+}
+
+const bool JobSystem::Group::IsCanceled() const {
+	return m_canceled;
+}
+
+const JobSystem::Graph::task_id_t JobSystem::Graph::AddTask( const job_t& job, const std::vector< task_id_t >& dependencies ) {
+	const task_id_t task_id = m_tasks.size();
+	for ( const auto& dependency : dependencies ) {
+		ASSERT_NOLOG( dependency < task_id, "task depends on task that doesn't exist yet" );
+		m_tasks[ dependency ].dependents.push_back( task_id );
+	}
+	m_tasks.emplace_back();
+	auto& task = m_tasks.back();
+	task.job = job;
+	task.dependencies_count = dependencies.size();
+	return task_id;
+}
+
+void JobSystem::Graph::Run( JobSystem* job_system, MT_CANCELABLE ) {
+	Group group( MT_C );
+	for ( auto& task : m_tasks ) {
+		task.remaining_dependencies_count = task.dependencies_count;
+	}
+	for ( task_id_t task_id = 0 ; task_id < m_tasks.size() ; task_id++ ) {
+		if ( !m_tasks[ task_id ].dependencies_count ) {
+			Schedule( job_system, group, task_id );
+		}
+	}
+	job_system->Wait( group );
+}
+
+void JobSystem::Graph::Run( JobSystem* job_system ) {
+	const mt_flag_t canceled = false;
+	Run( job_system, canceled );
+}
+
+void JobSystem::Graph::Schedule( JobSystem* job_system, Group& group, const task_id_t task_id ) {
+	job_system->Submit(
+		group, [ this, job_system, &group, task_id ]( MT_CANCELABLE ) -> void {
+			auto& task = m_tasks[ task_id ];
+			task.job( MT_C );
+			// if group got canceled meanwhile then dependents will be skipped
+			for ( const auto& dependent : task.dependents ) {
+				if ( --m_tasks[ dependent ].remaining_dependencies_count == 0 ) {
+					Schedule( job_system, group, dependent );
+				}
+			}
+		}
+	);
+}
+
+JobSystem::JobSystem( const size_t workers_count ) {
+	size_t count = workers_count;
+	if ( !count ) {
+		count = std::max< size_t >( std::thread::hardware_concurrency(), 2 ) - 1;
+	}
+	for ( size_t i = 0 ; i < count ; i++ ) {
+		NEWV( worker, worker_t );
+		m_workers.push_back( worker );
+	}
+	// start only after all workers exist because they steal from each other
+	for ( size_t i = 0 ; i < count ; i++ ) {
+		m_workers[ i ]->thread = std::thread( &JobSystem::Work, this, i );
+	}
+	STAT_CHANGE_BY( jobs_workers, count );
+}
+
+JobSystem::~JobSystem() {
+	{
+		std::lock_guard< std::mutex > guard( m_wakeup_mutex );
+		m_is_stopping = true;
+	}
+	m_wakeup_condition.notify_all();
+	for ( auto& worker : m_workers ) {
+		worker->thread.join();
+	}
+	for ( auto& worker : m_workers ) {
+		DELETE( worker );
+	}
+	STAT_CHANGE_BY( jobs_workers, -(ssize_t)m_workers.size() );
+}
+
+const size_t JobSystem::GetWorkersCount() const {
+	return m_workers.size();
+}
+
+void JobSystem::Submit( Group& group, const job_t& job ) {
+	group.m_pending_count++;
+	const size_t worker_index = GetCurrentWorkerIndex();
+	if ( worker_index != NO_WORKER ) {
+		// own deque, no contention unless someone is stealing
+		auto* worker = m_workers[ worker_index ];
+		std::lock_guard< std::mutex > guard( worker->mutex );
+		worker->jobs.push_back(
+			{
+				job,
+				&group
+			}
+		);
+	}
+	else {
+		std::lock_guard< std::mutex > guard( m_external_jobs_mutex );
+		m_external_jobs.push_back(
+			{
+				job,
+				&group
+			}
+		);
+	}
+	m_queued_count++;
+	STAT_INC( jobs_submitted );
+	{
+		// so that worker can't miss notification between checking queue and going to sleep
+		std::lock_guard< std::mutex > guard( m_wakeup_mutex );
+	}
+	m_wakeup_condition.notify_one();
+}
+
+void JobSystem::Wait( Group& group ) {
+	const size_t worker_index = GetCurrentWorkerIndex();
+	while ( group.m_pending_count ) {
+		if ( !TryRunJob( worker_index ) ) {
+			// remaining jobs of group are being executed by others, sleep until they finish or until there is something else to help with
+			std::unique_lock< std::mutex > lock( m_wakeup_mutex );
+			m_wakeup_condition.wait(
+				lock, [ this, &group ]() -> bool {
+					return !group.m_pending_count || m_queued_count;
+				}
+			);
+		}
+	}
+	if ( group.m_exception ) {
+		std::rethrow_exception( group.m_exception );
+	}
+}
+
+void JobSystem::ParallelFor( const size_t begin, const size_t end, const std::function< void( const size_t index ) >& f, MT_CANCELABLE, const size_t grain ) {
+	if ( begin >= end ) {
+		return;
+	}
+	const size_t count = end - begin;
+	size_t chunk_size = grain;
+	if ( !chunk_size ) {
+		// few chunks per worker so that stealing can balance uneven chunks
+		chunk_size = std::max< size_t >( count / ( ( m_workers.size() + 1 ) * 4 ), 1 );
+	}
+	Group group( MT_C );
+	for ( size_t chunk_begin = begin ; chunk_begin < end ; chunk_begin += chunk_size ) {
+		const size_t chunk_end = std::min( chunk_begin + chunk_size, end );
+		Submit(
+			group, [ &f, chunk_begin, chunk_end ]( MT_CANCELABLE ) -> void {
+				for ( size_t i = chunk_begin ; i < chunk_end ; i++ ) {
+					MT_RETIF();
+					f( i );
+				}
+			}
+		);
+	}
+	Wait( group );
+}
+
+void JobSystem::ParallelFor( const size_t begin, const size_t end, const std::function< void( const size_t index ) >& f, const size_t grain ) {
+	const mt_flag_t canceled = false;
+	ParallelFor( begin, end, f, canceled, grain );
+}
+
+void JobSystem::Work( const size_t worker_index ) {
+	s_current_job_system = this;
+	s_current_worker_index = worker_index;
+	Profiler::SetThreadName( "JOB#" + std::to_string( worker_index ) );
+	while ( !m_is_stopping ) {
+		if ( !TryRunJob( worker_index ) ) {
+			std::unique_lock< std::mutex > lock( m_wakeup_mutex );
+			m_wakeup_condition.wait(
+				lock, [ this ]() -> bool {
+					return m_queued_count || m_is_stopping;
+				}
+			);
+		}
+	}
+}
+
+const bool JobSystem::TryRunJob( const size_t worker_index ) {
+	queued_job_t queued_job = {};
+	bool is_found = false;
+
+	if ( worker_index != NO_WORKER ) {
+		// newest own job first, its data is most likely still in cache
+		auto* worker = m_workers[ worker_index ];
+		std::lock_guard< std::mutex > guard( worker->mutex );
+		if ( !worker->jobs.empty() ) {
+			queued_job = std::move( worker->jobs.back() );
+			worker->jobs.pop_back();
+			is_found = true;
+		}
+	}
+
+	if ( !is_found ) {
+		std::lock_guard< std::mutex > guard( m_external_jobs_mutex );
+		if ( !m_external_jobs.empty() ) {
+			queued_job = std::move( m_external_jobs.front() );
+			m_external_jobs.pop_front();
+			is_found = true;
+		}
+	}
+
+	if ( !is_found ) {
+		// steal oldest job of someone else, starting from next worker so that victims are spread evenly
+		const size_t start = worker_index != NO_WORKER
+			? worker_index + 1
+			: 0;
+		for ( size_t i = 0 ; i < m_workers.size() && !is_found ; i++ ) {
+			auto* victim = m_workers[ ( start + i ) % m_workers.size() ];
+			std::lock_guard< std::mutex > guard( victim->mutex );
+			if ( !victim->jobs.empty() ) {
+				queued_job = std::move( victim->jobs.front() );
+				victim->jobs.pop_front();
+				is_found = true;
+				STAT_INC( jobs_stolen );
+			}
+		}
+	}
+
+	if ( !is_found ) {
+		return false;
+	}
+
+	m_queued_count--;
+	RunJob( queued_job );
+	return true;
+}
+
+void JobSystem::RunJob( queued_job_t& queued_job ) {
+	auto* group = queued_job.group;
+	if ( !group->m_canceled ) {
+		const auto start = std::chrono::high_resolution_clock::now();
+		try {
+			PROFILE_ZONE( "Job" );
+			queued_job.job( group->m_canceled );
+		}
+		catch ( ... ) {
+			// will be rethrown by Wait(), on thread that owns group
+			std::lock_guard< std::mutex > guard( group->m_exception_mutex );
+			if ( !group->m_exception ) {
+				group->m_exception = std::current_exception();
+			}
+		}
+		STAT_CHANGE_BY( jobs_busy_us, std::chrono::duration_cast< std::chrono::microseconds >( std::chrono::high_resolution_clock::now() - start ).count() );
+	}
+	STAT_INC( jobs_executed );
+	// group must not be touched after this because waiting thread may destroy it right after
+	if ( --group->m_pending_count == 0 ) {
+		{
+			// so that waiter can't miss notification between checking group and going to sleep
+			std::lock_guard< std::mutex > guard( m_wakeup_mutex );
+		}
+		m_wakeup_condition.notify_all();
+	}
+}
+
+const size_t JobSystem::GetCurrentWorkerIndex() const {
+	return s_current_job_system == this
+		? s_current_worker_index
+		: NO_WORKER;
+}
+
+} /* namespace base */
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
+
+#include "Base.h"
+#include "MTModule.h"
+
+namespace base {
+
+// pool of worker threads (one per core) that any module can submit work to
+// every worker has its own deque, it takes newest jobs from its own end and steals oldest jobs from others when idle
+CLASS( JobSystem, Base )
+
+	// jobs receive canceled flag of their group, long jobs should check it with MT_RETIF()
+	typedef std::function< void( MT_CANCELABLE ) > job_t;
+
+	// jobs that are waited for (and canceled) together
+	class Group {
+	public:
+		Group();
+		// use canceled flag of mt request so that jobs are canceled together with it
+		Group( const mt_flag_t& canceled );
+
+		void Cancel();
+		const bool IsCanceled() const;
+
+	private:
+		friend class JobSystem;
+		std::atomic< size_t > m_pending_count = 0;
+		mt_flag_t m_is_canceled = false;
+		const mt_flag_t& m_canceled;
+		std::mutex m_exception_mutex;
+		std::exception_ptr m_exception = nullptr;
+	};
+
+	// set of jobs with dependencies between them, every job is started after all of its dependencies are finished
+	class Graph {
+	public:
+		typedef size_t task_id_t;
+
+		const task_id_t AddTask( const job_t& job, const std::vector< task_id_t >& dependencies = {} );
+
+		// blocks until all tasks are finished or canceled
+		void Run( JobSystem* job_system, MT_CANCELABLE );
+		void Run( JobSystem* job_system );
+
+	private:
+		struct task_t {
+			job_t job;
+			std::vector< task_id_t > dependents;
+			size_t dependencies_count;
+			std::atomic< size_t > remaining_dependencies_count;
+		};
+		std::deque< task_t > m_tasks = {};
+
+		void Schedule( JobSystem* job_system, Group& group, const task_id_t task_id );
+	};
+
+	// 0 means one worker per core (minus one for threads that submit work)
+	JobSystem( const size_t workers_count = 0 );
+	~JobSystem();
+
+	const size_t GetWorkersCount() const;
+
+	void Submit( Group& group, const job_t& job );
+
+	// executes other jobs while waiting, so it's safe to call from inside jobs
+	// rethrows first exception thrown by any job of group
+	void Wait( Group& group );
+
+	// calls f for every index in [begin, end), split into chunks of grain indices (0 for automatic), blocks until done or canceled
+	void ParallelFor( const size_t begin, const size_t end, const std::function< void( const size_t index ) >& f, MT_CANCELABLE, const size_t grain = 0 );
+	void ParallelFor( const size_t begin, const size_t end, const std::function< void( const size_t index ) >& f, const size_t grain = 0 );
+
+private:
+
+	struct queued_job_t {
+		job_t job;
+		Group* group;
+	};
+
+	struct worker_t {
+		std::thread thread;
+		std::mutex mutex;
+		std::deque< queued_job_t > jobs;
+	};
+	std::vector< worker_t* > m_workers = {};
+
+	// jobs submitted from threads outside of pool
+	std::mutex m_external_jobs_mutex;
+	std::deque< queued_job_t > m_external_jobs = {};
+
+	std::atomic< size_t > m_queued_count = 0;
+	std::atomic< bool > m_is_stopping = false;
+	std::mutex m_wakeup_mutex;
+	std::condition_variable m_wakeup_condition;
+
+	void Work( const size_t worker_index );
+	// returns false if there was nothing to do
+	const bool TryRunJob( const size_t worker_index );
+	void RunJob( queued_job_t& queued_job );
+
+	// index of current pool worker, or npos if current thread isn't from this pool
+	const size_t GetCurrentWorkerIndex() const;
+	static const size_t NO_WORKER = (size_t)-1;
+
+};
+
+} /* namespace base */
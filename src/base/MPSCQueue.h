@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+
+namespace base {
+
+// lock-free queue for multiple producers and single consumer
+// producers only exchange head pointer, consumer never blocks them
+template< typename VALUE_TYPE >
+class MPSCQueue {
+public:
+
+	MPSCQueue() {
+		// consumer always keeps one (already consumed) node so that producers never touch its side
+		m_head = m_tail = new node_t;
+	}
+
+	~MPSCQueue() {
+		VALUE_TYPE value;
+		while ( Pop( value ) ) {}
+		delete m_tail;
+	}
+
+	// any thread
+	void Push( VALUE_TYPE&& value ) {
+		auto* node = new node_t;
+		node->value = std::move( value );
+		auto* prev = m_head.exchange( node, std::memory_order_acq_rel );
+		prev->next.store( node, std::memory_order_release );
+	}
+
+	// consumer thread only, returns false if queue is empty
+	const bool Pop( VALUE_TYPE& value ) {
+		auto* next = m_tail->next.load( std::memory_order_acquire );
+		if ( !next ) {
+			return false;
+		}
+		value = std::move( next->value );
+		delete m_tail;
+		m_tail = next;
+		return true;
+	}
+
+private:
+	struct node_t {
+		std::atomic< node_t* > next = nullptr;
+		VALUE_TYPE value = {};
+	};
+
+	std::atomic< node_t* > m_head;
+	node_t* m_tail;
+
+};
+
+}
@@ -1,12 +1,20 @@
 #pragma once
 
 #include <mutex>
+#include <condition_variable>
 #include <atomic>
 #include <functional>
-#include <map>
+#include <unordered_map>
+#include <memory>
 #include <thread>
+#include <chrono>
+#include <vector>
+#include <array>
+#include <algorithm>
 
 #include "Module.h"
+#include "Thread.h"
+#include "MPSCQueue.h"
 
 namespace base {
 
@@ -34,8 +42,8 @@ typedef std::atomic< bool > mt_flag_t;
         return _val; \
     }
 
-static std::mutex s_next_mt_id_mutex;
-static mt_id_t s_next_mt_id = 0;
+// shared by all modules so that ids are never reused
+inline std::atomic< mt_id_t > g_next_mt_id = 0;
 
 // requests and responses should be structs that contain operation type and unions of variables for every op type
 // if you need to pass something non-trivial - use raw pointers
@@ -43,87 +51,194 @@ static mt_id_t s_next_mt_id = 0;
 //   create/malloc objects when creating request, delete/free in target thread when processing it
 //   for response it's opposite - create/malloc when creating response, delete/free in original thread when reading response
 
+// requests are submitted through lock-free queue, processing thread never waits for callers
+// callers either poll with MT_GetResponse() or pass callback that is called from MT_DispatchCallbacks() on their own thread
+// processing thread is woken up on every new request, and caller thread is woken up when its request is executed
+
 template< typename REQUEST_TYPE, typename RESPONSE_TYPE >
 class MTModule : public Module {
 public:
 
+	// called on thread that created request, response is destroyed after callback returns
+	typedef std::function< void( const RESPONSE_TYPE& response ) > mt_callback_t;
+
+	struct mt_stats_t {
+		size_t queue_depth; // requests submitted but not yet executed
+		size_t requests_processed;
+		size_t requests_canceled;
+		size_t average_latency_us; // from creation to response
+		size_t max_latency_us;
+	};
+
 	virtual void Iterate() {
-		mt_request_map_t requests = MT_GetRequests();
-		if ( !requests.empty() ) {
-			//Log( "MT Processing " + to_string( requests.size() ) + " requests" );
-			mt_response_map_t responses = {};
-			for ( auto& request : requests ) {
-				ASSERT( !m_current_request_id, "m_current_request_id already set to something" );
-				m_mt_states_mutex.lock();
-				m_current_request_id = request.first;
-				m_is_canceled = false;
-				m_mt_states_mutex.unlock();
-				responses[ request.first ] = ProcessRequest( request.second, m_is_canceled );
-				m_current_request_id = 0;
+		std::shared_ptr< mt_state_t > state;
+		while ( m_mt_queue.Pop( state ) ) {
+			uint8_t status = S_QUEUED;
+			if ( !state->status.compare_exchange_strong( status, S_PROCESSING ) ) {
+				// canceled before it was picked up, canceling side already cleaned it up
+				continue;
+			}
+			state->response = ProcessRequest( state->request, state->is_canceled );
+
+			const auto latency_us = (size_t)std::chrono::duration_cast< std::chrono::microseconds >( std::chrono::steady_clock::now() - state->created_at ).count();
+			m_mt_stats.latencies_us[ m_mt_stats.requests_processed % MT_LATENCIES_SIZE ].store( latency_us, std::memory_order_relaxed );
+			m_mt_stats.requests_processed++;
+			STAT_INC( mt_requests_processed );
+			m_mt_stats.total_latency_us += latency_us;
+			if ( latency_us > m_mt_stats.max_latency_us ) {
+				m_mt_stats.max_latency_us = latency_us;
+			}
+			m_mt_stats.queue_depth--;
+
+			{
+				// lock is only needed so that canceling thread can't miss notification
+				std::lock_guard< std::mutex > guard( m_mt_processing_mutex );
+				state->status = S_EXECUTED;
+			}
+			m_mt_processing_condition.notify_all();
+			if ( state->caller_thread ) {
+				// let caller read response without waiting for its next scheduled iteration
+				state->caller_thread->Wakeup();
 			}
-			MT_SetResponses( responses );
 		}
 	}
 
 	// use these to pass data from/to other threads
-	mt_id_t MT_CreateRequest( const REQUEST_TYPE& data ) {
-		mt_state_t state = {};
-		s_next_mt_id_mutex.lock();
-		mt_id_t mt_id = ++s_next_mt_id;
-		s_next_mt_id_mutex.unlock();
-		state.is_executed = false;
-		state.request = data;
-		m_mt_states_mutex.lock();
-		ASSERT( m_mt_states.find( mt_id ) == m_mt_states.end(), "duplicate mt_id" );
-		m_mt_states[ mt_id ] = state;
-		m_mt_states_mutex.unlock();
+	mt_id_t MT_CreateRequest( const REQUEST_TYPE& data, const mt_callback_t& callback = nullptr ) {
+		const mt_id_t mt_id = ++g_next_mt_id;
+		auto state = std::make_shared< mt_state_t >();
+		state->request = data;
+		state->callback = callback;
+		state->caller_thread_id = std::this_thread::get_id();
+		state->caller_thread = Thread::GetCurrent();
+		state->created_at = std::chrono::steady_clock::now();
+		// before state becomes visible, otherwise it could be canceled (and decremented) first
+		m_mt_stats.queue_depth++;
+		{
+			std::lock_guard< std::mutex > guard( m_mt_states_mutex );
+			ASSERT( m_mt_states.find( mt_id ) == m_mt_states.end(), "duplicate mt_id" );
+			m_mt_states[ mt_id ] = state;
+		}
+		STAT_INC( mt_requests_created );
+		m_mt_queue.Push( std::move( state ) );
+		if ( m_thread ) {
+			m_thread->Wakeup();
+		}
 		//Log( "MT Request " + to_string( mt_id ) + " created" );
 		return mt_id;
 	}
 
 	const RESPONSE_TYPE MT_GetResponse( const mt_id_t mt_id ) {
 		RESPONSE_TYPE response = {};
-		m_mt_states_mutex.lock();
+		std::lock_guard< std::mutex > guard( m_mt_states_mutex );
 		auto it = m_mt_states.find( mt_id );
 		ASSERT( it != m_mt_states.end(), "GetResponse() mt_id not found" );
-		if ( it->second.is_executed ) {
-			response = it->second.response;
-			DestroyRequest( it->second.request );
+		auto& state = it->second;
+		ASSERT( !state->callback, "GetResponse() called for request with callback" );
+		if ( state->status == S_EXECUTED ) {
+			response = std::move( state->response );
+			DestroyRequest( state->request );
 			m_mt_states.erase( it );
 			//Log( "MT Request " + to_string( mt_id ) + " result returned" );
 		}
-		m_mt_states_mutex.unlock();
-
 		return response;
 	}
 
+	// calls callbacks of executed requests that were created from current thread, call it from Iterate() of caller
+	void MT_DispatchCallbacks() {
+		const auto thread_id = std::this_thread::get_id();
+		std::vector< std::shared_ptr< mt_state_t > > executed = {};
+		{
+			std::lock_guard< std::mutex > guard( m_mt_states_mutex );
+			for ( auto it = m_mt_states.begin() ; it != m_mt_states.end() ; ) {
+				const auto& state = it->second;
+				if ( state->callback && state->caller_thread_id == thread_id && state->status == S_EXECUTED ) {
+					executed.push_back( state );
+					it = m_mt_states.erase( it );
+				}
+				else {
+					it++;
+				}
+			}
+		}
+		// without lock because callbacks may create new requests
+		for ( auto& state : executed ) {
+			DestroyRequest( state->request );
+			state->callback( state->response );
+			DestroyResponse( state->response );
+		}
+	}
+
 	// TODO: better way?
 	void MT_DestroyResponse( const RESPONSE_TYPE& response ) {
 		DestroyResponse( response );
 	}
 
 	void MT_Cancel( const mt_id_t mt_id ) {
-		m_mt_states_mutex.lock();
-		auto it = m_mt_states.find( mt_id );
-		ASSERT( it != m_mt_states.end(), "MT_Cancel() mt_id not found" );
-		if ( mt_id == m_current_request_id ) {
-			m_is_canceled = true;
+		std::shared_ptr< mt_state_t > state;
+		{
+			std::lock_guard< std::mutex > guard( m_mt_states_mutex );
+			auto it = m_mt_states.find( mt_id );
+			ASSERT( it != m_mt_states.end(), "MT_Cancel() mt_id not found" );
+			state = it->second;
+			m_mt_states.erase( it );
 		}
-		if ( !it->second.is_executed ) {
-			if ( it->second.is_processing ) {
-				Log( "Waiting for MT Request " + std::to_string( mt_id ) + " to finish" );
-				while ( it->second.is_processing ) {
-					m_mt_states_mutex.unlock();
-					std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
-					m_mt_states_mutex.lock();
-				}
-			}
+		state->is_canceled = true;
+		m_mt_stats.requests_canceled++;
+		STAT_INC( mt_requests_canceled );
+
+		uint8_t status = S_QUEUED;
+		if ( state->status.compare_exchange_strong( status, S_CANCELED ) ) {
+			// wasn't picked up yet, processing thread will skip it
+			m_mt_stats.queue_depth--;
+			DestroyRequest( state->request );
 			//Log( "MT Request " + to_string( mt_id ) + " canceled" );
-			DestroyRequest( it->second.request );
-			DestroyResponse( it->second.response );
-			m_mt_states.erase( it );
+			return;
+		}
+
+		if ( status == S_PROCESSING ) {
+			Log( "Waiting for MT Request " + std::to_string( mt_id ) + " to finish" );
+			std::unique_lock< std::mutex > lock( m_mt_processing_mutex );
+			m_mt_processing_condition.wait(
+				lock, [ &state ]() -> bool {
+					return state->status == S_EXECUTED;
+				}
+			);
+		}
+
+		// response is not needed anymore
+		DestroyRequest( state->request );
+		DestroyResponse( state->response );
+		//Log( "MT Request " + to_string( mt_id ) + " canceled" );
+	}
+
+	const mt_stats_t MT_GetStats() const {
+		const size_t processed = m_mt_stats.requests_processed;
+		return {
+			m_mt_stats.queue_depth,
+			processed,
+			m_mt_stats.requests_canceled,
+			processed
+				? (size_t)( m_mt_stats.total_latency_us / processed )
+				: 0,
+			m_mt_stats.max_latency_us
+		};
+	}
+
+	// latencies (in microseconds) of requests processed after MT_GetStats() returned processed_since, for percentiles
+	// only last MT_LATENCIES_SIZE are kept
+	const std::vector< uint32_t > MT_GetLatencies( const size_t processed_since ) const {
+		const size_t processed = m_mt_stats.requests_processed;
+		const size_t begin = std::max(
+			processed_since, processed > MT_LATENCIES_SIZE
+				? processed - MT_LATENCIES_SIZE
+				: 0
+		);
+		std::vector< uint32_t > latencies = {};
+		for ( size_t i = begin ; i < processed ; i++ ) {
+			latencies.push_back( m_mt_stats.latencies_us[ i % MT_LATENCIES_SIZE ].load( std::memory_order_relaxed ) );
 		}
-		m_mt_states_mutex.unlock();
+		return latencies;
 	}
 
 protected:
@@ -135,49 +250,44 @@ protected:
 
 private:
 
+	enum mt_status_t : uint8_t {
+		S_QUEUED,
+		S_PROCESSING,
+		S_EXECUTED,
+		S_CANCELED,
+	};
+
 	struct mt_state_t {
 		REQUEST_TYPE request = {};
-		bool is_processing = false;
-		bool is_executed = false;
 		RESPONSE_TYPE response = {};
+		std::atomic< uint8_t > status = S_QUEUED;
+		mt_flag_t is_canceled = false;
+		mt_callback_t callback = nullptr;
+		std::thread::id caller_thread_id = {};
+		Thread* caller_thread = nullptr;
+		std::chrono::steady_clock::time_point created_at = {};
 	};
-	typedef std::map< mt_id_t, REQUEST_TYPE > mt_request_map_t;
-	typedef std::map< mt_id_t, RESPONSE_TYPE > mt_response_map_t;
-
-	mt_request_map_t MT_GetRequests() {
-		mt_request_map_t result = {};
-		m_mt_states_mutex.lock();
-		for ( auto& it : m_mt_states ) {
-			if ( !it.second.is_executed && !it.second.is_processing ) {
-				it.second.is_processing = true;
-				result[ it.first ] = it.second.request;
-			}
-		}
-		m_mt_states_mutex.unlock();
-		return result;
-	}
 
-	void MT_SetResponses( const mt_response_map_t& responses ) {
-		if ( !responses.empty() ) {
-			m_mt_states_mutex.lock();
-			for ( auto& response : responses ) {
-				auto it = m_mt_states.find( response.first );
-				ASSERT( it != m_mt_states.end(), "invalid response mt_id" );
-				ASSERT( it->second.is_processing, "setting response on non-processed request" );
-				it->second.response = response.second;
-				it->second.is_executed = true;
-				it->second.is_processing = false;
-				//Log( "MT Request " + to_string( response.first ) + " executed" );
-			}
-			m_mt_states_mutex.unlock();
-		}
-	}
+	// submitted requests, in order, only processing thread pops
+	MPSCQueue< std::shared_ptr< mt_state_t > > m_mt_queue;
 
-	typedef std::map< mt_id_t, mt_state_t > mt_states_t;
+	// for lookups by callers, processing thread doesn't need it
 	std::mutex m_mt_states_mutex;
-	mt_states_t m_mt_states = {};
-	mt_flag_t m_is_canceled = false;
-	std::atomic< mt_id_t > m_current_request_id = 0;
+	std::unordered_map< mt_id_t, std::shared_ptr< mt_state_t > > m_mt_states = {};
+
+	// to wake up threads that cancel requests that are being processed
+	std::mutex m_mt_processing_mutex;
+	std::condition_variable m_mt_processing_condition;
+
+	static const size_t MT_LATENCIES_SIZE = 4096;
+	struct {
+		std::atomic< size_t > queue_depth = 0;
+		std::atomic< size_t > requests_processed = 0;
+		std::atomic< size_t > requests_canceled = 0;
+		std::atomic< uint64_t > total_latency_us = 0;
+		std::atomic< size_t > max_latency_us = 0;
+		std::array< std::atomic< uint32_t >, MT_LATENCIES_SIZE > latencies_us = {};
+	} m_mt_stats;
 };
 
 }
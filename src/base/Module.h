@@ -10,11 +10,22 @@ namespace base {
 
 typedef size_t mt_id_t;
 
+class Thread;
+
 class Module : public Base {
 public:
 	virtual void Start() {}
 	virtual void Stop() {}
 	virtual void Iterate() {}
+
+	// set by thread when module is added to it
+	void SetThread( Thread* thread ) {
+		m_thread = thread;
+	}
+
+protected:
+	// thread that iterates this module, wake it up when module gets work from other threads
+	Thread* m_thread = nullptr;
 };
 
 typedef std::vector< base::Module* > modules_t;
@@ -0,0 +1,134 @@
+#include <chrono>
+#include <algorithm>
+#include <cstdio>
+
+#include "Profiler.h"
+
+#include "util/FS.h"
+
+namespace base {
+
+std::mutex Profiler::s_names_mutex;
+std::unordered_set< std::string > Profiler::s_names = {};
+std::mutex Profiler::s_rings_mutex;
+std::vector< std::unique_ptr< Profiler::ring_t > > Profiler::s_rings = {};
+
+static thread_local std::string s_current_thread_name = "";
+
+static const std::chrono::steady_clock::time_point s_epoch = std::chrono::steady_clock::now();
+
+void Profiler::SetEnabled( const bool is_enabled ) {
+	s_is_enabled = is_enabled;
+}
+
+void Profiler::SetThreadName( const std::string& name ) {
+	s_current_thread_name = name;
+	if ( s_current_ring ) {
+		std::lock_guard< std::mutex > guard( s_rings_mutex );
+		s_current_ring->thread_name = name;
+	}
+}
+
+const char* Profiler::InternName( const std::string& name ) {
+	std::lock_guard< std::mutex > guard( s_names_mutex );
+	return s_names.insert( name ).first->c_str();
+}
+
+static const std::string EscapeJSON( const std::string& text ) {
+	std::string result = "";
+	result.reserve( text.size() );
+	for ( const auto& c : text ) {
+		if ( c == '"' || c == '\\' ) {
+			result += '\\';
+		}
+		if ( (unsigned char)c >= 0x20 ) {
+			result += c;
+		}
+	}
+	return result;
+}
+
+static const std::string FormatMicroseconds( const uint64_t ns ) {
+	char buf[ 32 ];
+	snprintf( buf, sizeof( buf ), "%llu.%03llu", (unsigned long long)( ns / 1000 ), (unsigned long long)( ns % 1000 ) );
+	return buf;
+}
+
+const size_t Profiler::ExportChromeTrace( const std::string& path ) {
+	std::string data = "{\"traceEvents\":[";
+	bool is_first = true;
+	const auto f_add = [ &data, &is_first ]( const std::string& event ) -> void {
+		if ( !is_first ) {
+			data += ",\n";
+		}
+		is_first = false;
+		data += event;
+	};
+
+	std::vector< event_t > events = {};
+	size_t events_count = 0;
+	{
+		std::lock_guard< std::mutex > guard( s_rings_mutex );
+		for ( const auto& ring : s_rings ) {
+			const std::string tid = std::to_string( ring->thread_index );
+			f_add( "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + tid + ",\"args\":{\"name\":\"" + EscapeJSON( ring->thread_name ) + "\"}}" );
+
+			// owner thread may keep writing meanwhile, so copy first and then drop whatever could have been overwritten during copying
+			const uint64_t end = ring->written_count.load( std::memory_order_acquire );
+			const uint64_t begin = end > RING_SIZE
+				? end - RING_SIZE
+				: 0;
+			events.clear();
+			for ( uint64_t i = begin ; i < end ; i++ ) {
+				events.push_back( ring->events[ i % RING_SIZE ] );
+			}
+			const uint64_t written_after = ring->written_count.load( std::memory_order_acquire );
+			// + 1 because next slot may be half-written
+			const uint64_t valid_begin = written_after + 1 > RING_SIZE
+				? written_after + 1 - RING_SIZE
+				: 0;
+			for ( uint64_t i = std::max( begin, valid_begin ) ; i < end ; i++ ) {
+				const auto& event = events[ i - begin ];
+				f_add( "{\"name\":\"" + EscapeJSON( event.name ) + "\",\"ph\":\"X\",\"pid\":1,\"tid\":" + tid + ",\"ts\":" + FormatMicroseconds( event.start_ns ) + ",\"dur\":" + FormatMicroseconds( event.duration_ns ) + "}" );
+				events_count++;
+			}
+		}
+	}
+
+	data += "],\"displayTimeUnit\":\"ms\"}\n";
+	util::FS::WriteFile( path, data );
+
+	return events_count;
+}
+
+Profiler::ring_t* Profiler::GetCurrentRing() {
+	if ( !s_current_ring ) {
+		auto* ring = new ring_t;
+		ring->thread_name = s_current_thread_name;
+		std::lock_guard< std::mutex > guard( s_rings_mutex );
+		ring->thread_index = s_rings.size() + 1;
+		if ( ring->thread_name.empty() ) {
+			ring->thread_name = "Thread " + std::to_string( ring->thread_index );
+		}
+		s_rings.push_back( std::unique_ptr< ring_t >( ring ) );
+		s_current_ring = ring;
+	}
+	return s_current_ring;
+}
+
+const uint64_t Profiler::Now() {
+	return std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now() - s_epoch ).count();
+}
+
+void Profiler::Record( const char* name, const uint64_t start_ns, const uint64_t duration_ns ) {
+	auto* ring = GetCurrentRing();
+	const uint64_t index = ring->written_count.load( std::memory_order_relaxed );
+	ring->events[ index % RING_SIZE ] = {
+		name,
+		start_ns,
+		duration_ns
+	};
+	ring->written_count.store( index + 1, std::memory_order_release );
+}
+
+} /* namespace base */
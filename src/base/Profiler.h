@@ -0,0 +1,93 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+
+#include "Base.h"
+
+// measures everything until end of current scope, name must be string literal (or come from Profiler::InternName())
+#define PROFILE_ZONE( _name ) base::Profiler::Zone _profile_zone( _name )
+
+namespace base {
+
+// records durations of named zones into per-thread ring buffers (oldest events get overwritten)
+// recorded data can be exported as chrome trace json (chrome://tracing or ui.perfetto.dev)
+// when disabled every zone costs one relaxed atomic load
+CLASS( Profiler, Base )
+
+	static void SetEnabled( const bool is_enabled );
+	static const bool IsEnabled() {
+		return s_is_enabled.load( std::memory_order_relaxed );
+	}
+
+	// name of current thread in trace
+	static void SetThreadName( const std::string& name );
+
+	// for zone names that aren't literals, returned pointer stays valid until process exits
+	static const char* InternName( const std::string& name );
+
+	class Zone {
+	public:
+		Zone( const char* name )
+			: m_name( name )
+			, m_is_recording( IsEnabled() ) {
+			if ( m_is_recording ) {
+				m_start_ns = Now();
+			}
+		}
+		~Zone() {
+			if ( m_is_recording ) {
+				Record( m_name, m_start_ns, Now() - m_start_ns );
+			}
+		}
+	private:
+		const char* m_name;
+		const bool m_is_recording;
+		uint64_t m_start_ns = 0;
+	};
+
+	// writes events of all threads that are still in ring buffers, can be called while recording
+	// returns number of exported events
+	static const size_t ExportChromeTrace( const std::string& path );
+
+private:
+
+	inline static std::atomic< bool > s_is_enabled = false;
+
+	struct event_t {
+		const char* name;
+		uint64_t start_ns;
+		uint64_t duration_ns;
+	};
+
+	static const size_t RING_SIZE = 1 << 16;
+
+	// only owner thread writes to ring, so writing needs no locks
+	struct ring_t {
+		size_t thread_index;
+		std::string thread_name; // protected by s_rings_mutex
+		std::atomic< uint64_t > written_count = 0;
+		event_t events[ RING_SIZE ];
+	};
+
+	// node-based so that pointers to names never move
+	static std::mutex s_names_mutex;
+	static std::unordered_set< std::string > s_names;
+
+	static std::mutex s_rings_mutex;
+	static std::vector< std::unique_ptr< ring_t > > s_rings;
+	// created on first recorded event so that threads that never record anything don't need memory for it
+	inline static thread_local ring_t* s_current_ring = nullptr;
+
+	static ring_t* GetCurrentRing();
+	static const uint64_t Now();
+	static void Record( const char* name, const uint64_t start_ns, const uint64_t duration_ns );
+
+};
+
+} /* namespace base */
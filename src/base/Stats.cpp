@@ -0,0 +1,85 @@
+#include <cstdio>
+#include <ctime>
+
+#include "Stats.h"
+
+namespace base {
+
+std::mutex Stats::s_shards_mutex;
+std::vector< std::unique_ptr< Stats::shard_t > > Stats::s_shards = {};
+
+static const char* s_stat_names[ Stats::ST_MAX ] = {
+#define D( _stat ) #_stat,
+	STATS
+#undef D
+};
+
+const char* Stats::GetName( const stat_id_t stat ) {
+	return s_stat_names[ stat ];
+}
+
+const ssize_t Stats::Get( const stat_id_t stat ) {
+	ssize_t result = 0;
+	std::lock_guard< std::mutex > guard( s_shards_mutex );
+	for ( const auto& shard : s_shards ) {
+		result += shard->values[ stat ].load( std::memory_order_relaxed );
+	}
+	return result;
+}
+
+const Stats::values_t Stats::GetAll() {
+	values_t result = {};
+	std::lock_guard< std::mutex > guard( s_shards_mutex );
+	for ( const auto& shard : s_shards ) {
+		for ( size_t i = 0 ; i < ST_MAX ; i++ ) {
+			result[ i ] += shard->values[ i ].load( std::memory_order_relaxed );
+		}
+	}
+	return result;
+}
+
+void Stats::Dump( const std::string& path ) {
+	static std::string s_header_written_for = "";
+
+	const auto values = GetAll();
+
+	std::string line = "";
+	if ( s_header_written_for != path ) {
+		line += "time";
+		for ( size_t i = 0 ; i < ST_MAX ; i++ ) {
+			line += ',';
+			line += s_stat_names[ i ];
+		}
+		line += '\n';
+		s_header_written_for = path;
+	}
+	line += std::to_string( time( nullptr ) );
+	for ( const auto& value : values ) {
+		line += ',' + std::to_string( value );
+	}
+	line += '\n';
+
+	if ( path == "-" ) {
+		printf( "%s", line.c_str() );
+		fflush( stdout );
+	}
+	else {
+		auto* f = fopen( path.c_str(), "ab" );
+		if ( f ) {
+			fwrite( line.data(), 1, line.size(), f );
+			fclose( f );
+		}
+	}
+}
+
+Stats::shard_t* Stats::CreateShard() {
+	auto* shard = new shard_t;
+	for ( auto& value : shard->values ) {
+		value.store( 0, std::memory_order_relaxed );
+	}
+	std::lock_guard< std::mutex > guard( s_shards_mutex );
+	s_shards.push_back( std::unique_ptr< shard_t >( shard ) );
+	return shard;
+}
+
+} /* namespace base */
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <atomic>
+#include <array>
+#include <vector>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <cstdint>
+#include <sys/types.h>
+
+// runtime statistics, available in release builds too
+// counters only go up, gauges (things like active objects) go up and down, both are summed over all threads when read
+#define STATS \
+    D( seconds_passed ) \
+    D( buffers_created ) \
+    D( buffers_destroyed ) \
+    D( buffers_active ) \
+    D( objects_created ) \
+    D( objects_destroyed ) \
+    D( objects_active ) \
+    D( heap_allocated_size ) \
+    D( arena_blocks_active ) \
+    D( arena_reserved_size ) \
+    D( textures_loaded ) \
+    D( fonts_loaded ) \
+    D( fonts_loaded_from_cache ) \
+    D( frames_rendered ) \
+    D( frames_over_budget ) \
+    D( frame_time_p50_us ) \
+    D( frame_time_p95_us ) \
+    D( frame_time_p99_us ) \
+    D( opengl_buffers_count ) \
+    D( opengl_vertex_buffers_size ) \
+    D( opengl_vertex_buffers_updates ) \
+    D( opengl_vertex_buffers_uploaded ) \
+    D( opengl_index_buffers_size ) \
+    D( opengl_index_buffers_updates ) \
+    D( opengl_index_buffers_uploaded ) \
+    D( opengl_instance_buffers_updates ) \
+    D( opengl_instance_buffers_uploaded ) \
+    D( opengl_textures_count ) \
+    D( opengl_textures_size ) \
+    D( opengl_textures_updates ) \
+    D( opengl_textures_uploaded ) \
+    D( opengl_textures_areas_updated ) \
+    D( opengl_textures_mipmaps_generated ) \
+    D( opengl_framebuffers_count ) \
+    D( opengl_draw_calls ) \
+    D( opengl_instances_drawn ) \
+    D( opengl_instances_culled ) \
+    D( jobs_workers ) \
+    D( jobs_submitted ) \
+    D( jobs_executed ) \
+    D( jobs_stolen ) \
+    D( jobs_busy_us ) \
+    D( thread_wakeups ) \
+    D( mt_requests_created ) \
+    D( mt_requests_processed ) \
+    D( mt_requests_canceled ) \
+    D( network_packets_sent ) \
+    D( network_packets_received ) \
+    D( network_bytes_sent ) \
+    D( network_bytes_received ) \
+    D( ui_elements_created ) \
+    D( ui_elements_destroyed )\
+    D( ui_elements_active ) \
+    D( ui_iterative_deferred )
+
+#define STAT_CHANGE_BY( _stat, _by ) base::Stats::ChangeBy( base::Stats::ST_##_stat, _by )
+#define STAT_INC( _stat ) STAT_CHANGE_BY( _stat, 1 )
+#define STAT_DEC( _stat ) STAT_CHANGE_BY( _stat, -1 )
+
+namespace base {
+
+// every thread writes to its own shard so that changing stats never locks and never bounces cache lines between cores
+class Stats {
+public:
+
+	enum stat_id_t : uint8_t {
+#define D( _stat ) ST_##_stat,
+		STATS
+#undef D
+		ST_MAX
+	};
+
+	typedef std::array< ssize_t, ST_MAX > values_t;
+
+	static void ChangeBy( const stat_id_t stat, const ssize_t by ) {
+		if ( !s_is_suppressed ) {
+			auto& value = GetCurrentShard()->values[ stat ];
+			// only owner thread writes to shard, readers only need to see whole values
+			value.store( value.load( std::memory_order_relaxed ) + by, std::memory_order_relaxed );
+		}
+	}
+
+	static const char* GetName( const stat_id_t stat );
+
+	// sum of all threads
+	static const ssize_t Get( const stat_id_t stat );
+	static const values_t GetAll();
+
+	// ignore stat changes of current thread (i.e. so that debug overlay doesn't pollute stats by it's own activity)
+	// also silences debug logging of current thread
+	static void SetSuppressed( const bool is_suppressed ) {
+		s_is_suppressed = is_suppressed;
+	}
+	static const bool IsSuppressed() {
+		return s_is_suppressed;
+	}
+
+	// appends all stats as csv line to file (or prints to stdout if path is "-"), writes header on first call
+	static void Dump( const std::string& path );
+
+private:
+
+	struct alignas( 64 ) shard_t {
+		std::array< std::atomic< ssize_t >, ST_MAX > values = {};
+	};
+
+	// shards of finished threads are kept because their values are still part of totals
+	static std::mutex s_shards_mutex;
+	static std::vector< std::unique_ptr< shard_t > > s_shards;
+	inline static thread_local shard_t* s_current_shard = nullptr;
+	inline static thread_local bool s_is_suppressed = false;
+
+	static shard_t* GetCurrentShard() {
+		if ( !s_current_shard ) {
+			s_current_shard = CreateShard();
+		}
+		return s_current_shard;
+	}
+	static shard_t* CreateShard();
+
+};
+
+} /* namespace base */
@@ -5,21 +5,26 @@
 
 #include "Thread.h"
 
+#include "Profiler.h"
+
 using namespace std;
 
 namespace base {
 
+static thread_local Thread* s_current_thread = nullptr;
+
 Thread::Thread( const string& thread_name )
 	: Base()
 	, m_thread_name( thread_name ) {
 	m_state = STATE_INACTIVE;
 	m_command = COMMAND_NONE;
 	m_name = thread_name;
+	m_frame_scheduler.SetTargetRate( 10 );
 }
 
 Thread::~Thread() {
 	if ( m_state != STATE_INACTIVE ) {
-		Log( "WARNING: thread " + GetThreadName() + " was not shutdown properly!" );
+		Log( LL_WARNING, "thread " + GetThreadName() + " was not shutdown properly!" );
 	}
 	else {
 		//delete m_thread;
@@ -40,6 +45,7 @@ void Thread::T_Stop() {
 	ASSERT( m_command == COMMAND_NONE, "thread command overlap" );
 	Log( "Sent STOP command" );
 	m_command = Thread::COMMAND_STOP;
+	Wakeup();
 }
 
 void Thread::Run() {
@@ -48,6 +54,9 @@ void Thread::Run() {
 
 	Log( "Starting thread" );
 
+	s_current_thread = this;
+	Profiler::SetThreadName( m_thread_name );
+
 #ifdef DEBUG
 	m_icounter = 0;
 #endif
@@ -56,9 +65,11 @@ void Thread::Run() {
 		( *it )->Start();
 	}
 
-	float step_diff = 0.0f;
-	float step_len;
-	size_t step_len_rounded;
+	// events are exported after threads are stopped, so names need to be owned by profiler
+	std::vector< const char* > module_names = {};
+	for ( const auto& module : m_modules ) {
+		module_names.push_back( Profiler::InternName( module->GetName() + "::Iterate" ) );
+	}
 
 #ifdef DEBUG
 	size_t modulensdiff[m_modules.size()];
@@ -73,6 +84,10 @@ void Thread::Run() {
 
 	while ( m_state == STATE_ACTIVE ) {
 
+		// wakeups that happen during iteration will cause next iteration
+		m_is_woken = false;
+
+		m_frame_scheduler.BeginFrame();
 		auto start = std::chrono::high_resolution_clock::now();
 
 #ifdef DEBUG
@@ -81,7 +96,10 @@ void Thread::Run() {
 
 		for ( modules_t::iterator it = m_modules.begin() ; it < m_modules.end() ; ++it ) {
 			//Log( "Iterating [" + (*it)->GetName() + "]" );
-			( *it )->Iterate();
+			{
+				PROFILE_ZONE( module_names[ it - m_modules.begin() ] );
+				( *it )->Iterate();
+			}
 #ifdef DEBUG
 			auto mfinish = std::chrono::high_resolution_clock::now();
 			modulensdiff[ it - m_modules.begin() ] = std::chrono::duration_cast< std::chrono::nanoseconds >( mfinish - mstart ).count();
@@ -89,37 +107,24 @@ void Thread::Run() {
 #endif
 		}
 
-		auto finish = std::chrono::high_resolution_clock::now();
-
-		auto nsdiff = std::chrono::duration_cast< std::chrono::nanoseconds >( finish - start ).count();
-
-		step_len = 1000000000 / m_ips - step_diff;
-		if ( nsdiff > step_len ) {
 #ifdef DEBUG
-/*	TODO: fix and add stats to debug overlay			
-				Log( "Thread lag detected!" );
-				for ( modules_t::iterator it = m_modules.begin() ; it != m_modules.end() ; ++it ) {
-					Log( (*it)->GetName() + " " + std::to_string( modulensdiff[ it - m_modules.begin() ] ) + "ns ( " + std::to_string( (float) modulensdiff[ it - m_modules.begin() ] * 100 / step_len ) + "%)");
-				}
-				*/
+		m_icounter++;
 #endif
-			step_diff = 0.0f;
-			// TODO: change ips?
-		}
-		else {
-			step_len -= nsdiff;
-			step_len_rounded = ceil( step_len );
-			step_diff = step_len_rounded - step_len;
 
-#ifdef DEBUG
-			m_icounter++;
-/*				Log( "frame " + std::to_string( m_icounter ) + ": sleeping " + std::to_string( step_len_rounded) + "ns (nsdiff: " + std::to_string( nsdiff ) + ", stepdiff: " + std::to_string( step_diff ) + ")" );
-				for ( modules_t::iterator it = m_modules.begin() ; it != m_modules.end() ; ++it ) {
-					Log( (*it)->GetName() + " " + std::to_string( modulensdiff[ it - m_modules.begin() ] ) + "ns ( " + std::to_string( (float) modulensdiff[ it - m_modules.begin() ] * 100 / step_len ) + "%)");
-				}*/
-#endif
-
-			std::this_thread::sleep_for( std::chrono::nanoseconds( step_len_rounded ) );
+		m_frame_scheduler.EndFrame();
+
+		if ( m_idle_ips > 0 ) {
+			// nothing to do until someone wakes us up, but iterate at least with idle ips (for timers, sockets etc)
+			const auto idle_len = std::chrono::nanoseconds( (size_t)( 1000000000 / m_idle_ips ) );
+			const auto elapsed = std::chrono::high_resolution_clock::now() - start;
+			if ( elapsed < idle_len ) {
+				std::unique_lock< std::mutex > lock( m_wakeup_mutex );
+				m_wakeup_condition.wait_for(
+					lock, idle_len - elapsed, [ this ]() -> bool {
+						return m_is_woken || m_command != COMMAND_NONE;
+					}
+				);
+			}
 		}
 
 		switch ( m_command ) {
@@ -163,4 +168,20 @@ const string& Thread::GetThreadName() const {
 	return m_thread_name;
 }
 
+void Thread::Wakeup() {
+	if ( m_is_woken.exchange( true ) ) {
+		return; // already pending
+	}
+	STAT_INC( thread_wakeups );
+	{
+		// so that thread can't miss notification between checking flag and going to sleep
+		std::lock_guard< std::mutex > guard( m_wakeup_mutex );
+	}
+	m_wakeup_condition.notify_one();
+}
+
+Thread* Thread::GetCurrent() {
+	return s_current_thread;
+}
+
 } /* namespace base */
@@ -2,9 +2,12 @@
 
 #include <atomic>
 #include <thread>
+#include <mutex>
+#include <condition_variable>
 
 #include "base/Base.h"
 #include "base/Module.h"
+#include "base/FrameScheduler.h"
 
 namespace base {
 
@@ -24,10 +27,17 @@ CLASS( Thread, Base )
 
 	Thread( const std::string& thread_name );
 	~Thread();
+	// maximum iterations per second
 	void SetIPS( const float ips ) {
-		m_ips = ips;
+		m_frame_scheduler.SetTargetRate( ips );
+	}
+	// event-driven mode: after iteration thread sleeps until Wakeup() or until idle step passes
+	// ips still limits how often it can iterate, 0 (default) means iterate at fixed ips
+	void SetIdleIPS( const float idle_ips ) {
+		m_idle_ips = idle_ips;
 	}
 	void AddModule( base::Module* module ) {
+		module->SetThread( this );
 		m_modules.push_back( module );
 	}
 	void T_Start();
@@ -36,6 +46,17 @@ CLASS( Thread, Base )
 
 	const std::string& GetThreadName() const;
 
+	// any thread, makes event-driven thread iterate as soon as ips allows
+	void Wakeup();
+
+	// thread whose main loop is running in current thread, nullptr if it's not one of ours
+	static Thread* GetCurrent();
+
+	// paces iterations, modules can check remaining budget of current iteration
+	FrameScheduler* GetFrameScheduler() {
+		return &m_frame_scheduler;
+	}
+
 protected:
 	const std::string m_thread_name = "";
 
@@ -45,7 +66,12 @@ protected:
 	std::atomic< thread_state_t > m_state = STATE_INACTIVE;
 	std::atomic< thread_command_t > m_command = COMMAND_NONE;
 	base::modules_t m_modules = {};
-	float m_ips = 10;
+	FrameScheduler m_frame_scheduler;
+	float m_idle_ips = 0;
+
+	std::atomic< bool > m_is_woken = false;
+	std::mutex m_wakeup_mutex;
+	std::condition_variable m_wakeup_condition;
 
 #ifdef DEBUG
 
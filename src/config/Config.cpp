@@ -1,5 +1,6 @@
 #include <stdexcept>
 #include <iostream>
+#include <unordered_map>
 
 #include "Config.h"
 
@@ -40,22 +41,130 @@ Config::Config( const int argc, const char* argv[] ) {
 
 	const std::string s_invalid_smac_directory = " is not valid SMAC directory!\n\tRun from SMAC directory or pass it with --smacpath argument";
 
+	parser.AddRule(
+		"alloc-profile", "SNAPSHOT_PREFIX", "Sample heap allocations and periodically write live bytes by call site to SNAPSHOT_PREFIX.<n>.csv", AH( this ) {
+			m_alloc_profile_prefix = value;
+			m_launch_flags |= LF_ALLOC_PROFILE;
+		}
+	);
+	parser.AddRule(
+		"alloc-interval", "ALLOC_INTERVAL", "Interval of allocation snapshots in milliseconds (default: 10000)", AH( this, f_error ) {
+			if ( !HasLaunchFlag( LF_ALLOC_PROFILE ) ) {
+				f_error( "Allocation profiler options can only be used after --alloc-profile argument!" );
+			}
+			try {
+				m_alloc_profile_interval = std::stoul( value );
+			}
+			catch ( std::invalid_argument& e ) {
+				f_error( "Invalid --alloc-interval value specified!" );
+			}
+			if ( !m_alloc_profile_interval ) {
+				f_error( "Invalid --alloc-interval value specified!" );
+			}
+		}
+	);
+	parser.AddRule(
+		"alloc-sample-rate", "ALLOC_SAMPLE_RATE", "Average number of allocated bytes between samples (default: 524288)", AH( this, f_error ) {
+			if ( !HasLaunchFlag( LF_ALLOC_PROFILE ) ) {
+				f_error( "Allocation profiler options can only be used after --alloc-profile argument!" );
+			}
+			try {
+				m_alloc_profile_sample_rate = std::stoul( value );
+			}
+			catch ( std::invalid_argument& e ) {
+				f_error( "Invalid --alloc-sample-rate value specified!" );
+			}
+			if ( !m_alloc_profile_sample_rate ) {
+				f_error( "Invalid --alloc-sample-rate value specified!" );
+			}
+		}
+	);
 	parser.AddRule(
 		"benchmark", "Disable VSync and FPS limit, show FPS counter at top left corner", AH( this ) {
 			m_launch_flags |= LF_BENCHMARK;
 		}
 	);
+	const std::string s_benchmark_scenario_argument_missing = "Benchmark scenario options can only be used after --benchmark-scenario argument!";
+	parser.AddRule(
+		"benchmark-mapsize", "MAP_SIZE", "Generate benchmark scenario map of specific size (WxH, default: 80x40)", AH( this, s_benchmark_scenario_argument_missing, f_parse_size, f_error ) {
+			if ( !HasLaunchFlag( LF_BENCHMARK_SCENARIO ) ) {
+				f_error( s_benchmark_scenario_argument_missing );
+			}
+			m_benchmark_map_size = f_parse_size( value );
+			if ( !m_benchmark_map_size.x || !m_benchmark_map_size.y ) {
+				f_error( "Invalid --benchmark-mapsize value specified!" );
+			}
+		}
+	);
+	parser.AddRule(
+		"benchmark-scenario", "REPORT_FILE", "Generate fixed-seed map headlessly, replay scripted camera, tile selection and map editor input on it, then write frame times, MT request latencies and memory high-water marks to REPORT_FILE (json) and exit", AH( this ) {
+			m_benchmark_report_path = value;
+			m_launch_flags |= LF_BENCHMARK | LF_BENCHMARK_SCENARIO | LF_HEADLESS | LF_NOSOUND | LF_SKIPINTRO;
+		}
+	);
+	parser.AddRule(
+		"benchmark-seed", "SEED", "Generate benchmark scenario map with specific seed (A:B:C:D)", AH( this, f_error, s_benchmark_scenario_argument_missing ) {
+			if ( !HasLaunchFlag( LF_BENCHMARK_SCENARIO ) ) {
+				f_error( s_benchmark_scenario_argument_missing );
+			}
+			try {
+				m_benchmark_seed = util::Random::GetStateFromString( value );
+			}
+			catch ( std::runtime_error& e ) {
+				f_error( "Invalid seed format! Seed must contain four numbers separated by colon, for example: 1651011033:1377505029:3019448108:3247278135" );
+			}
+		}
+	);
+	parser.AddRule(
+		"fps", "TARGET_FPS", "Target frame rate (default: 500, with vsync it's rounded to whole refresh intervals)", AH( this, f_error ) {
+			try {
+				m_target_fps = std::stoul( value );
+			}
+			catch ( std::invalid_argument& e ) {
+				f_error( "Invalid --fps value specified!" );
+			}
+			if ( !m_target_fps ) {
+				f_error( "Invalid --fps value specified!" );
+			}
+		}
+	);
+	parser.AddRule(
+		"headless", "Start without window and sound (for benchmarks and automated runs)", AH( this ) {
+			m_launch_flags |= LF_HEADLESS | LF_NOSOUND;
+		}
+	);
 	parser.AddRule(
 		"help", "Show this message", AH( this, &parser ) {
 			std::cout << parser.GetHelpString() << std::endl;
 			exit( EXIT_SUCCESS );
 		}
 	);
+	parser.AddRule(
+		"loglevel", "LOG_LEVEL", "Minimum level of logged messages: debug, info, warning or error", AH( this, f_error ) {
+			const std::unordered_map< std::string, base::log_level_t > levels = {
+				{ "debug",   base::LL_DEBUG },
+				{ "info",    base::LL_INFO },
+				{ "warning", base::LL_WARNING },
+				{ "error",   base::LL_ERROR },
+			};
+			const auto it = levels.find( value );
+			if ( it == levels.end() ) {
+				f_error( "Invalid --loglevel value specified! Possible choices: debug info warning error" );
+			}
+			m_log_level = it->second;
+		}
+	);
 	parser.AddRule(
 		"nosound", "Start without sound", AH( this ) {
 			m_launch_flags |= LF_NOSOUND;
 		}
 	);
+	parser.AddRule(
+		"profile", "PROFILE_FILE", "Record profiler zones from start and write them to file on exit (Chrome trace format, Ctrl+` toggles profiler at runtime)", AH( this ) {
+			m_profile_path = value;
+			m_launch_flags |= LF_PROFILE;
+		}
+	);
 	parser.AddRule(
 		"skipintro", "Skip intro", AH( this ) {
 			m_launch_flags |= LF_SKIPINTRO;
@@ -69,6 +178,28 @@ Config::Config( const int argc, const char* argv[] ) {
 			m_smac_path = value + "/";
 		}
 	);
+	parser.AddRule(
+		"stats-dump", "STATS_FILE", "Periodically append runtime stats to csv file (use - for stdout)", AH( this ) {
+			m_stats_dump_path = value;
+			m_launch_flags |= LF_STATS_DUMP;
+		}
+	);
+	parser.AddRule(
+		"stats-interval", "STATS_INTERVAL", "Interval of stats dumps in milliseconds (default: 1000)", AH( this, f_error ) {
+			if ( !HasLaunchFlag( LF_STATS_DUMP ) ) {
+				f_error( "Stats-related options can only be used after --stats-dump argument!" );
+			}
+			try {
+				m_stats_dump_interval = std::stoul( value );
+			}
+			catch ( std::invalid_argument& e ) {
+				f_error( "Invalid --stats-interval value specified!" );
+			}
+			if ( !m_stats_dump_interval ) {
+				f_error( "Invalid --stats-interval value specified!" );
+			}
+		}
+	);
 	parser.AddRule(
 		"version", "Show version of GLSMAC", AH() {
 			std::cout
@@ -106,6 +237,11 @@ Config::Config( const int argc, const char* argv[] ) {
 			m_debug_flags |= DF_MEMORYDEBUG;
 		}
 	);
+	parser.AddRule(
+		"mathcheck", "Compare simd matrix math with scalar implementation and exit", AH( this ) {
+			m_debug_flags |= DF_MATHCHECK;
+		}
+	);
 	parser.AddRule(
 		"quickstart", "Skip intro and main menu and generate/load map directly", AH( this ) {
 			m_debug_flags |= DF_QUICKSTART;
@@ -248,6 +384,50 @@ const types::Vec2< size_t >& Config::GetWindowSize() const {
 	return m_window_size;
 }
 
+const base::log_level_t Config::GetLogLevel() const {
+	return m_log_level;
+}
+
+const size_t Config::GetTargetFPS() const {
+	return m_target_fps;
+}
+
+const std::string& Config::GetProfilePath() const {
+	return m_profile_path;
+}
+
+const std::string& Config::GetStatsDumpPath() const {
+	return m_stats_dump_path;
+}
+
+const size_t Config::GetStatsDumpInterval() const {
+	return m_stats_dump_interval;
+}
+
+const std::string& Config::GetAllocProfilePrefix() const {
+	return m_alloc_profile_prefix;
+}
+
+const size_t Config::GetAllocProfileInterval() const {
+	return m_alloc_profile_interval;
+}
+
+const size_t Config::GetAllocProfileSampleRate() const {
+	return m_alloc_profile_sample_rate;
+}
+
+const std::string& Config::GetBenchmarkReportPath() const {
+	return m_benchmark_report_path;
+}
+
+const types::Vec2< size_t >& Config::GetBenchmarkMapSize() const {
+	return m_benchmark_map_size;
+}
+
+const util::Random::state_t& Config::GetBenchmarkSeed() const {
+	return m_benchmark_seed;
+}
+
 #ifdef DEBUG
 
 const bool Config::HasDebugFlag( const debug_flag_t flag ) const {
@@ -14,13 +14,18 @@ namespace config {
 CLASS( Config, base::Module )
 	Config( const int argc, const char* argv[] );
 
-	enum launch_flag_t : uint8_t {
+	enum launch_flag_t : uint16_t {
 		LF_NONE = 0,
 		LF_BENCHMARK = 1 << 0,
 		LF_NOSOUND = 1 << 1,
 		LF_SKIPINTRO = 1 << 2,
 		LF_WINDOWED = 1 << 3,
-		LF_WINDOW_SIZE = 1 << 4
+		LF_WINDOW_SIZE = 1 << 4,
+		LF_HEADLESS = 1 << 5,
+		LF_PROFILE = 1 << 6,
+		LF_STATS_DUMP = 1 << 7,
+		LF_ALLOC_PROFILE = 1 << 8,
+		LF_BENCHMARK_SCENARIO = 1 << 9
 	};
 
 #ifdef DEBUG
@@ -36,7 +41,8 @@ CLASS( Config, base::Module )
 		DF_QUICKSTART_MAP_OCEAN = 1 << 7,
 		DF_QUICKSTART_MAP_EROSIVE = 1 << 8,
 		DF_QUICKSTART_MAP_LIFEFORMS = 1 << 9,
-		DF_QUICKSTART_MAP_CLOUDS = 1 << 10
+		DF_QUICKSTART_MAP_CLOUDS = 1 << 10,
+		DF_MATHCHECK = 1 << 11
 	};
 #endif
 
@@ -44,6 +50,17 @@ CLASS( Config, base::Module )
 
 	const bool HasLaunchFlag( const launch_flag_t flag ) const;
 	const types::Vec2< size_t >& GetWindowSize() const;
+	const base::log_level_t GetLogLevel() const;
+	const size_t GetTargetFPS() const;
+	const std::string& GetProfilePath() const;
+	const std::string& GetStatsDumpPath() const;
+	const size_t GetStatsDumpInterval() const;
+	const std::string& GetAllocProfilePrefix() const;
+	const size_t GetAllocProfileInterval() const;
+	const size_t GetAllocProfileSampleRate() const;
+	const std::string& GetBenchmarkReportPath() const;
+	const types::Vec2< size_t >& GetBenchmarkMapSize() const;
+	const util::Random::state_t& GetBenchmarkSeed() const;
 
 #ifdef DEBUG
 
@@ -62,8 +79,27 @@ CLASS( Config, base::Module )
 private:
 	std::string m_smac_path = "";
 
-	uint8_t m_launch_flags = LF_NONE;
+	uint16_t m_launch_flags = LF_NONE;
 	types::Vec2< size_t > m_window_size = {};
+	base::log_level_t m_log_level = LOG_LEVEL_MIN;
+	size_t m_target_fps = 500;
+	std::string m_profile_path = "profile.json";
+	std::string m_stats_dump_path = "";
+	size_t m_stats_dump_interval = 1000;
+	std::string m_alloc_profile_prefix = "";
+	size_t m_alloc_profile_interval = 10000;
+	size_t m_alloc_profile_sample_rate = 512 * 1024;
+	std::string m_benchmark_report_path = "";
+	types::Vec2< size_t > m_benchmark_map_size = {
+		80,
+		40
+	};
+	util::Random::state_t m_benchmark_seed = {
+		1651011033,
+		1377505029,
+		3019448108,
+		3247278135
+	};
 
 #ifdef DEBUG
 
@@ -62,8 +62,10 @@ void DebugOverlay::Show() {
 #define D( _stat ) \
             NEW( m_##_stats_label_##_stat, Label ); \
             ActivateLabel( m_##_stats_label_##_stat, 3, (stat_line++) * ( m_font_size + 1 ) );
-		DEBUG_STATS;
+		STATS;
 #undef D
+		NEW( m_jobs_utilization_label, Label );
+		ActivateLabel( m_jobs_utilization_label, 3, (stat_line++) * ( m_font_size + 1 ) );
 
 		for ( int i = 0 ; i < m_memory_stats_lines ; i++ ) {
 			NEWV( label, Label );
@@ -124,8 +126,9 @@ void DebugOverlay::Hide() {
 
 #define D( _stat ) \
             g_engine->GetUI()->RemoveObject( m_##_stats_label_##_stat );
-		DEBUG_STATS;
+		STATS;
 #undef D
+		g_engine->GetUI()->RemoveObject( m_jobs_utilization_label );
 
 		g_engine->GetUI()->RemoveObject( m_background_left );
 
@@ -154,24 +157,38 @@ void DebugOverlay::Refresh() {
 
 		DEBUG_STATS_SET_RO();
 
+		const auto stats = base::Stats::GetAll();
 		ssize_t total;
 		ssize_t current;
 
 		// common statistics
 #define D( _stat ) \
-            DEBUG_STAT_GET( _stat, total, current ); \
+            total = stats[ base::Stats::ST_##_stat ]; \
+            current = total - m_last_stats[ base::Stats::ST_##_stat ]; \
             m_##_stats_label_##_stat->SetText( (std::string) #_stat + " : " + std::to_string( total ) + " ( " + ( current > 0 ? "+" : "" ) + std::to_string( current ) + "/sec )" );
-		DEBUG_STATS;
+		STATS;
 #undef D
 
+		// job system utilization since last refresh
+		const ssize_t elapsed_us = std::chrono::duration_cast< std::chrono::microseconds >( std::chrono::steady_clock::now() - m_last_stats_time ).count();
+		const ssize_t workers_us = stats[ base::Stats::ST_jobs_workers ] * elapsed_us;
+		const ssize_t busy_us = stats[ base::Stats::ST_jobs_busy_us ] - m_last_stats[ base::Stats::ST_jobs_busy_us ];
+		m_jobs_utilization_label->SetText(
+			"jobs_utilization : " + std::to_string(
+				workers_us > 0
+					? busy_us * 100 / workers_us
+					: 0
+			) + "%"
+		);
+
 		// memory statistics
-		const auto stats = g_memory_watcher->GetLargestMemoryConsumerClasses( m_memory_stats_lines );
-		for ( auto i = 0 ; i < stats.size() ; i++ ) {
-			std::string size = std::to_string( stats[ i ].size ) + "b";
+		const auto memory_stats = g_memory_watcher->GetLargestMemoryConsumerClasses( m_memory_stats_lines );
+		for ( auto i = 0 ; i < memory_stats.size() ; i++ ) {
+			std::string size = std::to_string( memory_stats[ i ].size ) + "b";
 			size.insert( size.begin(), 14 - size.length() * 1.5, ' ' );
-			std::string count = "(" + std::to_string( stats[ i ].count ) + ")";
+			std::string count = "(" + std::to_string( memory_stats[ i ].count ) + ")";
 			count.insert( count.begin(), 6 - count.length(), ' ' );
-			m_memory_stats_labels[ i ]->SetText( size + "  " + count + "  " + stats[ i ].key );
+			m_memory_stats_labels[ i ]->SetText( size + "  " + count + "  " + memory_stats[ i ].key );
 		}
 
 		DEBUG_STATS_SET_RW();
@@ -180,11 +197,8 @@ void DebugOverlay::Refresh() {
 }
 
 void DebugOverlay::ClearStats() {
-	// common statistics
-#define D( _stat ) \
-        DEBUG_STAT_CLEAR( _stat );
-	DEBUG_STATS;
-#undef D
+	m_last_stats = base::Stats::GetAll();
+	m_last_stats_time = std::chrono::steady_clock::now();
 }
 
 void DebugOverlay::Iterate() {
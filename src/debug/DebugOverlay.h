@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <string>
+#include <chrono>
 
 #include "base/Task.h"
 
@@ -42,9 +43,16 @@ protected:
 	Font* m_stats_font = nullptr;
 
 #define D( _stat ) Label* m_##_stats_label_##_stat = nullptr;
-	DEBUG_STATS;
+	STATS;
 #undef D
 
+	// to calculate per-second changes
+	base::Stats::values_t m_last_stats = {};
+	std::chrono::steady_clock::time_point m_last_stats_time = {};
+
+	// busy time of job system relative to ( workers * wall time )
+	Label* m_jobs_utilization_label = nullptr;
+
 	std::vector< Label* > m_memory_stats_labels = {};
 	void ActivateLabel( Label* label, const size_t left, const size_t top );
 
@@ -34,6 +34,10 @@ void glBufferData_real( GLenum target, GLsizeiptr size, const void* data, GLenum
 	glBufferData( target, size, data, usage );
 }
 
+void glBufferSubData_real( GLenum target, GLintptr offset, GLsizeiptr size, const void* data ) {
+	glBufferSubData( target, offset, size, data );
+}
+
 void glDeleteBuffers_real( GLsizei n, const GLuint* buffers ) {
 	glDeleteBuffers( n, buffers );
 }
@@ -106,6 +110,10 @@ void glDrawArrays_real( GLenum mode, GLint first, GLsizei count ) {
 	glDrawArrays( mode, first, count );
 }
 
+void glVertexAttribDivisor_real( GLuint index, GLuint divisor ) {
+	glVertexAttribDivisor( index, divisor );
+}
+
 #include "base/Base.h"
 
 namespace debug {
@@ -151,13 +159,14 @@ MemoryWatcher::~MemoryWatcher() {
 	}
 }
 
-void MemoryWatcher::New( const void* object, const size_t size, const std::string& file, const size_t line ) {
+void MemoryWatcher::New( const void* object, const size_t size, const AllocationProfiler::callsite_t* callsite ) {
+	AllocationProfiler::OnAlloc( object, size, callsite );
 	if ( !m_memory_debug ) {
 		return;
 	}
 
 	std::lock_guard< std::mutex > guard( m_mutex );
-	const std::string source = file + ":" + std::to_string( line );
+	const std::string source = (std::string)callsite->file + ":" + std::to_string( callsite->line );
 
 	ASSERT( m_allocated_objects.find( object ) == m_allocated_objects.end(), "new double-allocation detected @" + source );
 	m_allocated_objects[ object ] = {
@@ -176,13 +185,14 @@ void MemoryWatcher::New( const void* object, const size_t size, const std::strin
 	//Log( "Allocated " + std::to_string( size ) + "b for " + object->GetNamespace() + " @" + source );
 }
 
-void MemoryWatcher::Delete( const void* object, const std::string& file, const size_t line ) {
+void MemoryWatcher::Delete( const void* object, const AllocationProfiler::callsite_t* callsite ) {
+	AllocationProfiler::OnFree( object );
 	if ( !m_memory_debug ) {
 		return;
 	}
 
 	std::lock_guard< std::mutex > guard( m_mutex );
-	const std::string source = file + ":" + std::to_string( line );
+	const std::string source = (std::string)callsite->file + ":" + std::to_string( callsite->line );
 
 	auto it = m_allocated_objects.find( object );
 	ASSERT( it != m_allocated_objects.end(), "delete on non-allocated object detected @" + source );
@@ -199,17 +209,20 @@ void MemoryWatcher::Delete( const void* object, const std::string& file, const s
 	m_allocated_objects.erase( it );
 }
 
-void* MemoryWatcher::Malloc( const size_t size, const std::string& file, const size_t line ) {
+void* MemoryWatcher::Malloc( const size_t size, const AllocationProfiler::callsite_t* callsite ) {
 	if ( !m_memory_debug ) {
-		return malloc_real( size );
+		void* ptr = malloc_real( size );
+		AllocationProfiler::OnAlloc( ptr, size, callsite );
+		return ptr;
 	}
 
 	std::lock_guard< std::mutex > guard( m_mutex );
-	const std::string source = file + ":" + std::to_string( line );
+	const std::string source = (std::string)callsite->file + ":" + std::to_string( callsite->line );
 
 	ASSERT( size > 0, "allocation of size 0 @" + source );
 
 	void* ptr = malloc_real( size );
+	AllocationProfiler::OnAlloc( ptr, size, callsite );
 	ASSERT( m_allocated_memory.find( ptr ) == m_allocated_memory.end(), "malloc double-allocation detected @" + source );
 
 	m_allocated_memory[ ptr ] = {
@@ -227,14 +240,20 @@ void* MemoryWatcher::Malloc( const size_t size, const std::string& file, const s
 	return ptr;
 }
 
-void* MemoryWatcher::Realloc( void* ptr, const size_t size, const std::string& file, const size_t line ) {
+void* MemoryWatcher::Realloc( void* ptr, const size_t size, const AllocationProfiler::callsite_t* callsite ) {
 
 	if ( !m_memory_debug ) {
-		return realloc_real( ptr, size );
+		const size_t old_size = ptr && AllocationProfiler::IsEnabled()
+			? AllocationProfiler::GetBlockSize( ptr )
+			: 0;
+		AllocationProfiler::OnFree( ptr );
+		void* new_ptr = realloc_real( ptr, size );
+		AllocationProfiler::OnRealloc( ptr, old_size, new_ptr, size, callsite );
+		return new_ptr;
 	}
 
 	std::lock_guard< std::mutex > guard( m_mutex );
-	const std::string source = file + ":" + std::to_string( line );
+	const std::string source = (std::string)callsite->file + ":" + std::to_string( callsite->line );
 
 	ASSERT( ptr, "reallocation of null @" + source );
 
@@ -244,6 +263,7 @@ void* MemoryWatcher::Realloc( void* ptr, const size_t size, const std::string& f
 	ASSERT( it != m_allocated_memory.end(), "realloc on non-allocated object detected @" + source );
 
 	auto& obj = it->second;
+	const size_t old_size = obj.size;
 
 	DEBUG_STAT_CHANGE_BY( heap_allocated_size, -obj.size );
 
@@ -252,7 +272,10 @@ void* MemoryWatcher::Realloc( void* ptr, const size_t size, const std::string& f
 
 	m_allocated_memory.erase( it );
 
-	ptr = realloc_real( ptr, size );
+	AllocationProfiler::OnFree( ptr );
+	void* new_ptr = realloc_real( ptr, size );
+	AllocationProfiler::OnRealloc( ptr, old_size, new_ptr, size, callsite );
+	ptr = new_ptr;
 
 	ASSERT( m_allocated_memory.find( ptr ) == m_allocated_memory.end(), "realloc double-allocation detected @" + source );
 
@@ -279,21 +302,22 @@ unsigned char* MemoryWatcher::Ptr( unsigned char* ptr, const size_t offset, cons
 		auto it = m_allocated_memory.find( ptr );
 		ASSERT( it != m_allocated_memory.end(), "ptr on non-allocated pointer @" + source );
 
-		ASSERT( offset + size <= it->second.size,
+		ASSERT( (size_t)( offset + size ) <= it->second.size,
 			"ptr overflow (" + std::to_string( offset ) + " + " + std::to_string( size ) + " > " + std::to_string( it->second.size ) + ") @" + source + " (allocated @" + it->second.source + ")"
 		);
 	}
 	return ptr + offset;
 }
 
-void MemoryWatcher::Free( void* ptr, const std::string& file, const size_t line ) {
+void MemoryWatcher::Free( void* ptr, const AllocationProfiler::callsite_t* callsite ) {
+	AllocationProfiler::OnFree( ptr );
 	if ( !m_memory_debug ) {
 		free_real( ptr );
 		return;
 	}
 
 	std::lock_guard< std::mutex > guard( m_mutex );
-	const std::string source = file + ":" + std::to_string( line );
+	const std::string source = (std::string)callsite->file + ":" + std::to_string( callsite->line );
 
 	auto it = m_allocated_memory.find( ptr );
 	ASSERT( it != m_allocated_memory.end(), "free on non-allocated object " + std::to_string( (long long)ptr ) + " detected @" + source );
@@ -439,7 +463,18 @@ void MemoryWatcher::GLBufferData( GLenum target, GLsizeiptr size, const void* da
 		//Log( "Loading " + std::to_string( size ) + " bytes into opengl vertex buffer " + std::to_string( m_opengl.current_vertex_buffer ) + " @" + source );
 		it->second.size = (size_t)size;
 		DEBUG_STAT_CHANGE_BY( opengl_vertex_buffers_size, size );
-		DEBUG_STAT_INC( opengl_vertex_buffers_updates );
+		if ( m_opengl.instance_buffers.find( m_opengl.current_vertex_buffer ) != m_opengl.instance_buffers.end() ) {
+			DEBUG_STAT_INC( opengl_instance_buffers_updates );
+			if ( data ) {
+				DEBUG_STAT_CHANGE_BY( opengl_instance_buffers_uploaded, size );
+			}
+		}
+		else {
+			DEBUG_STAT_INC( opengl_vertex_buffers_updates );
+			if ( data ) {
+				DEBUG_STAT_CHANGE_BY( opengl_vertex_buffers_uploaded, size );
+			}
+		}
 	}
 	else {
 		ASSERT( m_opengl.current_index_buffer != 0, "glBufferData called without bound index buffer @" + source );
@@ -454,11 +489,54 @@ void MemoryWatcher::GLBufferData( GLenum target, GLsizeiptr size, const void* da
 		it->second.size = (size_t)size;
 		DEBUG_STAT_CHANGE_BY( opengl_index_buffers_size, size );
 		DEBUG_STAT_INC( opengl_index_buffers_updates );
+		if ( data ) {
+			DEBUG_STAT_CHANGE_BY( opengl_index_buffers_uploaded, size );
+		}
 	}
 
 	glBufferData_real( target, size, data, usage );
 }
 
+void MemoryWatcher::GLBufferSubData( GLenum target, GLintptr offset, GLsizeiptr size, const void* data, const std::string& file, const size_t line ) {
+	std::lock_guard< std::mutex > guard( m_mutex );
+	const std::string source = file + ":" + std::to_string( line );
+
+	ASSERT(
+		target == GL_ARRAY_BUFFER ||
+			target == GL_ELEMENT_ARRAY_BUFFER,
+		"glBufferSubData unknown target " + std::to_string( target )
+	);
+	ASSERT( size > 0, "glBufferSubData zero size @" + source );
+	ASSERT( data, "glBufferSubData without data @" + source );
+
+	if ( target == GL_ARRAY_BUFFER ) {
+		ASSERT( m_opengl.current_vertex_buffer != 0, "glBufferSubData called without bound vertex buffer @" + source );
+
+		auto it = m_opengl.vertex_buffers.find( m_opengl.current_vertex_buffer );
+		ASSERT( it != m_opengl.vertex_buffers.end(), "opengl vertex buffer not bound" );
+		ASSERT( (size_t)( offset + size ) <= it->second.size, "glBufferSubData vertex buffer overflow ( " + std::to_string( offset + size ) + " > " + std::to_string( it->second.size ) + " ) @" + source );
+		if ( m_opengl.instance_buffers.find( m_opengl.current_vertex_buffer ) != m_opengl.instance_buffers.end() ) {
+			DEBUG_STAT_INC( opengl_instance_buffers_updates );
+			DEBUG_STAT_CHANGE_BY( opengl_instance_buffers_uploaded, size );
+		}
+		else {
+			DEBUG_STAT_INC( opengl_vertex_buffers_updates );
+			DEBUG_STAT_CHANGE_BY( opengl_vertex_buffers_uploaded, size );
+		}
+	}
+	else {
+		ASSERT( m_opengl.current_index_buffer != 0, "glBufferSubData called without bound index buffer @" + source );
+
+		auto it = m_opengl.index_buffers.find( m_opengl.current_index_buffer );
+		ASSERT( it != m_opengl.index_buffers.end(), "opengl index buffer not bound" );
+		ASSERT( (size_t)( offset + size ) <= it->second.size, "glBufferSubData index buffer overflow ( " + std::to_string( offset + size ) + " > " + std::to_string( it->second.size ) + " ) @" + source );
+		DEBUG_STAT_INC( opengl_index_buffers_updates );
+		DEBUG_STAT_CHANGE_BY( opengl_index_buffers_uploaded, size );
+	}
+
+	glBufferSubData_real( target, offset, size, data );
+}
+
 void MemoryWatcher::GLDeleteBuffers( GLsizei n, const GLuint* buffers, const std::string& file, const size_t line ) {
 	std::lock_guard< std::mutex > guard( m_mutex );
 	const std::string source = file + ":" + std::to_string( line );
@@ -478,6 +556,7 @@ void MemoryWatcher::GLDeleteBuffers( GLsizei n, const GLuint* buffers, const std
 		//Log( "Destroying opengl vertex buffer " + std::to_string( *buffers ) + " @" + source );
 		DEBUG_STAT_CHANGE_BY( opengl_vertex_buffers_size, -it_vertex->second.size );
 		m_opengl.vertex_buffers.erase( it_vertex );
+		m_opengl.instance_buffers.erase( *buffers );
 	}
 	if ( it_index != m_opengl.index_buffers.end() ) {
 		ASSERT( m_opengl.current_index_buffer != *buffers, "glDeleteBuffers destroying index buffer while it's still bound @" + source );
@@ -658,7 +737,9 @@ void MemoryWatcher::GLTexImage2D( GLenum target, GLint level, GLint internalform
 		source
 	};
 	DEBUG_STAT_CHANGE_BY( opengl_textures_size, size );
-	DEBUG_STAT_INC( opengl_textures_updates );
+	if ( pixels ) {
+		DEBUG_STAT_CHANGE_BY( opengl_textures_uploaded, size );
+	}
 
 	glTexImage2D_real( target, level, internalformat, width, height, border, format, type, pixels );
 }
@@ -668,7 +749,7 @@ void MemoryWatcher::GLTexSubImage2D( GLenum target, GLint level, GLint xoffset,
 	const std::string source = file + ":" + std::to_string( line );
 
 	ASSERT( target == GL_TEXTURE_2D, "glTexSubImage2D unknown target " + std::to_string( target ) + " @" + source );
-	ASSERT( level == 0, "glTexSubImage2D unknown level " + std::to_string( level ) + " @" + source );
+	ASSERT( level >= 0, "glTexSubImage2D invalid level " + std::to_string( level ) + " @" + source );
 	ASSERT( width > 0, "glTexSubImage2D zero width" );
 	ASSERT( height, "glTexSubImage2D zero height" );
 	ASSERT( type == GL_UNSIGNED_BYTE, "glTexSubImage2D unknown type " + std::to_string( type ) + " @" + source );
@@ -688,7 +769,7 @@ void MemoryWatcher::GLTexSubImage2D( GLenum target, GLint level, GLint xoffset,
 			ASSERT( false, "glTexImage2D unknown format " + std::to_string( format ) + " @" + source );
 	}
 
-	DEBUG_STAT_INC( opengl_textures_updates );
+	DEBUG_STAT_CHANGE_BY( opengl_textures_uploaded, bpp * width * height );
 	glTexSubImage2D_real( target, level, xoffset, yoffset, width, height, format, type, pixels );
 }
 
@@ -986,7 +1067,6 @@ void MemoryWatcher::GLDrawElements( GLenum mode, GLsizei count, GLenum type, con
 		"glDrawElements count mismatch ( " + std::to_string( count * bpi ) + " " + std::to_string( it->second.size ) + " ) at index buffer " + std::to_string( m_opengl.current_index_buffer ) + " @" + source
 	);
 
-	DEBUG_STAT_INC( opengl_draw_calls );
 	glDrawElements_real( mode, count, type, indices );
 }
 
@@ -1008,7 +1088,8 @@ void MemoryWatcher::GLDrawElementsInstanced( GLenum mode, GLsizei count, GLenum
 		"glDrawElementsInstanced count mismatch ( " + std::to_string( count * bpi ) + " " + std::to_string( it->second.size ) + " ) at index buffer " + std::to_string( m_opengl.current_index_buffer ) + " @" + source
 	);
 
-	DEBUG_STAT_INC( opengl_draw_calls );
+	ASSERT( primcount > 0, "glDrawElementsInstanced without instances @" + source );
+
 	glDrawElementsInstanced_real( mode, count, type, indices, primcount );
 }
 
@@ -1021,10 +1102,23 @@ void MemoryWatcher::GLDrawArrays( GLenum mode, GLint first, GLsizei count, const
 	ASSERT( !m_opengl.current_index_buffer, "glDrawArrays index buffer is bound but not supposed to be @" + source );
 	ASSERT( m_opengl.current_program, "glDrawArrays program not bound @" + source );
 
-	DEBUG_STAT_INC( opengl_draw_calls );
 	glDrawArrays_real( mode, first, count );
 }
 
+void MemoryWatcher::GLVertexAttribDivisor( GLuint index, GLuint divisor, const std::string& file, const size_t line ) {
+	std::lock_guard< std::mutex > guard( m_mutex );
+	const std::string source = file + ":" + std::to_string( line );
+
+	if ( divisor > 0 ) {
+		// buffer will be sourced per instance, uploads to it are counted separately from vertex data
+		ASSERT( m_opengl.current_vertex_buffer, "glVertexAttribDivisor vertex buffer not bound @" + source );
+		ASSERT( m_opengl.index_buffers.find( m_opengl.current_vertex_buffer ) == m_opengl.index_buffers.end(), "glVertexAttribDivisor index buffer used as instance buffer @" + source );
+		m_opengl.instance_buffers.insert( m_opengl.current_vertex_buffer );
+	}
+
+	glVertexAttribDivisor_real( index, divisor );
+}
+
 struct sort_method {
 	inline bool operator()( const MemoryWatcher::statistics_item_t& struct1, const MemoryWatcher::statistics_item_t& struct2 ) {
 		return ( struct1.size > struct2.size );
@@ -1070,12 +1164,10 @@ const MemoryWatcher::statistics_result_t MemoryWatcher::GetLargestMemoryConsumer
 }
 
 void MemoryWatcher::Log( const std::string& text ) {
-	g_debug_stats._mutex.lock();
-	if ( !g_debug_stats._readonly ) { // don't spam from debug overlay
+	if ( !base::Stats::IsSuppressed() ) { // don't spam from debug overlay
 		std::cout << "<MemoryWatcher> " << text << std::endl;
 		fflush( stdout );
 	}
-	g_debug_stats._mutex.unlock();
 }
 
 }
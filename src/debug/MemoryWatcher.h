@@ -7,6 +7,8 @@
 #include <mutex>
 #include <GL/glew.h>
 
+#include "base/AllocationProfiler.h"
+
 namespace base {
 class Base;
 }
@@ -22,17 +24,19 @@ public:
 	~MemoryWatcher();
 
 	// memory stuff
-	void New( const void* object, const size_t size, const std::string& file, const size_t line );
-	void Delete( const void* object, const std::string& file, const size_t line );
-	void* Malloc( const size_t size, const std::string& file, const size_t line );
-	void* Realloc( void* ptr, const size_t size, const std::string& file, const size_t line );
+	// allocations are also passed to allocation profiler, source strings are only built with memory debug
+	void New( const void* object, const size_t size, const AllocationProfiler::callsite_t* callsite );
+	void Delete( const void* object, const AllocationProfiler::callsite_t* callsite );
+	void* Malloc( const size_t size, const AllocationProfiler::callsite_t* callsite );
+	void* Realloc( void* ptr, const size_t size, const AllocationProfiler::callsite_t* callsite );
 	unsigned char* Ptr( unsigned char* ptr, const size_t offset, const size_t size, const std::string& file, const size_t line );
-	void Free( void* ptr, const std::string& file, const size_t line );
+	void Free( void* ptr, const AllocationProfiler::callsite_t* callsite );
 
 	// opengl stuff
 	void GLGenBuffers( GLsizei n, GLuint* buffers, const std::string& file, const size_t line );
 	void GLBindBuffer( GLenum target, GLuint buffer, const std::string& file, const size_t line );
 	void GLBufferData( GLenum target, GLsizeiptr size, const void* data, GLenum usage, const std::string& file, const size_t line );
+	void GLBufferSubData( GLenum target, GLintptr offset, GLsizeiptr size, const void* data, const std::string& file, const size_t line );
 	void GLDeleteBuffers( GLsizei n, const GLuint* buffers, const std::string& file, const size_t line );
 	void GLGenTextures( GLsizei n, GLuint* textures, const std::string& file, const size_t line );
 	void GLBindTexture( GLenum target, GLuint texture, const std::string& file, const size_t line );
@@ -51,6 +55,7 @@ public:
 	void GLDrawElements( GLenum mode, GLsizei count, GLenum type, const void* indices, const std::string& file, const size_t line );
 	void GLDrawElementsInstanced( GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei primcount, const std::string& file, const size_t line );
 	void GLDrawArrays( GLenum mode, GLint first, GLsizei count, const std::string& file, const size_t line );
+	void GLVertexAttribDivisor( GLuint index, GLuint divisor, const std::string& file, const size_t line );
 
 	struct statistics_item_t {
 		size_t size;
@@ -114,6 +119,7 @@ private:
 		std::unordered_set< GLuint > buffers = {};
 		std::unordered_map< GLuint, alloc_t > vertex_buffers = {};
 		std::unordered_map< GLuint, alloc_t > index_buffers = {};
+		std::unordered_set< GLuint > instance_buffers = {}; // vertex buffers that were used as per-instance attribute sources
 		std::unordered_map< GLuint, alloc_t > textures = {};
 		std::unordered_map< GLuint, framebuffer_t > framebuffers = {};
 		std::unordered_map< GLuint, GLuint > buffers_framebuffers = {};
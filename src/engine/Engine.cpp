@@ -3,8 +3,7 @@
 
 #include "Engine.h"
 
-// TODO: move to config
-const size_t g_max_fps = 500;
+#include "util/Timer.h"
 
 engine::Engine* g_engine = NULL;
 
@@ -43,13 +42,21 @@ Engine::Engine(
 
 	g_engine = this;
 
+	if ( m_config->HasLaunchFlag( config::Config::LF_PROFILE ) ) {
+		base::Profiler::SetEnabled( true );
+	}
+
+	NEW( m_job_system, base::JobSystem );
+
 	NEWV( t_main, Thread, "MAIN" );
 	if ( m_config->HasLaunchFlag( config::Config::LF_BENCHMARK ) ) {
-		t_main->SetIPS( 999999.9f );
+		t_main->SetIPS( 0 ); // unlimited
 	}
 	else {
-		t_main->SetIPS( g_max_fps );
+		t_main->SetIPS( m_config->GetTargetFPS() );
 	}
+	// frame time percentiles are about main thread
+	t_main->GetFrameScheduler()->SetStatsEnabled( true );
 	t_main->AddModule( m_config );
 	t_main->AddModule( m_error_handler );
 	t_main->AddModule( m_font_loader );
@@ -64,12 +71,16 @@ Engine::Engine(
 	m_threads.push_back( t_main );
 
 	NEWV( t_network, Thread, "NETWORK" );
-	t_network->SetIPS( 100 );
+	// requests are picked up right away, sockets are still polled with idle ips
+	t_network->SetIPS( 1000 );
+	t_network->SetIdleIPS( 100 );
 	t_network->AddModule( m_network );
 	m_threads.push_back( t_network );
 
 	NEWV( t_game, Thread, "GAME" );
-	t_game->SetIPS( g_max_fps );
+	// game only works when asked to (or when network responds)
+	t_game->SetIPS( m_config->GetTargetFPS() );
+	t_game->SetIdleIPS( 10 );
 	t_game->AddModule( m_game );
 	m_threads.push_back( t_game );
 };
@@ -78,28 +89,44 @@ Engine::~Engine() {
 	g_engine = NULL;
 	for ( auto& thread : m_threads ) {
 		if ( thread->T_IsRunning() ) {
-			Log( "WARNING: thread " + thread->GetThreadName() + " still running!" );
+			Log( LL_WARNING, "thread " + thread->GetThreadName() + " still running!" );
 		}
 		else {
 			DELETE( thread );
 		}
 	}
+	DELETE( m_job_system );
 }
 
 int Engine::Run() {
 	int result = EXIT_SUCCESS;
 
-	// TODO: dynamic threadpool
-
 	for ( auto& thread : m_threads ) {
 		thread->T_Start();
 	}
 
+	const bool is_dumping_stats = m_config->HasLaunchFlag( config::Config::LF_STATS_DUMP );
+	util::Timer stats_dump_timer;
+	if ( is_dumping_stats ) {
+		stats_dump_timer.SetInterval( m_config->GetStatsDumpInterval() );
+	}
+	const bool is_profiling_allocations = m_config->HasLaunchFlag( config::Config::LF_ALLOC_PROFILE );
+	util::Timer alloc_snapshot_timer;
+	if ( is_profiling_allocations ) {
+		alloc_snapshot_timer.SetInterval( m_config->GetAllocProfileInterval() );
+	}
+
 	try {
 		while ( !m_is_shutting_down ) {
 			for ( auto& thread : m_threads ) {
 				// ?
 			}
+			if ( is_dumping_stats && stats_dump_timer.HasTicked() ) {
+				base::Stats::Dump( m_config->GetStatsDumpPath() );
+			}
+			if ( is_profiling_allocations && alloc_snapshot_timer.HasTicked() ) {
+				WriteAllocationSnapshot();
+			}
 			std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
 		}
 		Log( "Shutting down" );
@@ -139,12 +166,46 @@ int Engine::Run() {
 	}
 	catch ( std::runtime_error& e ) {
 		result = EXIT_FAILURE;
+		// error handler may exit or rethrow
+		m_logger->Flush();
 		m_error_handler->HandleError( e );
 	}
 
+	if ( base::Profiler::IsEnabled() ) {
+		ToggleProfiler();
+	}
+
+	if ( is_profiling_allocations ) {
+		WriteAllocationSnapshot();
+	}
+
 	return result;
 }
 
+void Engine::ToggleProfiler() {
+	if ( !base::Profiler::IsEnabled() ) {
+		Log( "Starting profiler" );
+		base::Profiler::SetEnabled( true );
+	}
+	else {
+		base::Profiler::SetEnabled( false );
+		const auto& path = m_config->GetProfilePath();
+		const size_t events_count = base::Profiler::ExportChromeTrace( path );
+		Log( "Profiler stopped, exported " + std::to_string( events_count ) + " events to " + path );
+	}
+}
+
+void Engine::WriteAllocationSnapshot() {
+	const auto snapshot = base::AllocationProfiler::GetSnapshot();
+	const std::string path = m_config->GetAllocProfilePrefix() + "." + std::to_string( ++m_alloc_snapshots_count ) + ".csv";
+	base::AllocationProfiler::WriteReport( path, snapshot, &m_last_alloc_snapshot );
+	m_last_alloc_snapshot = snapshot;
+	const size_t dropped_events_count = base::AllocationProfiler::GetDroppedEventsCount();
+	if ( dropped_events_count ) {
+		Log( LL_WARNING, "Allocation profiler dropped " + std::to_string( dropped_events_count ) + " events so far, snapshots may be inaccurate (decrease --alloc-interval or increase --alloc-sample-rate)" );
+	}
+}
+
 void Engine::ShutDown() {
 
 	// TODO: shutdown hooks
@@ -6,6 +6,8 @@
 #include "base/Base.h"
 #include "base/Module.h"
 #include "base/Thread.h"
+#include "base/JobSystem.h"
+#include "base/Profiler.h"
 
 #include "config/Config.h"
 #include "error_handler/ErrorHandler.h"
@@ -26,9 +28,6 @@
 
 #include "../ui/UI.h"
 
-// TODO: move to config
-extern const size_t g_max_fps;
-
 namespace engine {
 
 CLASS( Engine, base::Base );
@@ -53,6 +52,9 @@ CLASS( Engine, base::Base );
 	int Run();
 	void ShutDown();
 
+	// trace is exported to profile path when profiler is turned off
+	void ToggleProfiler();
+
 	config::Config* GetConfig() const { return m_config; }
 	logger::Logger* GetLogger() const { return m_logger; }
 	loader::font::FontLoader* GetFontLoader() const { return m_font_loader; }
@@ -65,6 +67,7 @@ CLASS( Engine, base::Base );
 	scheduler::Scheduler* GetScheduler() const { return m_scheduler; }
 	ui::UI* GetUI() const { return m_ui; }
 	game::Game* GetGame() const { return m_game; }
+	base::JobSystem* GetJobSystem() const { return m_job_system; }
 
 protected:
 
@@ -72,6 +75,9 @@ protected:
 
 	std::vector< Thread* > m_threads = {};
 
+	// for splitting heavy work of any module between all cores
+	base::JobSystem* m_job_system = nullptr;
+
 	config::Config* const m_config = nullptr;
 	error_handler::ErrorHandler* m_error_handler = nullptr;
 	logger::Logger* m_logger = nullptr;
@@ -86,6 +92,13 @@ protected:
 	ui::UI* m_ui = nullptr;
 	game::Game* m_game = nullptr;
 
+private:
+
+	// growth is counted since previous snapshot
+	size_t m_alloc_snapshots_count = 0;
+	base::AllocationProfiler::snapshot_t m_last_alloc_snapshot = {};
+	void WriteAllocationSnapshot();
+
 };
 
 } /* namespace engine */
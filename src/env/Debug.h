@@ -2,106 +2,39 @@
 
 #ifdef DEBUG
 
-#include <mutex>
 #include <iostream>
 
 #include "debug/MemoryWatcher.h"
 
 using namespace debug;
 
-#define DEBUG_STATS \
-    D( seconds_passed ) \
-    D( buffers_created ) \
-    D( buffers_destroyed ) \
-    D( buffers_active ) \
-    D( objects_created ) \
-    D( objects_destroyed ) \
-    D( objects_active ) \
-    D( heap_allocated_size ) \
-    D( textures_loaded ) \
-    D( fonts_loaded ) \
-    D( frames_rendered ) \
-    D( opengl_buffers_count ) \
-    D( opengl_vertex_buffers_size ) \
-    D( opengl_vertex_buffers_updates ) \
-    D( opengl_index_buffers_size ) \
-    D( opengl_index_buffers_updates ) \
-    D( opengl_textures_count ) \
-    D( opengl_textures_size ) \
-    D( opengl_textures_updates ) \
-    D( opengl_framebuffers_count ) \
-    D( opengl_draw_calls ) \
-    D( ui_elements_created ) \
-    D( ui_elements_destroyed )\
-    D( ui_elements_active )
-
-#define D( _stat ) struct { \
-        ssize_t total = 0; \
-        ssize_t current = 0; \
-    } _stat;
-
-struct debug_stats_t {
-	std::mutex _mutex; \
-        bool _readonly = false;
-	DEBUG_STATS
-};
-
-#undef D
-
-extern debug_stats_t g_debug_stats;
+#define LOG_LEVEL_MIN base::LL_DEBUG
+
+// expensive stats that are only tracked in debug builds (i.e. by memory watcher)
+#define DEBUG_STAT_CHANGE_BY( _stat, _by ) STAT_CHANGE_BY( _stat, _by )
+#define DEBUG_STAT_INC( _stat ) STAT_INC( _stat )
+#define DEBUG_STAT_DEC( _stat ) STAT_DEC( _stat )
 
 // to prevent debug overlay from polluting stats by it's own activity
-#define DEBUG_STATS_SET_RO() { \
-    g_debug_stats._mutex.lock(); \
-    g_debug_stats._readonly = true; \
-    g_debug_stats._mutex.unlock(); \
-}
-#define DEBUG_STATS_SET_RW() { \
-    g_debug_stats._mutex.lock(); \
-    g_debug_stats._readonly = false; \
-    g_debug_stats._mutex.unlock(); \
-}
-
-#define DEBUG_STAT_GET( _stat, _totalvar, _currentvar ) { \
-    g_debug_stats._mutex.lock(); \
-    _totalvar = g_debug_stats._stat.total; \
-    _currentvar = g_debug_stats._stat.current; \
-    g_debug_stats._mutex.unlock(); \
-}
-
-#define DEBUG_STAT_CLEAR( _stat ) { \
-    g_debug_stats._mutex.lock(); \
-    g_debug_stats._stat.current = 0; \
-    g_debug_stats._mutex.unlock(); \
-}
-
-#define DEBUG_STAT_CHANGE_BY( _stat, _by ) { \
-    g_debug_stats._mutex.lock(); \
-    if ( !g_debug_stats._readonly ) { \
-        g_debug_stats._stat.total += _by; \
-        g_debug_stats._stat.current += _by; \
-    } \
-    g_debug_stats._mutex.unlock(); \
-}
-#define DEBUG_STAT_INC( _stat ) DEBUG_STAT_CHANGE_BY( _stat, 1 )
-#define DEBUG_STAT_DEC( _stat ) DEBUG_STAT_CHANGE_BY( _stat, -1 )
+#define DEBUG_STATS_SET_RO() base::Stats::SetSuppressed( true )
+#define DEBUG_STATS_SET_RW() base::Stats::SetSuppressed( false )
 
 #define NEW( _var, _class, ... ) \
     _var = new _class( __VA_ARGS__ ); \
-    g_memory_watcher->New( _var, sizeof( _class ), __FILE__, __LINE__ );
+    g_memory_watcher->New( _var, sizeof( _class ), ALLOCATION_CALLSITE );
 
 #define NEWV( _var, _class, ... ) \
     _class* _var; \
     NEW( _var, _class, __VA_ARGS__ )
 
 #define DELETE( _var ) \
-    g_memory_watcher->Delete( _var, __FILE__, __LINE__ ); \
+    g_memory_watcher->Delete( _var, ALLOCATION_CALLSITE ); \
     delete _var;
 
-#define malloc( __size ) g_memory_watcher->Malloc( __size, __FILE__, __LINE__ )
-#define realloc( __ptr, __size ) g_memory_watcher->Realloc( __ptr, __size, __FILE__, __LINE__ )
+#define malloc( __size ) g_memory_watcher->Malloc( __size, ALLOCATION_CALLSITE )
+#define realloc( __ptr, __size ) g_memory_watcher->Realloc( __ptr, __size, ALLOCATION_CALLSITE )
 #define ptr( _ptr, _offset, _size ) g_memory_watcher->Ptr( (unsigned char*)_ptr, _offset, _size, __FILE__, __LINE__ )
-#define free( __ptr ) g_memory_watcher->Free( __ptr, __FILE__, __LINE__ )
+#define free( __ptr ) g_memory_watcher->Free( __ptr, ALLOCATION_CALLSITE )
 
 #undef glGenBuffers
 #define glGenBuffers( _size, _ptr ) g_memory_watcher->GLGenBuffers( _size, _ptr, __FILE__, __LINE__ )
@@ -112,6 +45,9 @@ extern debug_stats_t g_debug_stats;
 #undef glBufferData
 #define glBufferData( _target, _size, _data, _mode ) g_memory_watcher->GLBufferData( _target, _size, _data, _mode, __FILE__, __LINE__ )
 
+#undef glBufferSubData
+#define glBufferSubData( _target, _offset, _size, _data ) g_memory_watcher->GLBufferSubData( _target, _offset, _size, _data, __FILE__, __LINE__ )
+
 #undef glDeleteBuffers
 #define glDeleteBuffers( _size, _ptr ) g_memory_watcher->GLDeleteBuffers( _size, _ptr, __FILE__, __LINE__ )
 
@@ -165,6 +101,9 @@ extern debug_stats_t g_debug_stats;
 #undef glDrawArrays
 #define glDrawArrays( _mode, _first, _count ) g_memory_watcher->GLDrawArrays( _mode, _first, _count, __FILE__, __LINE__ )
 
+#undef glVertexAttribDivisor
+#define glVertexAttribDivisor( _index, _divisor ) g_memory_watcher->GLVertexAttribDivisor( _index, _divisor, __FILE__, __LINE__ )
+
 #undef glDeleteTextures
 #define glDeleteTextures( _size, _ptr ) g_memory_watcher->GLDeleteTextures( _size, _ptr, __FILE__, __LINE__ )
 
@@ -2,13 +2,31 @@
 
 #ifndef DEBUG
 
+#define LOG_LEVEL_MIN base::LL_INFO
+
 #define DEBUG_STAT_CHANGE_BY( _stat, _by )
 #define DEBUG_STAT_INC( _stat )
 #define DEBUG_STAT_DEC( _stat )
 
-#define NEW( _var, _class, ... ) _var = new _class( __VA_ARGS__ )
-#define NEWV( _var, _class, ... ) auto* _var = new _class( __VA_ARGS__ )
-#define DELETE( _var ) delete _var
+#define NEW( _var, _class, ... ) \
+    _var = new _class( __VA_ARGS__ ); \
+    STAT_INC( objects_created ); \
+    STAT_INC( objects_active ); \
+    base::AllocationProfiler::OnAlloc( _var, sizeof( _class ), ALLOCATION_CALLSITE );
+#define NEWV( _var, _class, ... ) \
+    auto* _var = new _class( __VA_ARGS__ ); \
+    STAT_INC( objects_created ); \
+    STAT_INC( objects_active ); \
+    base::AllocationProfiler::OnAlloc( _var, sizeof( _class ), ALLOCATION_CALLSITE );
+#define DELETE( _var ) \
+    STAT_INC( objects_destroyed ); \
+    STAT_DEC( objects_active ); \
+    base::AllocationProfiler::OnFree( _var ); \
+    delete _var;
+
+#define malloc( _size ) base::AllocationProfiler::Malloc( _size, ALLOCATION_CALLSITE )
+#define realloc( _ptr, _size ) base::AllocationProfiler::Realloc( _ptr, _size, ALLOCATION_CALLSITE )
+#define free( _ptr ) base::AllocationProfiler::Free( _ptr )
 #define ptr( _ptr, _offset, _size ) ( _ptr + (_offset) )
 
 #define ASSERT( _condition, _text )
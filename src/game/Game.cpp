@@ -45,13 +45,13 @@ mt_id_t Game::MT_SelectTile( const types::Vec2< size_t >& tile_coords, const til
 	return MT_CreateRequest( request );
 }
 
-mt_id_t Game::MT_SaveMap( const std::string& path ) {
+mt_id_t Game::MT_SaveMap( const std::string& path, const mt_callback_t& callback ) {
 	ASSERT( !path.empty(), "savemap path is empty" );
 	MT_Request request = {};
 	request.op = OP_SAVE_MAP;
 	NEW( request.data.save_map.path, std::string );
 	*request.data.save_map.path = path;
-	return MT_CreateRequest( request );
+	return MT_CreateRequest( request, callback );
 }
 
 mt_id_t Game::MT_EditMap( const types::Vec2< size_t >& tile_coords, map_editor::MapEditor::tool_type_t tool, map_editor::MapEditor::brush_type_t brush, map_editor::MapEditor::draw_mode_t draw_mode ) {
@@ -90,8 +90,12 @@ void Game::Start() {
 
 	NEW( m_random, util::Random );
 
-#ifdef DEBUG
 	const auto* config = g_engine->GetConfig();
+	if ( config->HasLaunchFlag( config::Config::LF_BENCHMARK_SCENARIO ) ) {
+		// benchmark results are only comparable on same map
+		m_random->SetState( config->GetBenchmarkSeed() );
+	}
+#ifdef DEBUG
 	if ( config->HasDebugFlag( config::Config::DF_QUICKSTART_SEED ) ) {
 		m_random->SetState( config->GetQuickstartSeed() );
 	}
@@ -519,6 +523,12 @@ const MT_Response Game::ProcessRequest( const MT_Request& request, MT_CANCELABLE
 				typedef std::unordered_map< size_t, std::pair< std::string, Vec3 > > t3; // can't use comma in macro below
 				NEW( response.data.edit_map.sprites.instances_to_add, t3 );
 				*response.data.edit_map.sprites.instances_to_add = m_map->m_sprite_instances_to_add;
+
+				NEW( response.data.edit_map.tiles_to_reload, std::vector< Vec2< size_t > > );
+				response.data.edit_map.tiles_to_reload->reserve( tiles_to_reload.size() );
+				for ( auto& tile : tiles_to_reload ) {
+					response.data.edit_map.tiles_to_reload->push_back( { tile->coord.x, tile->coord.y } );
+				}
 			}
 
 			response.result = R_SUCCESS;
@@ -586,6 +596,9 @@ void Game::DestroyResponse( const MT_Response& response ) {
 				if ( response.data.edit_map.sprites.instances_to_add ) {
 					DELETE( response.data.edit_map.sprites.instances_to_add );
 				}
+				if ( response.data.edit_map.tiles_to_reload ) {
+					DELETE( response.data.edit_map.tiles_to_reload );
+				}
 				break;
 			}
 			default: {
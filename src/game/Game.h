@@ -175,6 +175,7 @@ struct MT_Response {
 				std::unordered_map< size_t, std::string >* instances_to_remove;
 				std::unordered_map< size_t, std::pair< std::string, Vec3 > >* instances_to_add;
 			} sprites;
+			std::vector< Vec2< size_t > >* tiles_to_reload;
 		} edit_map;
 	} data;
 };
@@ -198,8 +199,8 @@ CLASS( Game, MTModule )
 	// returns some data about tile
 	mt_id_t MT_SelectTile( const types::Vec2< size_t >& tile_coords, const tile_direction_t tile_direction = TD_NONE );
 
-	// saves current map into file
-	mt_id_t MT_SaveMap( const std::string& path );
+	// saves current map into file, callback is called from MT_DispatchCallbacks() of caller
+	mt_id_t MT_SaveMap( const std::string& path, const mt_callback_t& callback = nullptr );
 
 	// perform edit operation on map tile(s)
 	mt_id_t MT_EditMap( const types::Vec2< size_t >& tile_coords, map_editor::MapEditor::tool_type_t tool, map_editor::MapEditor::brush_type_t brush, map_editor::MapEditor::draw_mode_t draw_mode );
@@ -98,7 +98,7 @@ void Client::ProcessEvent( const Event& event ) {
 							break;
 						}
 						default: {
-							Log( "WARNING: invalid packet type from server: " + std::to_string( packet.type ) );
+							Log( LL_WARNING, "invalid packet type from server: " + std::to_string( packet.type ) );
 						}
 					}
 				}
@@ -117,7 +117,7 @@ void Client::ProcessEvent( const Event& event ) {
 			break;
 		}
 		default: {
-			Log( "WARNING: invalid event type from server: " + std::to_string( event.type ) );
+			Log( LL_WARNING, "invalid event type from server: " + std::to_string( event.type ) );
 		}
 	}
 }
@@ -30,7 +30,7 @@ Connection::Connection( const network::connection_mode_t connection_mode, LocalS
 
 Connection::~Connection() {
 	if ( m_mt_ids.disconnect ) {
-		Log( "WARNING: connection destroyed while still disconnecting!" );
+		Log( LL_WARNING, "connection destroyed while still disconnecting!" );
 	}
 	if ( m_mt_ids.events ) {
 		m_network->MT_Cancel( m_mt_ids.events );
@@ -127,7 +127,7 @@ void Connection::Iterate() {
 				}
 				else if ( result.result == network::R_SUCCESS ) {
 					if ( !result.events.empty() ) {
-						Log( "got " + std::to_string( result.events.size() ) + " event(s)" );
+						LOG_RATE_LIMITED( LL_DEBUG, 10, "got " + std::to_string( result.events.size() ) + " event(s)" );
 						for ( auto& event : result.events ) {
 							ProcessEvent( event );
 						}
@@ -165,7 +165,7 @@ void Server::ProcessEvent( const network::Event& event ) {
 						break;
 					}
 					default: {
-						Log( "WARNING: invalid packet type from client " + std::to_string( event.cid ) + " : " + std::to_string( packet.type ) );
+						Log( LL_WARNING, "invalid packet type from client " + std::to_string( event.cid ) + " : " + std::to_string( packet.type ) );
 					}
 				}
 			}
@@ -179,7 +179,7 @@ void Server::ProcessEvent( const network::Event& event ) {
 			break;
 		}
 		default: {
-			Log( "WARNING: invalid event type from client " + std::to_string( event.cid ) + " : " + std::to_string( event.type ) );
+			Log( LL_WARNING, "invalid event type from client " + std::to_string( event.cid ) + " : " + std::to_string( event.type ) );
 		}
 	}
 
@@ -38,6 +38,9 @@ static inline unsigned char S_to_binary_( const char* s ) {
 
 Map::Map( const Game* game )
 	: m_game( game ) {
+	NEW( m_arena, util::Arena, 4 * 1024 * 1024 );
+	NEW( m_scratch_arena, util::Arena, 64 * 1024 );
+
 	// add texture variant bitmap maps
 	CalculateTextureVariants(
 		TVT_TILES, {
@@ -173,6 +176,9 @@ Map::~Map() {
 	if ( m_map_state ) {
 		DELETE( m_map_state );
 	}
+	// after everything that was allocated from them
+	DELETE( m_scratch_arena );
+	DELETE( m_arena );
 }
 
 const Buffer Map::Serialize() const {
@@ -216,11 +222,11 @@ const Buffer Map::sprite_actor_t::Serialize() const {
 void Map::Unserialize( Buffer buf ) {
 
 	ASSERT( !m_tiles, "tiles already set" );
-	NEW( m_tiles, Tiles );
+	NEW( m_tiles, Tiles, 0, 0, m_arena );
 	m_tiles->Unserialize( buf.ReadString() );
 
 	ASSERT( !m_map_state, "map state already set" );
-	NEW( m_map_state, MapState );
+	NEW( m_map_state, MapState, m_arena );
 	m_map_state->Unserialize( buf.ReadString() );
 
 	InitTextureAndMesh();
@@ -543,6 +549,10 @@ Tiles* Map::GetTilesPtr() const {
 	return m_tiles;
 }
 
+util::Arena* Map::GetScratchArena() const {
+	return m_scratch_arena;
+}
+
 const std::string Map::GetTerrainSpriteActor( const std::string& name, const Consts::pcx_texture_coordinates_t& tex_coords, const float z_index ) {
 	const auto key = name + " " + tex_coords.ToString();
 
@@ -614,7 +624,7 @@ const Map::error_code_t Map::Generate(
 	}
 #endif
 	Log( "Generating map of size " + size.ToString() );
-	NEW( m_tiles, Tiles, size.x, size.y );
+	NEW( m_tiles, Tiles, size.x, size.y, m_arena );
 	generator.Generate( m_tiles, map_settings, MT_C );
 	if ( canceled ) {
 		Log( "Map generation canceled" );
@@ -642,7 +652,7 @@ const Map::error_code_t Map::Load( const std::string& path ) {
 	}
 
 	Log( "Loading map from " + path );
-	NEW( m_tiles, Tiles );
+	NEW( m_tiles, Tiles, 0, 0, m_arena );
 	try {
 		m_tiles->Unserialize( Buffer( FS::ReadFile( path ) ) );
 		return EC_NONE;
@@ -672,7 +682,7 @@ const Map::error_code_t Map::Initialize( MT_CANCELABLE ) {
 	if ( m_map_state ) {
 		DELETE( m_map_state );
 	}
-	NEW( m_map_state, MapState );
+	NEW( m_map_state, MapState, m_arena );
 
 	m_map_state->dimensions = {
 		m_tiles->GetWidth(),
@@ -764,7 +774,9 @@ void Map::ProcessTiles( module_passes_t& module_passes, const tiles_t& tiles, MT
 	uint8_t percent = 0, last_percent = 0;
 
 	for ( auto& module_pass : module_passes ) {
+		PROFILE_ZONE( "Map::ModulePass" );
 		for ( const auto& tile : tiles ) {
+			util::Arena::Scope scratch_scope( m_scratch_arena );
 			m_current_tile = tile;
 			m_current_ts = GetTileState( tile->coord.x, tile->coord.y );
 
@@ -792,6 +804,7 @@ void Map::ProcessTiles( module_passes_t& module_passes, const tiles_t& tiles, MT
 }
 
 void Map::LoadTiles( const tiles_t& tiles, MT_CANCELABLE ) {
+	PROFILE_ZONE( "Map::LoadTiles" );
 
 	Log( "Loading " + std::to_string( tiles.size() ) + " tiles" );
 
@@ -809,6 +822,7 @@ void Map::LoadTiles( const tiles_t& tiles, MT_CANCELABLE ) {
 }
 
 void Map::FixNormals( const tiles_t& tiles, MT_CANCELABLE ) {
+	PROFILE_ZONE( "Map::FixNormals" );
 	Log( "Fixing normals" );
 
 	g_engine->GetUI()->GetLoader()->SetText( "Fixing normals" );
@@ -881,19 +895,22 @@ void Map::FixNormals( const tiles_t& tiles, MT_CANCELABLE ) {
 		f_combine_normals_maybe( tile->SE );
 	}
 
-	// average center normals
-	for ( const auto& tile : tiles ) {
-		auto* ts = GetTileState( tile->coord.x, tile->coord.y );
-
-		m_meshes.terrain->SetVertexNormal(
-			ts->layers[ TileState::LAYER_LAND ].indices.center, (
-				m_meshes.terrain->GetVertexNormal( ts->layers[ TileState::LAYER_LAND ].indices.left ) +
-					m_meshes.terrain->GetVertexNormal( ts->layers[ TileState::LAYER_LAND ].indices.top ) +
-					m_meshes.terrain->GetVertexNormal( ts->layers[ TileState::LAYER_LAND ].indices.right ) +
-					m_meshes.terrain->GetVertexNormal( ts->layers[ TileState::LAYER_LAND ].indices.bottom )
-			) / 4
-		);
-	}
+	// average center normals, every tile writes only its own center vertex so tiles can be processed in parallel
+	g_engine->GetJobSystem()->ParallelFor(
+		0, tiles.size(), [ this, &tiles ]( const size_t index ) -> void {
+			const auto* tile = tiles[ index ];
+			auto* ts = GetTileState( tile->coord.x, tile->coord.y );
+
+			m_meshes.terrain->SetVertexNormal(
+				ts->layers[ TileState::LAYER_LAND ].indices.center, (
+					m_meshes.terrain->GetVertexNormal( ts->layers[ TileState::LAYER_LAND ].indices.left ) +
+						m_meshes.terrain->GetVertexNormal( ts->layers[ TileState::LAYER_LAND ].indices.top ) +
+						m_meshes.terrain->GetVertexNormal( ts->layers[ TileState::LAYER_LAND ].indices.right ) +
+						m_meshes.terrain->GetVertexNormal( ts->layers[ TileState::LAYER_LAND ].indices.bottom )
+				) / 4
+			);
+		}, MT_C
+	);
 }
 
 void Map::CalculateTextureVariants( const texture_variants_type_t type, const texture_variants_rules_t& rules ) {
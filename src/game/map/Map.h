@@ -101,6 +101,9 @@ CLASS( Map, types::Serializable )
 	// be careful using this
 	Tiles* GetTilesPtr() const;
 
+	// for temporary data of modules, everything allocated from it is released after each tile is processed
+	util::Arena* GetScratchArena() const;
+
 	struct sprite_actor_t {
 		std::string name = "";
 
@@ -146,6 +149,10 @@ private:
 
 	const Game* m_game = nullptr;
 
+	// tiles and tile states live here, everything is released at once when map is destroyed (instead of piece by piece)
+	util::Arena* m_arena = nullptr;
+	util::Arena* m_scratch_arena = nullptr;
+
 	Tiles* m_tiles = nullptr;
 	MapState* m_map_state = nullptr;
 
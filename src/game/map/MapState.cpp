@@ -3,6 +3,11 @@
 namespace game {
 namespace map {
 
+MapState::MapState( util::Arena* arena )
+	: m_arena( arena ) {
+	//
+}
+
 MapState::~MapState() {
 	if ( m_tile_states ) {
 		for ( size_t y = 0 ; y < dimensions.y ; y++ ) {
@@ -24,7 +29,9 @@ MapState::~MapState() {
 				}*/
 			}
 		}
-		free( m_tile_states );
+		if ( !m_arena ) {
+			free( m_tile_states );
+		}
 	}
 }
 
@@ -39,9 +46,15 @@ void MapState::LinkTileStates( MT_CANCELABLE ) {
 
 	ASSERT( !m_tile_states, "m_tile_states already set" );
 	{
-		size_t sz = sizeof( TileState ) * dimensions.y * dimensions.x;
-		m_tile_states = (TileState*)malloc( sz );
-		memset( ptr( m_tile_states, 0, sz ), 0, sz );
+		const size_t count = dimensions.y * dimensions.x;
+		if ( m_arena ) {
+			m_tile_states = m_arena->AllocateArray< TileState >( count );
+		}
+		else {
+			size_t sz = sizeof( TileState ) * count;
+			m_tile_states = (TileState*)malloc( sz );
+			memset( ptr( m_tile_states, 0, sz ), 0, sz );
+		}
 	}
 
 	Log( "Linking tile states" );
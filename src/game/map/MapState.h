@@ -4,12 +4,15 @@
 
 #include "TileState.h"
 #include "base/MTModule.h"
+#include "util/Arena.h"
 
 namespace game {
 namespace map {
 
 CLASS( MapState, base::Base )
 
+	// if arena is given then tile states are allocated from it and are released together with arena
+	MapState( util::Arena* arena = nullptr );
 	~MapState();
 
 	struct copy_from_after_t {
@@ -44,6 +47,7 @@ CLASS( MapState, base::Base )
 	void Unserialize( Buffer buf );
 
 private:
+	util::Arena* const m_arena = nullptr;
 	TileState* m_tile_states = nullptr;
 
 };
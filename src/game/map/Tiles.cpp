@@ -8,16 +8,17 @@
 namespace game {
 namespace map {
 
-Tiles::Tiles( const uint32_t width, const uint32_t height ) {
+Tiles::Tiles( const uint32_t width, const uint32_t height, Arena* arena )
+	: m_arena( arena ) {
 	if ( width || height ) {
 		Resize( width, height );
 	}
 }
 
 Tiles::~Tiles() {
-	free( m_data );
-	free( m_top_vertex_row );
-	free( m_top_right_vertex_row );
+	Free( m_data );
+	Free( m_top_vertex_row );
+	Free( m_top_right_vertex_row );
 }
 
 void Tiles::Resize( const uint32_t width, const uint32_t height ) {
@@ -34,26 +35,20 @@ void Tiles::Resize( const uint32_t width, const uint32_t height ) {
 
 		// warning: allocating objects without new (because it's faster), check this if any memory problems arise
 		if ( m_data ) {
-			free( m_data );
+			Free( m_data );
 		}
 		m_data_count = width * height;
-		size_t sz = sizeof( Tile ) * m_data_count;
-		m_data = (Tile*)malloc( sz );
-		memset( ptr( m_data, 0, sz ), 0, sz );
+		m_data = (Tile*)Allocate( sizeof( Tile ) * m_data_count );
 
 		if ( m_top_vertex_row ) {
-			free( m_top_vertex_row );
+			Free( m_top_vertex_row );
 		}
-		sz = sizeof( Tile::elevation_t ) * ( width ) * 2;
-		m_top_vertex_row = (Tile::elevation_t*)malloc( sz );
-		memset( ptr( m_top_vertex_row, 0, sz ), 0, sz );
+		m_top_vertex_row = (Tile::elevation_t*)Allocate( sizeof( Tile::elevation_t ) * ( width ) * 2 );
 
 		if ( m_top_right_vertex_row ) {
-			free( m_top_right_vertex_row );
+			Free( m_top_right_vertex_row );
 		}
-		sz = sizeof( Tile::elevation_t ) * ( width );
-		m_top_right_vertex_row = (Tile::elevation_t*)malloc( sz );
-		memset( ptr( m_top_right_vertex_row, 0, sz ), 0, sz );
+		m_top_right_vertex_row = (Tile::elevation_t*)Allocate( sizeof( Tile::elevation_t ) * ( width ) );
 
 		Tile* tile;
 		for ( auto y = 0 ; y < m_height ; y++ ) {
@@ -343,5 +338,21 @@ void Tiles::Unserialize( Buffer buf ) {
 
 }
 
+void* Tiles::Allocate( const size_t size ) {
+	if ( m_arena ) {
+		return m_arena->Allocate( size );
+	}
+	void* data = malloc( size );
+	memset( ptr( data, 0, size ), 0, size );
+	return data;
+}
+
+void Tiles::Free( void* data ) {
+	// arena memory stays until arena is released
+	if ( data && !m_arena ) {
+		free( data );
+	}
+}
+
 }
 }
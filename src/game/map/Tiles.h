@@ -6,6 +6,7 @@
 
 #include "Tile.h"
 #include "util/Random.h"
+#include "util/Arena.h"
 #include "base/MTModule.h"
 
 using namespace types;
@@ -16,7 +17,8 @@ namespace map {
 
 CLASS( Tiles, Serializable )
 
-	Tiles( const uint32_t width = 0, const uint32_t height = 0 );
+	// if arena is given then tile data is allocated from it and is released together with arena
+	Tiles( const uint32_t width = 0, const uint32_t height = 0, Arena* arena = nullptr );
 	~Tiles();
 
 	// warning: this will reset all tiles
@@ -47,6 +49,8 @@ CLASS( Tiles, Serializable )
 	void Unserialize( Buffer buf ) override;
 
 private:
+	Arena* const m_arena = nullptr;
+
 	uint32_t m_width = 0;
 	uint32_t m_height = 0;
 
@@ -57,6 +61,10 @@ private:
 
 	bool m_is_validated = false;
 
+	// zeroed
+	void* Allocate( const size_t size );
+	void Free( void* data );
+
 };
 
 }
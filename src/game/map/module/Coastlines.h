@@ -23,6 +23,8 @@ protected:
 		bool maybe_mirror_sw = false;
 		Texture::add_flag_t mirror_mode;
 	};
+	// per tile, in scratch arena of map
+	typedef std::vector< coastline_corner_t, util::ArenaAllocator< coastline_corner_t > > coastline_corners_t;
 };
 
 }
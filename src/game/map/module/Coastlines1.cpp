@@ -25,7 +25,8 @@ void Coastlines1::GenerateTile( const Tile* tile, TileState* ts, MapState* ms )
 	float tcwh = tcw * s_consts.tc.texture_pcx.dimensions.y;
 	const Texture::add_flag_t coastline_mode = Texture::AM_MERGE | Texture::AM_INVERT;
 
-	std::vector< coastline_corner_t > coastline_corners = {};
+	coastline_corners_t coastline_corners( m_map->GetScratchArena() );
+	coastline_corners.reserve( 4 );
 	coastline_corner_t coastline_corner_tmp = {};
 
 	if ( !tile->is_water_tile ) {
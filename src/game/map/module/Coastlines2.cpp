@@ -61,7 +61,8 @@ void Coastlines2::GenerateTile( const Tile* tile, TileState* ts, MapState* ms )
 
 		// add perlin borders where needed
 
-		std::vector< coastline_corner_t > coastline_corners = {};
+		coastline_corners_t coastline_corners( m_map->GetScratchArena() );
+		coastline_corners.reserve( 4 );
 		coastline_corner_t coastline_corner_tmp = {};
 
 		if ( !tile->NW->is_water_tile && tile->coord.y > 0 ) {
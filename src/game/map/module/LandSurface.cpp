@@ -188,7 +188,7 @@ void LandSurface::GenerateTile( const Tile* tile, TileState* ts, MapState* ms )
 			Tile::T_MAG_TUBE
 		} ) {
 			if ( tile->terraforming & t ) {
-				std::vector< uint8_t > road_variants = {};
+				std::vector< uint8_t, util::ArenaAllocator< uint8_t > > road_variants( m_map->GetScratchArena() );
 				road_variants.reserve( 9 ); // to minimize reallocations
 
 #define x( _side, _variant ) { \
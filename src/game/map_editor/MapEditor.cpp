@@ -1,7 +1,6 @@
-#include <unordered_set>
-
 #include "MapEditor.h"
 
+#include "../Game.h"
 #include "../map/Tile.h"
 
 #include "brush/Dot.h"
@@ -27,6 +26,8 @@ MapEditor::MapEditor( Game* game )
 	x( BT_SQUARE_5_5, 5 );
 	x( BT_SQUARE_7_7, 7 );
 	x( BT_SQUARE_9_9, 9 );
+	x( BT_SQUARE_15_15, 15 );
+	x( BT_SQUARE_21_21, 21 );
 #undef x
 
 	NEW( m_tools[ TT_ELEVATIONS ], tool::Elevations, m_game );
@@ -64,6 +65,9 @@ MapEditor::MapEditor( Game* game )
 }
 
 MapEditor::~MapEditor() {
+	for ( auto& brush : m_brushes ) {
+		DELETE( brush.second );
+	}
 	for ( auto& tool : m_tools ) {
 		DELETE( tool.second );
 	}
@@ -144,17 +148,34 @@ const MapEditor::brush_type_t MapEditor::GetActiveBrushType() const {
 	}
 }
 
-const MapEditor::tiles_t MapEditor::GetUniqueTiles( const tiles_t& tiles ) const {
-	std::unordered_set< map::Tile* > added_tiles = {};
-	added_tiles.reserve( tiles.size() );
+const MapEditor::tiles_t MapEditor::GetUniqueTiles( const tiles_t& tiles ) {
+	const auto* map = m_game->GetMap();
+	const size_t width = map->GetWidth();
+	const size_t sz = ( width * map->GetHeight() + 63 ) / 64;
+	if ( m_tiles_mask_width != width || m_tiles_mask.size() != sz ) {
+		m_tiles_mask.assign( sz, 0 );
+		m_tiles_mask_width = width;
+	}
+
 	tiles_t result = {};
 	result.reserve( tiles.size() );
+	size_t index;
+	uint64_t bit;
 	for ( auto& tile : tiles ) {
-		if ( added_tiles.find( tile ) == added_tiles.end() ) {
-			added_tiles.insert( tile );
+		index = tile->coord.y * width + tile->coord.x;
+		bit = (uint64_t)1 << ( index & 63 );
+		auto& word = m_tiles_mask[ index >> 6 ];
+		if ( !( word & bit ) ) {
+			word |= bit;
 			result.push_back( tile );
 		}
 	}
+
+	// leave mask clean for next call
+	for ( auto& tile : result ) {
+		m_tiles_mask[ ( tile->coord.y * width + tile->coord.x ) >> 6 ] = 0;
+	}
+
 	return result;
 }
 
@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <unordered_map>
+#include <cstdint>
 
 #include "base/Base.h"
 
@@ -69,6 +70,8 @@ CLASS( MapEditor, base::Base )
 		BT_SQUARE_5_5,
 		BT_SQUARE_7_7,
 		BT_SQUARE_9_9,
+		BT_SQUARE_15_15,
+		BT_SQUARE_21_21,
 
 		BT_MAX
 	};
@@ -94,7 +97,11 @@ CLASS( MapEditor, base::Base )
 private:
 	Game* m_game = nullptr;
 
-	const tiles_t GetUniqueTiles( const tiles_t& tiles ) const;
+	// map-sized bitmask for deduplication, reused between draws
+	// only bits that were set are cleared afterwards, so cost doesn't depend on map size
+	std::vector< uint64_t > m_tiles_mask = {};
+	size_t m_tiles_mask_width = 0;
+	const tiles_t GetUniqueTiles( const tiles_t& tiles );
 };
 
 }
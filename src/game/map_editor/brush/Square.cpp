@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "Square.h"
 
 #include "../../map/Tile.h"
@@ -10,67 +12,63 @@ namespace brush {
 Square::Square( Game* game, const MapEditor::brush_type_t type, const uint16_t width )
 	: Brush( game, type )
 	, m_width( width ) {
-	//
-}
-
-const MapEditor::tiles_t Square::Draw( map::Tile* center_tile ) {
-	const auto* map = m_game->GetMap()->GetTilesPtr();
-	MapEditor::tiles_t tiles = {};
-	tiles.reserve( m_width * m_width );
-	// order is important, start with sides and move towards center for greatest effect
-	// TODO: shuffle
-
-	const auto f_add_tile_maybe = [ &tiles, &map ]( const Vec2< ssize_t > coords ) -> void {
-		if (
-			coords.x >= 0 &&
-				coords.y >= 0 &&
-				coords.x <= map->GetWidth() - 1 &&
-				coords.y <= map->GetHeight() - 1
-			) {
-			tiles.push_back( map->At( coords.x, coords.y ) );
-		}
-	};
 
-	for ( int y = -m_width ; y <= m_width ; y++ ) {
-		for ( int x = -m_width ; x <= m_width ; x++ ) {
+	const ssize_t w = m_width;
+	for ( ssize_t y = -w ; y <= w ; y++ ) {
+		for ( ssize_t x = -w ; x <= w ; x++ ) {
 			if ( ( y & 1 ) != ( x & 1 ) ) {
 				continue;
 			}
-
 			if ( x == 0 && y == 0 ) {
 				continue; // center tile will be added last
 			}
-			if ( abs( x ) + abs( y ) > m_width ) {
+			if ( abs( x ) + abs( y ) > w ) {
 				continue; // draw diagonal square instead of full square
 			}
-
-			f_add_tile_maybe(
-				{
-					(ssize_t)center_tile->coord.x + x,
-					(ssize_t)center_tile->coord.y - y
-				}
-			);
-			f_add_tile_maybe(
+			m_offsets.push_back(
 				{
-					(ssize_t)center_tile->coord.x - x,
-					(ssize_t)center_tile->coord.y + y
-				}
-			);
-			f_add_tile_maybe(
-				{
-					(ssize_t)center_tile->coord.x + x,
-					(ssize_t)center_tile->coord.y + y
-				}
-			);
-			f_add_tile_maybe(
-				{
-					(ssize_t)center_tile->coord.x - x,
-					(ssize_t)center_tile->coord.y - y
+					x,
+					y
 				}
 			);
 		}
 	}
-	tiles.push_back( center_tile );
+
+	// start with sides and move towards center for greatest effect
+	// TODO: shuffle
+	std::stable_sort(
+		m_offsets.begin(), m_offsets.end(), []( const types::Vec2< ssize_t >& a, const types::Vec2< ssize_t >& b ) -> bool {
+			return abs( a.x ) + abs( a.y ) > abs( b.x ) + abs( b.y );
+		}
+	);
+
+	m_offsets.push_back(
+		{
+			0,
+			0
+		}
+	);
+}
+
+const MapEditor::tiles_t Square::Draw( map::Tile* center_tile ) {
+	const auto* map = m_game->GetMap()->GetTilesPtr();
+	const ssize_t w = map->GetWidth();
+	const ssize_t h = map->GetHeight();
+	const ssize_t cx = center_tile->coord.x;
+	const ssize_t cy = center_tile->coord.y;
+
+	MapEditor::tiles_t tiles = {};
+	tiles.reserve( m_offsets.size() );
+
+	ssize_t x, y;
+	for ( const auto& offset : m_offsets ) {
+		x = cx + offset.x;
+		y = cy + offset.y;
+		if ( x >= 0 && y >= 0 && x < w && y < h ) {
+			tiles.push_back( map->At( x, y ) );
+		}
+	}
+
 	return tiles;
 }
 
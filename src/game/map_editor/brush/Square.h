@@ -1,9 +1,12 @@
 #pragma once
 
 #include <cstdint>
+#include <vector>
 
 #include "Brush.h"
 
+#include "types/Vec2.h"
+
 namespace game {
 namespace map_editor {
 namespace brush {
@@ -17,6 +20,10 @@ CLASS( Square, Brush )
 private:
 	const uint16_t m_width = 1;
 
+	// relative tile coordinates covered by brush, precalculated once and without duplicates
+	// order is important, sides go first and center tile is last
+	std::vector< types::Vec2< ssize_t > > m_offsets = {};
+
 };
 
 }
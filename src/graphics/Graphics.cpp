@@ -5,10 +5,10 @@ namespace graphics {
 Graphics::~Graphics() {
 #ifdef DEBUG
 	if ( !m_on_resize_handlers.empty() ) {
-		Log( "WARNING: some resize handlers still set" );
+		Log( LL_WARNING, "some resize handlers still set" );
 	}
 	if ( !m_on_resize_handlers_order.empty() ) {
-		Log( "WARNING: some resize handlers still set in order vector" );
+		Log( LL_WARNING, "some resize handlers still set in order vector" );
 	}
 #endif
 }
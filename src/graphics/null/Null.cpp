@@ -0,0 +1,259 @@
+#include "Null.h"
+
+#include "scene/actor/Mesh.h"
+#include "scene/actor/Sprite.h"
+#include "scene/actor/Instanced.h"
+#include "rr/GetData.h"
+#include "rr/Capture.h"
+
+namespace graphics {
+namespace null {
+
+Null::Null( const unsigned short window_width, const unsigned short window_height ) {
+	m_window_size = {
+		window_width,
+		window_height
+	};
+}
+
+void Null::Start() {
+	Log( "Starting without graphics output" );
+	OnWindowResize();
+}
+
+void Null::Stop() {
+	Log(
+		"Rendered " + std::to_string( m_stats.frames ) + " frames" +
+			", " + std::to_string( m_stats.draw_calls ) + " draw calls" +
+			", " + std::to_string( m_stats.instances ) + " instances" +
+			" (" + std::to_string( m_stats.instances_culled ) + " culled)" +
+			", uploaded " + std::to_string( m_stats.textures_uploaded ) + " texture bytes" +
+			", " + std::to_string( m_stats.vertex_buffers_uploaded ) + " vertex bytes" +
+			", " + std::to_string( m_stats.index_buffers_uploaded ) + " index bytes"
+	);
+	m_textures.clear();
+	m_meshes.clear();
+}
+
+void Null::Iterate() {
+	Lock();
+
+	Graphics::Iterate();
+
+	for ( auto& scene : m_scenes ) {
+		for ( auto& actor : *scene->GetActors() ) {
+			ProcessActor( actor );
+		}
+	}
+
+	// meshes that weren't drawn this frame may be destroyed already
+	m_meshes.swap( m_meshes_seen );
+	m_meshes_seen.clear();
+
+	m_stats.frames++;
+
+	Unlock();
+
+	STAT_INC( frames_rendered );
+}
+
+void Null::AddScene( scene::Scene* scene ) {
+	Log( "Adding scene [" + scene->GetName() + "]" );
+	ASSERT( m_scenes.find( scene ) == m_scenes.end(), "scene [" + scene->GetName() + "] already added" );
+	m_scenes.insert( scene );
+}
+
+void Null::RemoveScene( scene::Scene* scene ) {
+	Log( "Removing scene [" + scene->GetName() + "]" );
+	auto it = m_scenes.find( scene );
+	ASSERT( it != m_scenes.end(), "scene [" + scene->GetName() + "] not found" );
+	m_scenes.erase( it );
+}
+
+const unsigned short Null::GetWindowWidth() const {
+	return m_window_size.x;
+}
+
+const unsigned short Null::GetWindowHeight() const {
+	return m_window_size.y;
+}
+
+const unsigned short Null::GetViewportWidth() const {
+	return m_window_size.x;
+}
+
+const unsigned short Null::GetViewportHeight() const {
+	return m_window_size.y;
+}
+
+void Null::LoadTexture( types::Texture* texture ) {
+	ASSERT( texture, "texture is null" );
+
+	const size_t texture_update_counter = texture->UpdatedCount();
+	auto it = m_textures.find( texture );
+	if ( it == m_textures.end() || texture->IsFullyUpdated() ) {
+		m_textures[ texture ] = texture_update_counter;
+		m_stats.textures_loaded++;
+		m_stats.textures_uploaded += texture->m_width * texture->m_height * 4;
+	}
+	else if ( it->second != texture_update_counter ) {
+		it->second = texture_update_counter;
+		for ( auto& area : texture->GetUpdatedAreas() ) {
+			m_stats.textures_uploaded += ( area.right - area.left ) * ( area.bottom - area.top ) * 4;
+		}
+	}
+	else {
+		return;
+	}
+	texture->ClearUpdatedAreas();
+}
+
+void Null::UnloadTexture( const types::Texture* texture ) {
+	auto it = m_textures.find( texture );
+	if ( it != m_textures.end() ) {
+		m_textures.erase( it );
+	}
+}
+
+void Null::EnableTexture( const types::Texture* texture ) {
+	//
+}
+
+void Null::DisableTexture() {
+	//
+}
+
+const bool Null::IsFullscreen() const {
+	return false;
+}
+
+void Null::SetFullscreen() {
+	//
+}
+
+void Null::SetWindowed() {
+	//
+}
+
+void Null::RedrawOverlay() {
+	//
+}
+
+const bool Null::IsMouseLocked() const {
+	return false;
+}
+
+void Null::ResizeWindow( const size_t width, const size_t height ) {
+	m_window_size = {
+		(unsigned short)width,
+		(unsigned short)height
+	};
+	OnWindowResize();
+}
+
+const Null::stats_t& Null::GetStats() const {
+	return m_stats;
+}
+
+void Null::ProcessActor( scene::actor::Actor* actor ) {
+	m_stats.actors++;
+	switch ( actor->GetType() ) {
+		case scene::actor::Actor::TYPE_SPRITE: {
+			auto* sprite = (scene::actor::Sprite*)actor;
+			if ( sprite->GetTexture() ) {
+				LoadTexture( sprite->GetTexture() );
+			}
+			actor->GetWorldMatrix();
+			m_stats.draw_calls++;
+			m_stats.instances++;
+			break;
+		}
+		case scene::actor::Actor::TYPE_INSTANCED_SPRITE:
+		case scene::actor::Actor::TYPE_INSTANCED_MESH: {
+			auto* instanced = (scene::actor::Instanced*)actor;
+			if ( actor->GetType() == scene::actor::Actor::TYPE_INSTANCED_SPRITE ) {
+				auto* sprite = instanced->GetSpriteActor();
+				if ( sprite->GetTexture() ) {
+					LoadTexture( sprite->GetTexture() );
+				}
+			}
+			else {
+				auto* mesh_actor = instanced->GetMeshActor();
+				if ( mesh_actor->GetMesh() ) {
+					LoadMesh( mesh_actor->GetMesh() );
+				}
+				if ( mesh_actor->GetTexture() ) {
+					LoadTexture( mesh_actor->GetTexture() );
+				}
+			}
+			m_stats.draw_calls++;
+			m_stats.instances += instanced->GetInstanceMatrices().size();
+			m_stats.instances_culled += instanced->GetCulledInstancesCount();
+			break;
+		}
+		case scene::actor::Actor::TYPE_MESH: {
+			auto* mesh_actor = (scene::actor::Mesh*)actor;
+			if ( mesh_actor->GetMesh() ) {
+				LoadMesh( mesh_actor->GetMesh() );
+			}
+			if ( mesh_actor->GetDataMesh() ) {
+				LoadMesh( mesh_actor->GetDataMesh() );
+			}
+			if ( mesh_actor->GetTexture() ) {
+				LoadTexture( mesh_actor->GetTexture() );
+			}
+			actor->GetWorldMatrix();
+			m_stats.draw_calls++;
+			m_stats.instances++;
+
+			// nothing is rendered so there is no data under cursor
+			for ( auto& r : mesh_actor->RR_GetRequests< rr::GetData >() ) {
+				r->data = 0;
+				r->SetProcessed();
+				m_stats.data_requests++;
+			}
+
+			// captures produce empty textures of requested size
+			for ( auto& r : mesh_actor->RR_GetRequests< rr::Capture >() ) {
+				NEW( r->texture, types::Texture, "Capture", r->texture_width, r->texture_height );
+				r->SetProcessed();
+				m_stats.capture_requests++;
+			}
+			break;
+		}
+		case scene::actor::Actor::TYPE_TEXT: {
+			m_stats.draw_calls++;
+			break;
+		}
+		default: {
+			// nothing to draw
+		}
+	}
+}
+
+void Null::LoadMesh( types::mesh::Mesh* mesh ) {
+	const size_t mesh_update_counter = mesh->UpdatedCount();
+	m_meshes_seen[ mesh ] = mesh_update_counter;
+
+	types::mesh::Mesh::updated_ranges_t vertex_ranges = {};
+	types::mesh::Mesh::updated_ranges_t index_ranges = {};
+	auto it = m_meshes.find( mesh );
+	if ( it == m_meshes.end() ) {
+		mesh->TakeUpdatedRanges( &vertex_ranges, &index_ranges );
+		m_stats.meshes_loaded++;
+		m_stats.vertex_buffers_uploaded += mesh->GetVertexDataSize();
+		m_stats.index_buffers_uploaded += mesh->GetIndexDataSize();
+	}
+	else if ( it->second != mesh_update_counter ) {
+		mesh->TakeUpdatedRanges( &vertex_ranges, &index_ranges );
+		for ( auto& range : vertex_ranges ) {
+			m_stats.vertex_buffers_uploaded += ( range.end - range.begin ) * mesh->VERTEX_SIZE * sizeof( types::mesh::Mesh::coord_t );
+		}
+		for ( auto& range : index_ranges ) {
+			m_stats.index_buffers_uploaded += ( range.end - range.begin ) * sizeof( types::mesh::Mesh::index_t );
+		}
+	}
+}
+
+} /* namespace null */
+} /* namespace graphics */
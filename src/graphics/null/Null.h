@@ -0,0 +1,78 @@
+#pragma once
+
+#include <unordered_map>
+#include <unordered_set>
+
+#include "../Graphics.h"
+
+#include "types/mesh/Mesh.h"
+
+namespace graphics {
+namespace null {
+
+// graphics without any output, for running game headlessly (i.e. for benchmarks and tests)
+// walks scenes like real renderer would, but only records what would have been drawn and uploaded
+CLASS( Null, Graphics )
+
+	Null( const unsigned short window_width, const unsigned short window_height );
+
+	void Start() override;
+	void Stop() override;
+	void Iterate() override;
+
+	void AddScene( scene::Scene* scene ) override;
+	void RemoveScene( scene::Scene* scene ) override;
+
+	const unsigned short GetWindowWidth() const override;
+	const unsigned short GetWindowHeight() const override;
+	const unsigned short GetViewportWidth() const override;
+	const unsigned short GetViewportHeight() const override;
+
+	void LoadTexture( types::Texture* texture ) override;
+	void UnloadTexture( const types::Texture* texture ) override;
+	void EnableTexture( const types::Texture* texture ) override;
+	void DisableTexture() override;
+
+	const bool IsFullscreen() const override;
+	void SetFullscreen() override;
+	void SetWindowed() override;
+
+	void RedrawOverlay() override;
+
+	const bool IsMouseLocked() const override;
+
+	void ResizeWindow( const size_t width, const size_t height ) override;
+
+	struct stats_t {
+		size_t frames = 0;
+		size_t actors = 0;
+		size_t draw_calls = 0;
+		size_t instances = 0;
+		size_t instances_culled = 0;
+		size_t textures_loaded = 0;
+		size_t textures_uploaded = 0; // bytes
+		size_t meshes_loaded = 0;
+		size_t vertex_buffers_uploaded = 0; // bytes
+		size_t index_buffers_uploaded = 0; // bytes
+		size_t data_requests = 0;
+		size_t capture_requests = 0;
+	};
+	const stats_t& GetStats() const;
+
+private:
+	types::Vec2< unsigned short > m_window_size = {};
+
+	std::unordered_set< scene::Scene* > m_scenes = {};
+
+	std::unordered_map< const types::Texture*, size_t > m_textures = {}; // texture -> last update counter
+	std::unordered_map< const types::mesh::Mesh*, size_t > m_meshes = {}; // mesh -> last update counter
+	std::unordered_map< const types::mesh::Mesh*, size_t > m_meshes_seen = {}; // to forget meshes that are not drawn anymore
+
+	stats_t m_stats = {};
+
+	void ProcessActor( scene::actor::Actor* actor );
+	void LoadMesh( types::mesh::Mesh* mesh );
+};
+
+} /* namespace null */
+} /* namespace graphics */
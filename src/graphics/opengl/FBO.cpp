@@ -127,6 +127,7 @@ void FBO::Resize( size_t width, size_t height ) {
 		glBindFramebuffer( GL_FRAMEBUFFER, m_fbo );
 
 		glBindTexture( GL_TEXTURE_2D, m_textures.render );
+		STAT_INC( opengl_textures_updates );
 		glTexImage2D( GL_TEXTURE_2D, 0, GL_RGBA8, m_width, m_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL );
 		glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
 		glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
@@ -134,6 +135,7 @@ void FBO::Resize( size_t width, size_t height ) {
 		glFramebufferTexture2D( GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_textures.render, 0 );
 
 		glBindTexture( GL_TEXTURE_2D, m_textures.depth );
+		STAT_INC( opengl_textures_updates );
 		glTexImage2D( GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT, m_width, m_height, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL );
 		glBindTexture( GL_TEXTURE_2D, 0 );
 		glFramebufferTexture2D( GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, m_textures.depth, 0 );
@@ -200,6 +202,7 @@ void FBO::Draw( shader_program::Simple2D* sp ) {
 	glUniform1ui( sp->uniforms.flags, 0 );
 
 	glBindTexture( GL_TEXTURE_2D, m_textures.render );
+	STAT_INC( opengl_draw_calls );
 	glDrawElements( GL_TRIANGLES, m_ibo_size, GL_UNSIGNED_INT, (void*)( 0 ) );
 	glBindTexture( GL_TEXTURE_2D, 0 );
 
@@ -110,6 +110,14 @@ void OpenGL::Start() {
 		THROW( "Unable to initialize OpenGL!" );
 	}
 
+	if ( m_options.vsync && m_thread ) {
+		SDL_DisplayMode dm;
+		if ( !SDL_GetDesktopDisplayMode( 0, &dm ) && dm.refresh_rate ) {
+			// buffer swaps will wait for vertical blank, so main thread shouldn't sleep through it
+			m_thread->GetFrameScheduler()->SetVSyncRate( dm.refresh_rate );
+		}
+	}
+
 	{ // print some OpenGL info
 		auto* renderer = (const char*)glGetString( GL_RENDERER );
 		auto* vendor = (const char*)glGetString( GL_VENDOR );
@@ -157,6 +165,7 @@ void OpenGL::Start() {
 	glBindTexture( GL_TEXTURE_2D, m_no_texture );
 
 	uint32_t nothing = 0;
+	STAT_INC( opengl_textures_updates );
 	glTexImage2D( GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, &nothing );
 	ASSERT( !glGetError(), "Error loading texture" );
 
@@ -219,7 +228,7 @@ void OpenGL::Iterate() {
 
 	Unlock();
 
-	DEBUG_STAT_INC( frames_rendered );
+	STAT_INC( frames_rendered );
 }
 
 void OpenGL::AddScene( scene::Scene* scene ) {
@@ -318,10 +327,16 @@ void OpenGL::LoadTexture( types::Texture* texture ) {
 
 		glBindTexture( GL_TEXTURE_2D, t.obj );
 
-		if ( need_full_update ) {
+		if (
+			need_full_update ||
+				texture->IsFullyUpdated() ||
+				t.width != texture->m_width ||
+				t.height != texture->m_height
+			) {
 			ASSERT( !glGetError(), "Texture parameter error" );
 			glPixelStorei( GL_UNPACK_ALIGNMENT, 1 );
 
+			STAT_INC( opengl_textures_updates );
 			glTexImage2D(
 				GL_TEXTURE_2D,
 				0,
@@ -334,146 +349,277 @@ void OpenGL::LoadTexture( types::Texture* texture ) {
 				ptr( texture->m_bitmap, 0, texture->m_width * texture->m_height * 4 )
 			);
 
-			glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR );
-			glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR );
-			glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT );
-			glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT );
-		}
-		else if ( !texture->GetUpdatedAreas().empty() ) {
+			if ( need_full_update ) {
+				glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR );
+				glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR );
+				glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT );
+				glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT );
+			}
 
-			// combine multiple updates into one or fewer
+			ASSERT( !glGetError(), "Error loading texture" );
 
-			types::Texture::updated_areas_t areas = {};
+			// whole texture changed, let gpu build all mipmaps
+			glGenerateMipmap( GL_TEXTURE_2D );
+			STAT_INC( opengl_textures_mipmaps_generated );
 
-			const auto& updated_areas = texture->GetUpdatedAreas();
+			t.width = texture->m_width;
+			t.height = texture->m_height;
+			t.cpu_mips.clear(); // will be rebuilt if partial updates happen
+		}
+		else {
+			// upload only changed cells directly from texture bitmap, and update only their mipmaps
+			const auto updated_areas = texture->GetUpdatedAreas();
+			if ( !updated_areas.empty() ) {
+				glPixelStorei( GL_UNPACK_ALIGNMENT, 1 );
+				for ( auto& area : updated_areas ) {
+					//Log( "Reloading texture area " + area.ToString() );
+					UpdateTextureArea( texture, t, area );
+				}
+			}
+		}
+		texture->ClearUpdatedAreas();
 
-			const uint8_t od = 1; // overlap distance
+		glBindTexture( GL_TEXTURE_2D, 0 );
 
-			const auto f_are_combineable = []( const types::Texture::updated_area_t& first, const types::Texture::updated_area_t& second ) -> bool {
-				return
-					(
-						( first.left + od >= second.left && first.left - od <= second.right ) ||
-							( first.right + od >= second.left && first.right - od <= second.right )
-					) &&
-						(
-							( first.top + od >= second.top && first.top - od <= second.bottom ) ||
-								( first.bottom + od >= second.top && first.bottom - od <= second.bottom )
-						);
-			};
+		ASSERT( !glGetError(), "Error somewhere while loading texture" );
+	}
+}
 
-			const auto f_combine = []( types::Texture::updated_area_t& first, const types::Texture::updated_area_t& second ) -> void {
-				//Log( "Merging texture area " + second.ToString() + " into " + first.ToString() );
-				first.left = std::min< size_t >( first.left, second.left );
-				first.top = std::min< size_t >( first.top, second.top );
-				first.right = std::max< size_t >( first.right, second.right );
-				first.bottom = std::max< size_t >( first.bottom, second.bottom );
-			};
+void OpenGL::UpdateTextureArea( types::Texture* texture, texture_data_t& t, const types::Texture::updated_area_t& area ) {
+	ASSERT( area.left < area.right && area.top < area.bottom, "invalid texture area " + area.ToString() );
+	ASSERT( area.right <= texture->m_width && area.bottom <= texture->m_height, "texture area out of bounds " + area.ToString() );
+
+	// level 0 straight from texture bitmap
+	glPixelStorei( GL_UNPACK_ROW_LENGTH, texture->m_width );
+	glPixelStorei( GL_UNPACK_SKIP_PIXELS, area.left );
+	glPixelStorei( GL_UNPACK_SKIP_ROWS, area.top );
+	STAT_INC( opengl_textures_updates );
+	glTexSubImage2D(
+		GL_TEXTURE_2D,
+		0,
+		area.left,
+		area.top,
+		area.right - area.left,
+		area.bottom - area.top,
+		GL_RGBA,
+		GL_UNSIGNED_BYTE,
+		ptr( texture->m_bitmap, 0, texture->m_width * texture->m_height * 4 )
+	);
+	glPixelStorei( GL_UNPACK_SKIP_PIXELS, 0 );
+	glPixelStorei( GL_UNPACK_SKIP_ROWS, 0 );
+	glPixelStorei( GL_UNPACK_ROW_LENGTH, 0 );
+
+	// levels up to CPU_MIP_LEVEL only depend on pixels of updated cells, so they are downsampled into temporary buffers
+	// smaller levels need neighbouring pixels too, so they are updated within full cpu-side copies
+	const unsigned char* src = texture->m_bitmap;
+	size_t src_stride = texture->m_width;
+	types::Texture::updated_area_t src_bounds = {
+		0,
+		0,
+		texture->m_width,
+		texture->m_height
+	};
+	types::Texture::updated_area_t region = area;
+	size_t level_width = texture->m_width;
+	size_t level_height = texture->m_height;
+	std::vector< unsigned char > src_buf = {};
+	std::vector< unsigned char > dst_buf = {};
+	size_t level = 0;
+	while ( level_width > 1 || level_height > 1 ) {
+		level++;
+		level_width = std::max< size_t >( level_width >> 1, 1 );
+		level_height = std::max< size_t >( level_height >> 1, 1 );
+
+		region = {
+			region.left >> 1,
+			region.top >> 1,
+			std::min< size_t >( ( region.right + 1 ) >> 1, level_width ),
+			std::min< size_t >( ( region.bottom + 1 ) >> 1, level_height ),
+		};
+		if ( region.left >= region.right || region.top >= region.bottom ) {
+			// area only covers odd pixels at the edge that don't contribute to smaller levels
+			break;
+		}
 
-			// mark area as removed (merged into another)
-			const auto f_remove = []( types::Texture::updated_area_t& area ) -> void {
-				area.right = area.top = 0; // hackish but no actual area would have these coordinates at 0
-			};
+		unsigned char* dst;
+		size_t dst_stride;
+		if ( level < CPU_MIP_LEVEL ) {
+			dst_stride = region.right - region.left;
+			dst_buf.resize( dst_stride * ( region.bottom - region.top ) * 4 );
+			dst = dst_buf.data();
+		}
+		else {
+			if ( t.cpu_mips.empty() ) {
+				BuildTextureCpuMips( texture, t );
+			}
+			auto& mip = t.cpu_mips.at( level - CPU_MIP_LEVEL );
+			ASSERT( mip.width == level_width && mip.height == level_height, "cpu mip level size mismatch" );
+			dst_stride = mip.width;
+			dst = mip.data.data() + ( region.top * mip.width + region.left ) * 4;
+		}
+
+		DownsampleTextureArea( src, src_stride, src_bounds, dst, dst_stride, region );
+		UploadTextureArea( level, dst, dst_stride, region );
 
-			// check if area was marked as removed (to skip)
-			const auto f_is_removed = []( const types::Texture::updated_area_t& area ) -> bool {
-				return area.right == 0 && area.top == 0;
+		if ( level < CPU_MIP_LEVEL ) {
+			src_buf.swap( dst_buf );
+			src = src_buf.data();
+			src_stride = dst_stride;
+			src_bounds = region;
+		}
+		else {
+			const auto& mip = t.cpu_mips.at( level - CPU_MIP_LEVEL );
+			src = mip.data.data();
+			src_stride = mip.width;
+			src_bounds = {
+				0,
+				0,
+				mip.width,
+				mip.height
 			};
+		}
+	}
+	STAT_INC( opengl_textures_areas_updated );
+}
 
-			for ( auto& updated_area : updated_areas ) {
-				//Log( "Processing texture area " + updated_area.ToString() );
-				// try to merge with existing one
-				auto it = areas.begin();
-				while ( it != areas.end() ) {
-					// if it overlaps then we can merge with existing (TODO: can optimize further by measuring overlap size)
-					if ( f_are_combineable( updated_area, *it ) ) {
-						// extend area to fit both new one and old one
-						f_combine( *it, updated_area );
-						break;
-					}
-					it++;
+void OpenGL::BuildTextureCpuMips( types::Texture* texture, texture_data_t& t ) {
+	ASSERT( t.cpu_mips.empty(), "cpu mips already built" );
+
+	size_t level_width = texture->m_width;
+	size_t level_height = texture->m_height;
+	size_t level = 0;
+	while ( level_width > 1 || level_height > 1 ) {
+		level++;
+		level_width = std::max< size_t >( level_width >> 1, 1 );
+		level_height = std::max< size_t >( level_height >> 1, 1 );
+		if ( level >= CPU_MIP_LEVEL ) {
+			t.cpu_mips.push_back(
+				{
+					level_width,
+					level_height,
+					std::vector< unsigned char >( level_width * level_height * 4 )
 				}
-				if ( it == areas.end() ) {
-					// couldn't find any suitable areas, add new one
-					//Log( "Adding texture area " + updated_area.ToString() );
-					areas.push_back(
-						{
-							updated_area.left,
-							updated_area.top,
-							updated_area.right,
-							updated_area.bottom
-						}
-					);
-				}
-			}
+			);
+		}
+	}
+	if ( t.cpu_mips.empty() ) {
+		return; // texture is too small
+	}
 
-			// keep combining until can't combine anymore
-			bool combined = true;
-			do {
-				combined = false;
-				for ( auto it_dst = areas.begin() ; it_dst < areas.end() ; it_dst++ ) {
-					if ( f_is_removed( *it_dst ) ) {
-						continue;
-					}
-					for ( auto it_src = it_dst + 1 ; it_src < areas.end() ; it_src++ ) {
-						if ( f_is_removed( *it_src ) ) {
-							continue;
-						}
-						if ( f_are_combineable( *it_dst, *it_src ) ) {
-							//Log( "Merging texture area " + it_src->ToString() + " into " + it_dst->ToString() );
-							f_combine( *it_dst, *it_src );
-							f_remove( *it_src );
-							combined = true;
-						}
-					}
-				}
+	// first cpu level is downsampled in bands of source rows to keep temporary buffers small
+	const size_t band_height = (size_t)1 << CPU_MIP_LEVEL;
+	std::vector< unsigned char > src_buf = {};
+	std::vector< unsigned char > dst_buf = {};
+	for ( size_t band_top = 0 ; band_top < texture->m_height ; band_top += band_height ) {
+		const unsigned char* src = texture->m_bitmap;
+		size_t src_stride = texture->m_width;
+		types::Texture::updated_area_t src_bounds = {
+			0,
+			0,
+			texture->m_width,
+			texture->m_height
+		};
+		types::Texture::updated_area_t region = {
+			0,
+			band_top,
+			texture->m_width,
+			std::min< size_t >( band_top + band_height, texture->m_height ),
+		};
+		level_width = texture->m_width;
+		level_height = texture->m_height;
+		for ( level = 1 ; level <= CPU_MIP_LEVEL ; level++ ) {
+			level_width = std::max< size_t >( level_width >> 1, 1 );
+			level_height = std::max< size_t >( level_height >> 1, 1 );
+			region = {
+				0,
+				region.top >> 1,
+				level_width,
+				std::min< size_t >( ( region.bottom + 1 ) >> 1, level_height ),
+			};
+			if ( region.top >= region.bottom ) {
+				break;
 			}
-			while ( combined );
-
-			// reload areas into opengl
-			for ( auto& area : areas ) {
-				if ( f_is_removed( area ) ) {
-					continue;
-				}
-
-				//Log( "Reloading texture area " + area.ToString() );
-
-				const size_t w = area.right - area.left;
-				const size_t h = area.bottom - area.top;
-
-				auto* bitmap = texture->CopyBitmap(
-					area.left,
-					area.top,
-					area.right,
-					area.bottom
-				);
-
-				glTexSubImage2D(
-					GL_TEXTURE_2D,
-					0,
-					area.left,
-					area.top,
-					w,
-					h,
-					GL_RGBA,
-					GL_UNSIGNED_BYTE,
-					ptr( bitmap, 0, w * h * 4 )
-				);
-
-				free( bitmap );
+			if ( level < CPU_MIP_LEVEL ) {
+				dst_buf.resize( level_width * ( region.bottom - region.top ) * 4 );
+				DownsampleTextureArea( src, src_stride, src_bounds, dst_buf.data(), level_width, region );
+				src_buf.swap( dst_buf );
+				src = src_buf.data();
+				src_stride = level_width;
+				src_bounds = region;
+			}
+			else {
+				auto& mip = t.cpu_mips.front();
+				DownsampleTextureArea( src, src_stride, src_bounds, mip.data.data() + region.top * mip.width * 4, mip.width, region );
 			}
 		}
-		texture->ClearUpdatedAreas();
-
-		ASSERT( !glGetError(), "Error loading texture" );
-
-		glGenerateMipmap( GL_TEXTURE_2D );
+	}
 
-		glBindTexture( GL_TEXTURE_2D, 0 );
+	// smaller levels from previous ones
+	for ( size_t i = 1 ; i < t.cpu_mips.size() ; i++ ) {
+		const auto& src = t.cpu_mips[ i - 1 ];
+		auto& dst = t.cpu_mips[ i ];
+		DownsampleTextureArea(
+			src.data.data(),
+			src.width,
+			{
+				0,
+				0,
+				src.width,
+				src.height
+			},
+			dst.data.data(),
+			dst.width,
+			{
+				0,
+				0,
+				dst.width,
+				dst.height
+			}
+		);
+	}
+}
 
-		ASSERT( !glGetError(), "Error somewhere while loading texture" );
+void OpenGL::DownsampleTextureArea( const unsigned char* src, const size_t src_stride, const types::Texture::updated_area_t& src_bounds, unsigned char* dst, const size_t dst_stride, const types::Texture::updated_area_t& dst_area ) {
+	// 2x2 box filter, source pixels are clamped to bounds
+	// src points to top left pixel of src_bounds, dst points to top left pixel of dst_area
+	size_t sy1, sy2, sx1, sx2;
+	const unsigned char* p1, * p2, * p3, * p4;
+	unsigned char* d;
+	for ( size_t y = dst_area.top ; y < dst_area.bottom ; y++ ) {
+		sy1 = std::min< size_t >( y << 1, src_bounds.bottom - 1 ) - src_bounds.top;
+		sy2 = std::min< size_t >( ( y << 1 ) + 1, src_bounds.bottom - 1 ) - src_bounds.top;
+		d = dst + ( y - dst_area.top ) * dst_stride * 4;
+		for ( size_t x = dst_area.left ; x < dst_area.right ; x++ ) {
+			sx1 = std::min< size_t >( x << 1, src_bounds.right - 1 ) - src_bounds.left;
+			sx2 = std::min< size_t >( ( x << 1 ) + 1, src_bounds.right - 1 ) - src_bounds.left;
+			p1 = src + ( sy1 * src_stride + sx1 ) * 4;
+			p2 = src + ( sy1 * src_stride + sx2 ) * 4;
+			p3 = src + ( sy2 * src_stride + sx1 ) * 4;
+			p4 = src + ( sy2 * src_stride + sx2 ) * 4;
+			for ( uint8_t c = 0 ; c < 4 ; c++ ) {
+				*( d++ ) = ( p1[ c ] + p2[ c ] + p3[ c ] + p4[ c ] + 2 ) >> 2;
+			}
+		}
 	}
 }
 
+void OpenGL::UploadTextureArea( const size_t level, const unsigned char* data, const size_t stride, const types::Texture::updated_area_t& area ) {
+	glPixelStorei( GL_UNPACK_ROW_LENGTH, stride );
+	STAT_INC( opengl_textures_updates );
+	glTexSubImage2D(
+		GL_TEXTURE_2D,
+		level,
+		area.left,
+		area.top,
+		area.right - area.left,
+		area.bottom - area.top,
+		GL_RGBA,
+		GL_UNSIGNED_BYTE,
+		data
+	);
+	glPixelStorei( GL_UNPACK_ROW_LENGTH, 0 );
+}
+
 void OpenGL::UnloadTexture( const types::Texture* texture ) {
 	m_textures_map::iterator it = m_textures.find( texture );
 	if ( it != m_textures.end() ) {
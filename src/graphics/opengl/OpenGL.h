@@ -34,12 +34,6 @@ class Overlay;
 
 CLASS( OpenGL, Graphics )
 
-	// maximum instances of same actor, more = faster rendering of same objects
-	// includes extra instances from map instancing
-	// limited by opengl uniform array size, maximum is around 256 so don't exceed it
-	// rendering will be split to multiple draw calls if number of instances is larger
-	static constexpr size_t MAX_INSTANCES = 224;
-
 	static constexpr float VIEWPORT_MULTIPLIER = 1.0f; // larger size for internal viewport // TODO
 
 	OpenGL( const std::string title, const unsigned short window_width, const unsigned short window_height, const bool vsync, const bool fullscreen );
@@ -97,9 +91,22 @@ protected:
 
 private:
 
+	// mip levels from this one and smaller are kept on cpu side so that partial updates can rebuild them without gpu readback
+	// matches texture update cell size, so levels above it can be computed from updated cells alone
+	static constexpr size_t CPU_MIP_LEVEL = types::Texture::UPDATE_CELL_SIZE_LOG;
+
+	struct mip_level_t {
+		size_t width = 0;
+		size_t height = 0;
+		std::vector< unsigned char > data = {};
+	};
+
 	struct texture_data_t {
 		GLuint obj = 0;
 		size_t last_texture_update_counter = 0;
+		size_t width = 0;
+		size_t height = 0;
+		std::vector< mip_level_t > cpu_mips = {}; // starting from CPU_MIP_LEVEL, built on first partial update
 	};
 	typedef std::unordered_map< const types::Texture*, texture_data_t > m_textures_map;
 	m_textures_map m_textures = {};
@@ -112,6 +119,11 @@ private:
 	bool m_is_fullscreen = false;
 
 	void UpdateViewportSize( const size_t width, const size_t height );
+
+	void UpdateTextureArea( types::Texture* texture, texture_data_t& t, const types::Texture::updated_area_t& area );
+	void BuildTextureCpuMips( types::Texture* texture, texture_data_t& t );
+	void UploadTextureArea( const size_t level, const unsigned char* data, const size_t stride, const types::Texture::updated_area_t& area );
+	static void DownsampleTextureArea( const unsigned char* src, const size_t src_stride, const types::Texture::updated_area_t& src_bounds, unsigned char* dst, const size_t dst_stride, const types::Texture::updated_area_t& dst_area );
 };
 
 } /* namespace opengl */
@@ -2,6 +2,9 @@
 
 #include "actor/Sprite.h"
 #include "actor/Mesh.h"
+#include "actor/Text.h"
+#include "shader_program/Orthographic.h"
+#include "shader_program/Font.h"
 
 #include "scene/actor/Actor.h"
 #include "scene/actor/Instanced.h"
@@ -19,6 +22,14 @@ Scene::~Scene() {
 	for ( auto it = m_gl_actors.begin() ; it < m_gl_actors.end() ; ++it ) {
 		RemoveActor( *it );
 	}
+	for ( auto& batches : m_sprite_batches ) {
+		for ( auto& batch : batches.second ) {
+			DELETE( batch );
+		}
+	}
+	for ( auto& it : m_text_batches ) {
+		DELETE( it.second );
+	}
 
 }
 
@@ -162,6 +173,10 @@ void Scene::Draw( shader_program::ShaderProgram* shader_program, shader_program:
 	float last_zindex = -9999999;
 	std::string zindex_sequence = "";
 #endif
+	for ( auto& it : m_text_batches ) {
+		it.second->Clear();
+	}
+
 	for ( auto& actors : m_gl_actors_by_zindex ) {
 #ifdef DEBUG
 		float zindex = actors.first;
@@ -172,20 +187,160 @@ void Scene::Draw( shader_program::ShaderProgram* shader_program, shader_program:
 		last_zindex = zindex;
 #endif
 
+		m_batched_actors.clear();
+		if ( shader_program->GetType() == shader_program::ShaderProgram::TYPE_ORTHO ) {
+			CollectSpriteBatches( actors.first, actors.second );
+		}
+
+		size_t text_run = 0;
 		for ( auto& actor : actors.second ) {
 			if ( actor->GetActor()->IsVisible() ) {
-				// TODO: refactor
 				if ( actor->GetActor()->GetType() == scene::actor::Actor::TYPE_TEXT ) {
+					// TODO: refactor
 					ASSERT( other_shader_program, "text actor needs other_shader_program but it's null" );
-					actor->Draw( other_shader_program, m_scene->GetCamera() );
+					// sprites collected so far must be drawn below this text
+					DrawPendingSpriteBatches( shader_program );
+					AddTextToBatch( actors.first, text_run, (Text*)actor );
+					continue;
+				}
+				if ( !m_pending_text_batches.empty() ) {
+					// texts collected so far must be drawn below this actor
+					DrawPendingTextBatches( other_shader_program );
+					text_run++;
 				}
-				else {
-					actor->Draw( shader_program, m_scene->GetCamera() );
+				const auto it = m_batched_actors.find( actor );
+				if ( it != m_batched_actors.end() ) {
+					// whole batch is drawn when its run ends, together with other batches of same run
+					if ( it->second ) {
+						m_pending_sprite_batches.push_back( it->second );
+					}
+					continue;
 				}
+				DrawPendingSpriteBatches( shader_program );
+				actor->Draw( shader_program, m_scene->GetCamera() );
 			}
 		}
+		// only one of them can have anything pending here
+		DrawPendingSpriteBatches( shader_program );
+		DrawPendingTextBatches( other_shader_program );
 	}
 
+	// batches that had no texts this frame are no longer needed
+	for ( auto it = m_text_batches.begin() ; it != m_text_batches.end() ; ) {
+		if ( it->second->IsEmpty() ) {
+			DELETE( it->second );
+			it = m_text_batches.erase( it );
+		}
+		else {
+			it++;
+		}
+	}
+
+}
+
+void Scene::AddTextToBatch( const float zindex, const size_t run, Text* text ) {
+	const text_batch_key_t key = {
+		zindex,
+		run,
+		text->GetFont()
+	};
+	auto it = m_text_batches.find( key );
+	if ( it == m_text_batches.end() ) {
+		TextBatch* batch = nullptr;
+		NEW( batch, TextBatch, text->GetFont() );
+		it = m_text_batches.insert(
+			{
+				key,
+				batch
+			}
+		).first;
+	}
+	if ( it->second->IsEmpty() ) {
+		m_pending_text_batches.push_back( it->second );
+	}
+	it->second->AddText( text );
+}
+
+void Scene::DrawPendingTextBatches( shader_program::ShaderProgram* shader_program ) {
+	for ( auto& batch : m_pending_text_batches ) {
+		batch->Draw( (shader_program::Font*)shader_program );
+	}
+	m_pending_text_batches.clear();
+}
+
+void Scene::DrawPendingSpriteBatches( shader_program::ShaderProgram* shader_program ) {
+	for ( auto& batch : m_pending_sprite_batches ) {
+		batch->Draw( (shader_program::Orthographic*)shader_program, m_scene->GetCamera() );
+	}
+	m_pending_sprite_batches.clear();
+}
+
+void Scene::CollectSpriteBatches( const float zindex, const std::vector< Actor* >& actors ) {
+	for ( auto it = m_sprite_batches.lower_bound( { zindex, 0 } ) ; it != m_sprite_batches.end() && it->first.first == zindex ; it++ ) {
+		for ( auto& batch : it->second ) {
+			batch->Clear();
+		}
+	}
+
+	size_t run = 0;
+	bool is_run_started = false;
+	for ( auto& actor : actors ) {
+		if ( !actor->GetActor()->IsVisible() ) {
+			continue;
+		}
+		auto* sprite = (Sprite*)actor;
+		if ( actor->GetActor()->GetType() != scene::actor::Actor::TYPE_INSTANCED_SPRITE || !SpriteBatch::IsBatchable( sprite ) ) {
+			if ( is_run_started ) {
+				// sprites after this actor must be drawn above it, so they can't share batches with sprites before it
+				run++;
+				is_run_started = false;
+			}
+			continue;
+		}
+		is_run_started = true;
+		auto& batches = m_sprite_batches[ {
+			zindex,
+			run
+		} ];
+		SpriteBatch* batch = nullptr;
+		for ( auto& b : batches ) {
+			if ( b->Accepts( sprite ) ) {
+				batch = b;
+				break;
+			}
+		}
+		if ( !batch ) {
+			const auto* sprite_actor = ( (scene::actor::Instanced*)sprite->GetActor() )->GetSpriteActor();
+			NEW( batch, SpriteBatch, sprite_actor->GetTexture(), sprite_actor->GetDimensions(), sprite_actor->GetRenderFlags() );
+			batches.push_back( batch );
+		}
+		batch->AddSprite( sprite );
+		// even single sprites are drawn through batches, otherwise they would be drawn before batches of their run
+		m_batched_actors[ sprite ] = batch->GetSprites().size() == 1
+			? batch
+			: nullptr;
+	}
+
+	for ( auto it = m_sprite_batches.lower_bound( { zindex, 0 } ) ; it != m_sprite_batches.end() && it->first.first == zindex ; ) {
+		auto& batches = it->second;
+		for ( auto b = batches.begin() ; b != batches.end() ; ) {
+			auto* batch = *b;
+			if ( batch->GetSprites().empty() ) {
+				// no longer needed
+				DELETE( batch );
+				b = batches.erase( b );
+			}
+			else {
+				b++;
+			}
+		}
+		if ( batches.empty() ) {
+			it = m_sprite_batches.erase( it );
+		}
+		else {
+			it++;
+		}
+	}
 }
 
 void Scene::OnWindowResize() {
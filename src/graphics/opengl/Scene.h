@@ -2,6 +2,8 @@
 
 #include <vector>
 #include <map>
+#include <unordered_map>
+#include <tuple>
 
 #include "base/Base.h"
 #include "base/ObjectLink.h"
@@ -9,6 +11,8 @@
 #include "shader_program/ShaderProgram.h"
 #include "texture/Texture.h"
 #include "actor/Actor.h"
+#include "SpriteBatch.h"
+#include "TextBatch.h"
 
 namespace graphics {
 namespace opengl {
@@ -50,6 +54,22 @@ protected:
 	std::vector< base::ObjectLink* > m_gl_actors;
 	std::map< float, std::vector< Actor* > > m_gl_actors_by_zindex;
 
+	// consecutive instanced sprites of same zindex that share texture are drawn together, other actors between them split batches to keep drawing order
+	typedef std::pair< float, size_t > sprite_batch_key_t; // zindex, run within zindex
+	std::map< sprite_batch_key_t, std::vector< SpriteBatch* > > m_sprite_batches;
+	// batched actors of current zindex, first sprite of every batch points to it and others to nullptr
+	std::unordered_map< const Actor*, SpriteBatch* > m_batched_actors;
+	std::vector< SpriteBatch* > m_pending_sprite_batches;
+	void CollectSpriteBatches( const float zindex, const std::vector< Actor* >& actors );
+	void DrawPendingSpriteBatches( shader_program::ShaderProgram* shader_program );
+
+	// consecutive texts of same zindex that share font are drawn together, other actors between them split batches to keep drawing order
+	typedef std::tuple< float, size_t, const types::Font* > text_batch_key_t; // zindex, run within zindex, font
+	std::map< text_batch_key_t, TextBatch* > m_text_batches;
+	std::vector< TextBatch* > m_pending_text_batches;
+	void AddTextToBatch( const float zindex, const size_t run, Text* text );
+	void DrawPendingTextBatches( shader_program::ShaderProgram* shader_program );
+
 private:
 	void RemoveActor( base::ObjectLink* link );
 	void AddActorToZIndexSet( Actor* gl_actor );
@@ -0,0 +1,259 @@
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+
+#include "SpriteBatch.h"
+
+#include "engine/Engine.h"
+
+#include "types/mesh/Render.h"
+
+namespace graphics {
+namespace opengl {
+
+SpriteBatch::SpriteBatch( const types::Texture* texture, const scene::actor::Sprite::coords_t& dimensions, const scene::actor::Actor::render_flag_t render_flags )
+	: m_texture( texture )
+	, m_dimensions( dimensions )
+	, m_render_flags( render_flags ) {
+
+	glGenBuffers( 1, &m_vbo );
+	glGenBuffers( 1, &m_ibo );
+	glGenBuffers( 1, &m_instance_vbo );
+
+	// texture coordinates cover whole texture, they are narrowed down per instance
+	auto* mesh = types::mesh::Render::Rectangle(
+		m_dimensions.x, m_dimensions.y, {
+			{
+				0.0f,
+				0.0f
+			},
+			{
+				1.0f,
+				1.0f
+			}
+		}
+	);
+	mesh->UpdateAllNormals();
+
+	glBindBuffer( GL_ARRAY_BUFFER, m_vbo );
+	glBufferData( GL_ARRAY_BUFFER, mesh->GetVertexDataSize(), (GLvoid*)ptr( mesh->GetVertexData(), 0, mesh->GetVertexDataSize() ), GL_STATIC_DRAW );
+
+	glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, m_ibo );
+	glBufferData( GL_ELEMENT_ARRAY_BUFFER, mesh->GetIndexDataSize(), (GLvoid*)ptr( mesh->GetIndexData(), 0, mesh->GetIndexDataSize() ), GL_STATIC_DRAW );
+
+	m_ibo_size = mesh->GetIndexCount();
+
+	glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, 0 );
+	glBindBuffer( GL_ARRAY_BUFFER, 0 );
+
+	DELETE( mesh );
+}
+
+SpriteBatch::~SpriteBatch() {
+	glDeleteBuffers( 1, &m_instance_vbo );
+	glDeleteBuffers( 1, &m_ibo );
+	glDeleteBuffers( 1, &m_vbo );
+}
+
+const bool SpriteBatch::IsBatchable( const Sprite* sprite ) {
+	const auto* actor = sprite->GetActor();
+	if ( actor->GetType() != scene::actor::Actor::TYPE_INSTANCED_SPRITE ) {
+		return false;
+	}
+	const auto* sprite_actor = ( (scene::actor::Instanced*)actor )->GetSpriteActor();
+	return
+		sprite_actor->GetTexture() &&
+			!( sprite_actor->GetRenderFlags() & scene::actor::Actor::RF_USE_2D_POSITION );
+}
+
+const bool SpriteBatch::Accepts( const Sprite* sprite ) const {
+	const auto* sprite_actor = ( (scene::actor::Instanced*)sprite->GetActor() )->GetSpriteActor();
+	return
+		sprite_actor->GetTexture() == m_texture &&
+			sprite_actor->GetDimensions() == m_dimensions &&
+			sprite_actor->GetRenderFlags() == m_render_flags;
+}
+
+void SpriteBatch::Clear() {
+	m_sprites.clear();
+}
+
+void SpriteBatch::AddSprite( Sprite* sprite ) {
+	ASSERT( Accepts( sprite ), "sprite does not belong to this batch" );
+	m_sprites.push_back( sprite );
+}
+
+const std::vector< Sprite* >& SpriteBatch::GetSprites() const {
+	return m_sprites;
+}
+
+void SpriteBatch::Draw( shader_program::Orthographic* shader_program, scene::Camera* camera ) {
+	ASSERT( !m_sprites.empty(), "sprite batch is empty" );
+
+	// also updates visible instances of every sprite
+	const bool is_upload_needed = IsUploadNeeded();
+
+	glBindBuffer( GL_ARRAY_BUFFER, m_vbo );
+	glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, m_ibo );
+
+	shader_program->Enable();
+
+	g_engine->GetGraphics()->EnableTexture( m_texture );
+
+	glUniform1ui( shader_program->uniforms.flags, m_render_flags );
+
+	auto* lights = m_sprites.front()->GetActor()->GetScene()->GetLights();
+	if ( !lights->empty() ) {
+		Vec3 light_pos[lights->size()];
+		Color light_color[lights->size()];
+		size_t i = 0;
+		for ( auto& light : *lights ) {
+			light_pos[ i ] = light->GetPosition();
+			light_color[ i ] = light->GetColor();
+			i++;
+		}
+		glUniform3fv( shader_program->uniforms.light_pos, lights->size(), (const GLfloat*)light_pos );
+		glUniform4fv( shader_program->uniforms.light_color, lights->size(), (const GLfloat*)light_color );
+	}
+
+	glDisable( GL_DEPTH_TEST );
+
+	glUniformMatrix4fv( shader_program->uniforms.world, 1, GL_TRUE, (const GLfloat*)&camera->GetMatrix() );
+
+	const auto tex_rect_attribute = shader_program->attributes.instance_tex_rect;
+	glBindBuffer( GL_ARRAY_BUFFER, m_instance_vbo );
+	shader_program->EnableInstanceMatrixAttribute( shader_program->attributes.instance_matrix, sizeof( instance_t ), offsetof( instance_t, matrix ) );
+	glEnableVertexAttribArray( tex_rect_attribute );
+	glVertexAttribPointer( tex_rect_attribute, 4, GL_FLOAT, GL_FALSE, sizeof( instance_t ), (const GLvoid*)offsetof( instance_t, tex_rect ) );
+	glVertexAttribDivisor( tex_rect_attribute, 1 );
+	if ( is_upload_needed ) {
+		UploadInstances();
+	}
+	glBindBuffer( GL_ARRAY_BUFFER, m_vbo );
+
+	size_t culled_count = 0;
+	for ( auto& sprite : m_sprites ) {
+		culled_count += ( (scene::actor::Instanced*)sprite->GetActor() )->GetCulledInstancesCount();
+	}
+	STAT_CHANGE_BY( opengl_instances_drawn, m_instances.size() );
+	STAT_CHANGE_BY( opengl_instances_culled, culled_count );
+	if ( !m_instances.empty() ) {
+		STAT_INC( opengl_draw_calls );
+		glDrawElementsInstanced( GL_TRIANGLES, m_ibo_size, GL_UNSIGNED_INT, (void*)( 0 ), m_instances.size() );
+	}
+
+	glVertexAttribDivisor( tex_rect_attribute, 0 );
+	glDisableVertexAttribArray( tex_rect_attribute );
+	shader_program->ResetInstanceTexRect();
+	shader_program->DisableInstanceMatrixAttribute( shader_program->attributes.instance_matrix );
+
+	glEnable( GL_DEPTH_TEST );
+
+	g_engine->GetGraphics()->DisableTexture();
+
+	shader_program->Disable();
+
+	glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, 0 );
+	glBindBuffer( GL_ARRAY_BUFFER, 0 );
+}
+
+const bool SpriteBatch::IsUploadNeeded() {
+	bool is_upload_needed = m_uploaded_sprites.size() != m_sprites.size();
+	for ( size_t i = 0 ; i < m_sprites.size() ; i++ ) {
+		auto* instanced = (scene::actor::Instanced*)m_sprites[ i ]->GetActor();
+		const auto& matrices = instanced->GetInstanceMatrices();
+		if ( !is_upload_needed ) {
+			const auto& uploaded = m_uploaded_sprites[ i ];
+			is_upload_needed =
+				uploaded.actor != instanced ||
+					uploaded.update_counter != instanced->InstanceMatricesUpdatedCount() ||
+					uploaded.instances_count != matrices.size();
+		}
+	}
+	return is_upload_needed;
+}
+
+void SpriteBatch::UploadInstances() {
+	bool is_layout_changed = m_uploaded_sprites.size() != m_sprites.size();
+	for ( size_t i = 0 ; i < m_sprites.size() && !is_layout_changed ; i++ ) {
+		const auto& uploaded = m_uploaded_sprites[ i ];
+		auto* instanced = (scene::actor::Instanced*)m_sprites[ i ]->GetActor();
+		is_layout_changed =
+			uploaded.actor != instanced ||
+				uploaded.instances_count != instanced->GetInstanceMatrices().size();
+	}
+
+	if ( !is_layout_changed ) {
+		// same sprites at same offsets, only changed instances of changed sprites need to be uploaded
+		for ( size_t i = 0 ; i < m_sprites.size() ; i++ ) {
+			auto& uploaded = m_uploaded_sprites[ i ];
+			auto* instanced = (scene::actor::Instanced*)m_sprites[ i ]->GetActor();
+			if ( uploaded.update_counter == instanced->InstanceMatricesUpdatedCount() ) {
+				continue;
+			}
+			const auto& tc = instanced->GetSpriteActor()->GetTexCoords();
+			const auto& matrices = instanced->GetInstanceMatrices();
+			// dirty range of this sprite's part of buffer
+			size_t begin = matrices.size();
+			size_t end = 0;
+			for ( size_t j = 0 ; j < matrices.size() ; j++ ) {
+				const instance_t instance = {
+					matrices[ j ],
+					{
+						tc.first.x,
+						tc.first.y,
+						tc.second.x,
+						tc.second.y
+					}
+				};
+				auto& old_instance = m_instances[ uploaded.offset + j ];
+				if ( memcmp( &old_instance, &instance, sizeof( instance_t ) ) ) {
+					old_instance = instance;
+					begin = std::min( begin, j );
+					end = j + 1;
+				}
+			}
+			if ( begin < end ) {
+				glBufferSubData( GL_ARRAY_BUFFER, ( uploaded.offset + begin ) * sizeof( instance_t ), ( end - begin ) * sizeof( instance_t ), (const GLvoid*)( m_instances.data() + uploaded.offset + begin ) );
+			}
+			uploaded.update_counter = instanced->InstanceMatricesUpdatedCount();
+		}
+		return;
+	}
+
+	m_instances.clear();
+	m_uploaded_sprites.clear();
+	for ( auto& sprite : m_sprites ) {
+		auto* instanced = (scene::actor::Instanced*)sprite->GetActor();
+		const auto& tc = instanced->GetSpriteActor()->GetTexCoords();
+		const auto& matrices = instanced->GetInstanceMatrices();
+		m_uploaded_sprites.push_back(
+			{
+				instanced,
+				instanced->InstanceMatricesUpdatedCount(),
+				m_instances.size(),
+				matrices.size()
+			}
+		);
+		for ( const auto& matrix : matrices ) {
+			m_instances.push_back(
+				{
+					matrix,
+					{
+						tc.first.x,
+						tc.first.y,
+						tc.second.x,
+						tc.second.y
+					}
+				}
+			);
+		}
+	}
+	if ( !m_instances.empty() ) {
+		// previous storage gets orphaned so driver won't need to wait for pending draws
+		glBufferData( GL_ARRAY_BUFFER, m_instances.size() * sizeof( instance_t ), (const GLvoid*)m_instances.data(), GL_DYNAMIC_DRAW );
+	}
+}
+
+} /* namespace opengl */
+} /* namespace graphics */
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <vector>
+#include <GL/glew.h>
+
+#include "base/Base.h"
+
+#include "actor/Sprite.h"
+#include "shader_program/Orthographic.h"
+
+#include "scene/Camera.h"
+#include "scene/actor/Instanced.h"
+#include "types/Texture.h"
+#include "types/Matrix44.h"
+
+namespace graphics {
+namespace opengl {
+
+// draws instances of multiple instanced sprites that use same texture (atlas) with single instanced call
+// every instance has its own texture rectangle, so switching between sprites needs no texture rebinds
+CLASS( SpriteBatch, base::Base )
+
+	SpriteBatch( const types::Texture* texture, const scene::actor::Sprite::coords_t& dimensions, const scene::actor::Actor::render_flag_t render_flags );
+	~SpriteBatch();
+
+	// instanced sprites with same texture, dimensions and render flags can be batched, unless they use 2d position
+	static const bool IsBatchable( const Sprite* sprite );
+	const bool Accepts( const Sprite* sprite ) const;
+
+	// sprites are collected anew before every draw
+	void Clear();
+	void AddSprite( Sprite* sprite );
+	const std::vector< Sprite* >& GetSprites() const;
+
+	void Draw( shader_program::Orthographic* shader_program, scene::Camera* camera );
+
+private:
+	const types::Texture* m_texture;
+	const scene::actor::Sprite::coords_t m_dimensions;
+	const scene::actor::Actor::render_flag_t m_render_flags;
+
+	std::vector< Sprite* > m_sprites = {};
+
+	struct instance_t {
+		types::Matrix44 matrix;
+		GLfloat tex_rect[4];
+	};
+	std::vector< instance_t > m_instances = {};
+
+	// to detect when instances need to be collected and uploaded again
+	struct uploaded_sprite_t {
+		const scene::actor::Instanced* actor;
+		size_t update_counter;
+		size_t offset; // in instances
+		size_t instances_count;
+	};
+	std::vector< uploaded_sprite_t > m_uploaded_sprites = {};
+	const bool IsUploadNeeded();
+	void UploadInstances();
+
+	GLuint m_vbo = 0;
+	GLuint m_ibo = 0;
+	GLuint m_ibo_size = 0;
+	GLuint m_instance_vbo = 0;
+
+};
+
+} /* namespace opengl */
+} /* namespace graphics */
@@ -0,0 +1,133 @@
+#include "TextBatch.h"
+
+namespace graphics {
+namespace opengl {
+
+TextBatch::TextBatch( const types::Font* font )
+	: m_font( font ) {
+
+	glGenBuffers( 1, &m_vbo );
+	glGenBuffers( 1, &m_ibo );
+}
+
+TextBatch::~TextBatch() {
+	glDeleteBuffers( 1, &m_ibo );
+	glDeleteBuffers( 1, &m_vbo );
+}
+
+void TextBatch::Clear() {
+	m_texts.clear();
+}
+
+void TextBatch::AddText( Text* text ) {
+	ASSERT( text->GetFont() == m_font, "text font does not match batch font" );
+	m_texts.push_back( text );
+}
+
+const bool TextBatch::IsEmpty() const {
+	return m_texts.empty();
+}
+
+void TextBatch::Draw( shader_program::Font* shader_program ) {
+	ASSERT( !m_texts.empty(), "text batch is empty" );
+
+	for ( auto& text : m_texts ) {
+		text->UpdateVertices();
+	}
+
+	glBindBuffer( GL_ARRAY_BUFFER, m_vbo );
+	glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, m_ibo );
+
+	Upload();
+
+	if ( m_glyphs_count > 0 ) {
+
+		// all textures of same font are identical
+		glActiveTexture( GL_TEXTURE0 );
+		glBindTexture( GL_TEXTURE_2D, m_texts.front()->GetFontTexture()->m_texture );
+
+		shader_program->Enable();
+
+		glUniform1i( shader_program->uniforms.texture, 0 );
+
+		STAT_INC( opengl_draw_calls );
+		glDrawElements( GL_TRIANGLES, m_glyphs_count * 6, GL_UNSIGNED_INT, (void*)( 0 ) );
+
+		shader_program->Disable();
+
+		glBindTexture( GL_TEXTURE_2D, 0 );
+	}
+
+	glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, 0 );
+	glBindBuffer( GL_ARRAY_BUFFER, 0 );
+}
+
+void TextBatch::Upload() {
+	bool is_layout_changed = m_uploaded_texts.size() != m_texts.size();
+	for ( size_t i = 0 ; i < m_texts.size() && !is_layout_changed ; i++ ) {
+		const auto& uploaded = m_uploaded_texts[ i ];
+		is_layout_changed =
+			uploaded.text != m_texts[ i ] ||
+				uploaded.vertices_count != m_texts[ i ]->GetVertices().size();
+	}
+
+	if ( !is_layout_changed ) {
+		// same texts at same offsets, only changed ones need to be uploaded
+		for ( size_t i = 0 ; i < m_texts.size() ; i++ ) {
+			auto& uploaded = m_uploaded_texts[ i ];
+			const auto* text = m_texts[ i ];
+			if ( uploaded.update_counter != text->UpdatedCount() ) {
+				if ( uploaded.vertices_count > 0 ) {
+					glBufferSubData( GL_ARRAY_BUFFER, uploaded.offset * sizeof( Text::vertex_t ), uploaded.vertices_count * sizeof( Text::vertex_t ), (const GLvoid*)text->GetVertices().data() );
+				}
+				uploaded.update_counter = text->UpdatedCount();
+			}
+		}
+		return;
+	}
+
+	m_uploaded_texts.clear();
+	m_vertices.clear();
+	for ( const auto& text : m_texts ) {
+		const auto& vertices = text->GetVertices();
+		m_uploaded_texts.push_back(
+			{
+				text,
+				text->UpdatedCount(),
+				m_vertices.size(),
+				vertices.size()
+			}
+		);
+		m_vertices.insert( m_vertices.end(), vertices.begin(), vertices.end() );
+	}
+	m_glyphs_count = m_vertices.size() / 4;
+	if ( !m_glyphs_count ) {
+		return;
+	}
+
+	// previous storage gets orphaned so driver won't need to wait for pending draws
+	glBufferData( GL_ARRAY_BUFFER, m_vertices.size() * sizeof( Text::vertex_t ), (const GLvoid*)m_vertices.data(), GL_DYNAMIC_DRAW );
+
+	if ( m_indexed_glyphs_count != m_glyphs_count ) {
+		// two triangles per glyph, vertices are in triangle strip order
+		std::vector< GLuint > indices = {};
+		indices.reserve( m_glyphs_count * 6 );
+		for ( GLuint i = 0 ; i < m_glyphs_count * 4 ; i += 4 ) {
+			indices.insert(
+				indices.end(), {
+					i,
+					i + 1,
+					i + 2,
+					i + 2,
+					i + 1,
+					i + 3
+				}
+			);
+		}
+		glBufferData( GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof( GLuint ), (const GLvoid*)indices.data(), GL_STATIC_DRAW );
+		m_indexed_glyphs_count = m_glyphs_count;
+	}
+}
+
+} /* namespace opengl */
+} /* namespace graphics */
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <vector>
+#include <GL/glew.h>
+
+#include "base/Base.h"
+
+#include "actor/Text.h"
+#include "shader_program/Font.h"
+
+#include "types/Font.h"
+
+namespace graphics {
+namespace opengl {
+
+// draws multiple texts with same font using single vertex buffer and single indexed call
+// vertices are reuploaded only for texts that changed, unless set of texts or their lengths changed
+CLASS( TextBatch, base::Base )
+
+	TextBatch( const types::Font* font );
+	~TextBatch();
+
+	// texts are collected anew before every draw
+	void Clear();
+	void AddText( Text* text );
+	const bool IsEmpty() const;
+
+	void Draw( shader_program::Font* shader_program );
+
+private:
+	const types::Font* m_font;
+
+	std::vector< Text* > m_texts = {};
+
+	struct uploaded_text_t {
+		const Text* text;
+		size_t update_counter;
+		size_t offset; // in vertices
+		size_t vertices_count;
+	};
+	std::vector< uploaded_text_t > m_uploaded_texts = {};
+	std::vector< Text::vertex_t > m_vertices = {};
+	void Upload();
+
+	GLuint m_vbo = 0;
+	GLuint m_ibo = 0;
+	size_t m_glyphs_count = 0;
+	size_t m_indexed_glyphs_count = 0;
+
+};
+
+} /* namespace opengl */
+} /* namespace graphics */
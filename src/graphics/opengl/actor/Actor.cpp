@@ -8,6 +8,11 @@ namespace opengl {
 Actor::Actor( scene::actor::Actor* actor )
 	: m_actor( actor ) {
 	m_name = actor->GetLocalName();
+
+	const auto type = actor->GetType();
+	if ( type == scene::actor::Actor::TYPE_INSTANCED_SPRITE || type == scene::actor::Actor::TYPE_INSTANCED_MESH ) {
+		glGenBuffers( 1, &m_instance_vbo );
+	}
 }
 
 const float Actor::GetZIndex() const {
@@ -19,7 +24,56 @@ void Actor::SetZIndex( const float z_index ) {
 }
 
 Actor::~Actor() {
+	if ( m_instance_vbo ) {
+		glDeleteBuffers( 1, &m_instance_vbo );
+	}
+}
+
+const size_t Actor::LoadInstanceMatrices( scene::actor::Instanced* instanced ) {
+	ASSERT( m_instance_vbo, "instance buffer not created" );
+
+	const auto& matrices = instanced->GetInstanceMatrices();
+	const size_t update_counter = instanced->InstanceMatricesUpdatedCount();
+	if ( m_is_instance_vbo_valid && m_instance_matrices_update_counter == update_counter ) {
+		return matrices.size(); // nothing changed since last upload
+	}
+	m_instance_matrices_update_counter = update_counter;
+	instanced->TakeUpdatedInstanceRanges( &m_updated_instance_ranges );
+
+	const size_t unit_size = sizeof( types::Matrix44 );
+	const size_t data_size = matrices.size() * unit_size;
+	if ( !data_size ) {
+		return 0;
+	}
+
+	if ( m_is_instance_vbo_valid && m_instance_vbo_data_size == data_size ) {
+		size_t changed_size = 0;
+		for ( const auto& range : m_updated_instance_ranges ) {
+			changed_size += ( range.end - range.begin ) * unit_size;
+		}
+		if ( changed_size <= data_size / 2 ) {
+			// partial upload
+			for ( const auto& range : m_updated_instance_ranges ) {
+				glBufferSubData( GL_ARRAY_BUFFER, range.begin * unit_size, ( range.end - range.begin ) * unit_size, (const GLvoid*)( matrices.data() + range.begin ) );
+			}
+			return matrices.size();
+		}
+	}
+
+	// full upload, previous storage gets orphaned so driver won't need to wait for pending draws
+	glBufferData( GL_ARRAY_BUFFER, data_size, (const GLvoid*)matrices.data(), GL_DYNAMIC_DRAW );
+	m_instance_vbo_data_size = data_size;
+	m_is_instance_vbo_valid = true;
+	return matrices.size();
+}
+
+void Actor::LoadCustomInstanceMatrices( const scene::actor::Instanced::matrices_t& matrices ) {
+	ASSERT( m_instance_vbo, "instance buffer not created" );
 
+	if ( !matrices.empty() ) {
+		glBufferData( GL_ARRAY_BUFFER, matrices.size() * sizeof( types::Matrix44 ), (const GLvoid*)matrices.data(), GL_STREAM_DRAW );
+		m_is_instance_vbo_valid = false;
+	}
 }
 
 } /* namespace opengl */
@@ -3,6 +3,7 @@
 #include "base/Base.h"
 
 #include "scene/actor/Actor.h"
+#include "scene/actor/Instanced.h"
 #include "scene/Camera.h"
 #include "../shader_program/ShaderProgram.h"
 
@@ -43,6 +44,20 @@ protected:
 
 	float m_z_index = 0.0f;
 
+	// matrices of instanced actors are kept in buffer between frames, to be used as per-instance attribute
+	GLuint m_instance_vbo = 0;
+	// uploads instance matrices (only changed ranges if possible), instance buffer must be bound before call
+	// returns number of instances
+	const size_t LoadInstanceMatrices( scene::actor::Instanced* instanced );
+	// uploads one-off matrices (i.e. for captures), cached ones will be fully reuploaded on next LoadInstanceMatrices()
+	void LoadCustomInstanceMatrices( const scene::actor::Instanced::matrices_t& matrices );
+
+private:
+	size_t m_instance_vbo_data_size = 0;
+	bool m_is_instance_vbo_valid = false;
+	size_t m_instance_matrices_update_counter = 0;
+	types::mesh::Mesh::updated_ranges_t m_updated_instance_ranges = {};
+
 };
 
 } /* namespace opengl */
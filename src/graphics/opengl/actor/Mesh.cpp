@@ -99,14 +99,16 @@ void Mesh::LoadMesh() {
 
 	//Log( "Loading mesh" );
 
-	const auto* mesh = GetMeshActor()->GetMesh();
+	auto* mesh = GetMeshActor()->GetMesh();
 	ASSERT( mesh, "actor mesh not set" );
 
+	mesh->TakeUpdatedRanges( &m_updated_vertex_ranges, &m_updated_index_ranges );
+
 	glBindBuffer( GL_ARRAY_BUFFER, m_vbo );
-	glBufferData( GL_ARRAY_BUFFER, mesh->GetVertexDataSize(), (GLvoid*)ptr( mesh->GetVertexData(), 0, mesh->GetVertexDataSize() ), GL_STATIC_DRAW );
+	LoadBuffer( GL_ARRAY_BUFFER, &m_vbo_data_size, mesh->GetVertexData(), mesh->GetVertexDataSize(), m_updated_vertex_ranges, mesh->VERTEX_SIZE * sizeof( types::mesh::Mesh::coord_t ) );
 
 	glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, m_ibo );
-	glBufferData( GL_ELEMENT_ARRAY_BUFFER, mesh->GetIndexDataSize(), (GLvoid*)ptr( mesh->GetIndexData(), 0, mesh->GetIndexDataSize() ), GL_STATIC_DRAW );
+	LoadBuffer( GL_ELEMENT_ARRAY_BUFFER, &m_ibo_data_size, mesh->GetIndexData(), mesh->GetIndexDataSize(), m_updated_index_ranges, sizeof( types::mesh::Mesh::index_t ) );
 
 	m_ibo_size = mesh->GetIndexCount();
 
@@ -115,6 +117,36 @@ void Mesh::LoadMesh() {
 
 }
 
+void Mesh::LoadBuffer( const GLenum target, size_t* buffer_size, const uint8_t* data, const size_t data_size, const types::mesh::Mesh::updated_ranges_t& ranges, const size_t range_unit_size ) {
+	if ( !data_size ) {
+		return;
+	}
+
+	if ( *buffer_size == data_size ) {
+		size_t changed_size = 0;
+		for ( const auto& range : ranges ) {
+			changed_size += ( range.end - range.begin ) * range_unit_size;
+		}
+		if ( !changed_size ) {
+			return; // nothing to do
+		}
+		if ( changed_size <= data_size / 2 ) {
+			// partial upload
+			size_t offset, size;
+			for ( const auto& range : ranges ) {
+				offset = range.begin * range_unit_size;
+				size = ( range.end - range.begin ) * range_unit_size;
+				glBufferSubData( target, offset, size, (GLvoid*)ptr( data, offset, size ) );
+			}
+			return;
+		}
+	}
+
+	// full upload, previous storage gets orphaned so driver won't need to wait for pending draws
+	glBufferData( target, data_size, (GLvoid*)ptr( data, 0, data_size ), GL_STATIC_DRAW );
+	*buffer_size = data_size;
+}
+
 void Mesh::LoadTexture() {
 	auto* texture = GetMeshActor()->GetTexture();
 
@@ -142,7 +174,7 @@ scene::actor::Mesh* Mesh::GetMeshActor() const {
 }
 
 void Mesh::PrepareDataMesh() {
-	const auto* data_mesh = GetMeshActor()->GetDataMesh();
+	auto* data_mesh = GetMeshActor()->GetDataMesh();
 	if ( data_mesh && !m_data.is_up_to_date ) {
 		if ( !m_data.is_allocated ) {
 
@@ -161,12 +193,14 @@ void Mesh::PrepareDataMesh() {
 
 		glBindFramebuffer( GL_FRAMEBUFFER, m_data.fbo );
 
+		data_mesh->TakeUpdatedRanges( &m_updated_vertex_ranges, &m_updated_index_ranges );
+
 		glBindBuffer( GL_ARRAY_BUFFER, m_data.vbo );
-		glBufferData( GL_ARRAY_BUFFER, data_mesh->GetVertexDataSize(), (GLvoid*)ptr( data_mesh->GetVertexData(), 0, data_mesh->GetVertexDataSize() ), GL_STATIC_DRAW );
+		LoadBuffer( GL_ARRAY_BUFFER, &m_data.vbo_data_size, data_mesh->GetVertexData(), data_mesh->GetVertexDataSize(), m_updated_vertex_ranges, data_mesh->VERTEX_SIZE * sizeof( types::mesh::Mesh::coord_t ) );
 		glBindBuffer( GL_ARRAY_BUFFER, 0 );
 
 		glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, m_data.ibo );
-		glBufferData( GL_ELEMENT_ARRAY_BUFFER, data_mesh->GetIndexDataSize(), (GLvoid*)ptr( data_mesh->GetIndexData(), 0, data_mesh->GetIndexDataSize() ), GL_STATIC_DRAW );
+		LoadBuffer( GL_ELEMENT_ARRAY_BUFFER, &m_data.ibo_data_size, data_mesh->GetIndexData(), data_mesh->GetIndexDataSize(), m_updated_index_ranges, sizeof( types::mesh::Mesh::index_t ) );
 		glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, 0 );
 
 		size_t w = g_engine->GetGraphics()->GetViewportWidth();
@@ -178,6 +212,7 @@ void Mesh::PrepareDataMesh() {
 			glGenTextures( 1, &m_data.picking_texture );
 		}
 		glBindTexture( GL_TEXTURE_2D, m_data.picking_texture );
+		STAT_INC( opengl_textures_updates );
 		glTexImage2D( GL_TEXTURE_2D, 0, GL_R32UI, w, h, 0, GL_RED_INTEGER, GL_UNSIGNED_INT, NULL );
 		glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
 		glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
@@ -188,6 +223,7 @@ void Mesh::PrepareDataMesh() {
 			glGenTextures( 1, &m_data.depth_texture );
 		}
 		glBindTexture( GL_TEXTURE_2D, m_data.depth_texture );
+		STAT_INC( opengl_textures_updates );
 		glTexImage2D( GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT, w, h, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL );
 		glBindTexture( GL_TEXTURE_2D, 0 );
 		glFramebufferTexture2D( GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, m_data.depth_texture, 0 );
@@ -269,6 +305,7 @@ void Mesh::Draw( shader_program::ShaderProgram* shader_program, Camera* camera )
 			if ( flags & actor::Actor::RF_USE_2D_POSITION ) {
 				glUniform2fv( sp->uniforms.position, 1, (const GLfloat*)&mesh_actor->GetPosition() );
 			}
+			STAT_INC( opengl_draw_calls );
 			glDrawElements( GL_TRIANGLES, m_ibo_size, GL_UNSIGNED_INT, (void*)( 0 ) );
 			break;
 		}
@@ -340,43 +377,48 @@ void Mesh::Draw( shader_program::ShaderProgram* shader_program, Camera* camera )
 					)
 				);
 			}
+			const GLuint instance_matrix_attribute = shader_program->GetType() == shader_program::ShaderProgram::TYPE_ORTHO_DATA
+				? sp_data->attributes.instance_matrix
+				: sp->attributes.instance_matrix;
 			if ( ignore_camera || m_actor->GetType() == scene::Actor::TYPE_MESH ) {
-				types::Matrix44 matrix;
 				ASSERT( !capture_request, "non-instanced captures not implemented" );
-				if ( ignore_camera ) {
-					matrix = g_engine->GetUI()->GetWorldUIMatrix();
-				}
-				else {
-					matrix = m_actor->GetWorldMatrix();
-				}
-				glUniformMatrix4fv(
-					shader_program->GetType() == shader_program::ShaderProgram::TYPE_ORTHO_DATA
-						? sp_data->uniforms.instances
-						: sp->uniforms.instances, 1, GL_TRUE, (const GLfloat*)( &matrix )
+				shader_program->SetInstanceMatrixAttribute(
+					instance_matrix_attribute, ignore_camera
+						? g_engine->GetUI()->GetWorldUIMatrix()
+						: m_actor->GetWorldMatrix()
 				);
+				STAT_INC( opengl_draw_calls );
 				glDrawElements( GL_TRIANGLES, ibo_size, GL_UNSIGNED_INT, (void*)( 0 ) );
 			}
 			else if ( m_actor->GetType() == scene::Actor::TYPE_INSTANCED_MESH ) {
 				auto* instanced = (scene::actor::Instanced*)m_actor;
-				scene::actor::Instanced::matrices_t matrices;
+				glBindBuffer( GL_ARRAY_BUFFER, m_instance_vbo );
+				shader_program->EnableInstanceMatrixAttribute( instance_matrix_attribute );
+				// instance matrices are cached by actor and in instance buffer, only captures need to generate their own
+				size_t instances_count;
+				size_t culled_count;
 				if ( capture_request ) {
-					instanced->GenerateInstanceMatrices( &matrices, capture_request->camera );
+					scene::actor::Instanced::matrices_t capture_matrices;
+					instanced->GenerateInstanceMatrices( &capture_matrices, capture_request->camera, &culled_count );
+					LoadCustomInstanceMatrices( capture_matrices );
+					instances_count = capture_matrices.size();
 				}
 				else {
-					matrices = instanced->GetInstanceMatrices();
+					instances_count = LoadInstanceMatrices( instanced );
+					culled_count = instanced->GetCulledInstancesCount();
 				}
-				const auto sz = matrices.size();
-				GLsizei i = 0;
-				GLsizei c;
-				for ( auto i = 0 ; i < sz ; i += OpenGL::MAX_INSTANCES ) {
-					c = std::min< size_t >( OpenGL::MAX_INSTANCES, sz - i );
-					glUniformMatrix4fv(
-						shader_program->GetType() == shader_program::ShaderProgram::TYPE_ORTHO_DATA
-							? sp_data->uniforms.instances
-							: sp->uniforms.instances, c, GL_TRUE, (const GLfloat*)( matrices.data() + i )
-					);
-					glDrawElementsInstanced( GL_TRIANGLES, ibo_size, GL_UNSIGNED_INT, (void*)( 0 ), c );
+				glBindBuffer(
+					GL_ARRAY_BUFFER, shader_program->GetType() == shader_program::ShaderProgram::TYPE_ORTHO_DATA
+						? m_data.vbo
+						: m_vbo
+				);
+				STAT_CHANGE_BY( opengl_instances_drawn, instances_count );
+				STAT_CHANGE_BY( opengl_instances_culled, culled_count );
+				if ( instances_count ) {
+					STAT_INC( opengl_draw_calls );
+					glDrawElementsInstanced( GL_TRIANGLES, ibo_size, GL_UNSIGNED_INT, (void*)( 0 ), instances_count );
 				}
+				shader_program->DisableInstanceMatrixAttribute( instance_matrix_attribute );
 			}
 			else {
 				ASSERT( false, "unknown actor type " + std::to_string( m_actor->GetType() ) );
@@ -29,13 +29,21 @@ protected:
 
 	void PrepareDataMesh();
 
+	// uploads only changed ranges if buffer is already allocated with same size, whole buffer otherwise
+	// buffer must be bound to target before call
+	void LoadBuffer( const GLenum target, size_t* buffer_size, const uint8_t* data, const size_t data_size, const types::mesh::Mesh::updated_ranges_t& ranges, const size_t range_unit_size );
+	types::mesh::Mesh::updated_ranges_t m_updated_vertex_ranges = {};
+	types::mesh::Mesh::updated_ranges_t m_updated_index_ranges = {};
+
 	size_t m_mesh_update_counter = 0;
 	size_t m_data_mesh_update_counter = 0;
 	const types::Texture* m_last_texture = nullptr;
 	size_t m_last_texture_update_counter = 0;
 
 	GLuint m_vbo = 0;
+	size_t m_vbo_data_size = 0;
 	GLuint m_ibo = 0;
+	size_t m_ibo_data_size = 0;
 	GLuint m_ibo_size = 0;
 
 	struct {
@@ -44,7 +52,9 @@ protected:
 		GLuint picking_texture = 0;
 		GLuint depth_texture = 0;
 		GLuint vbo = 0;
+		size_t vbo_data_size = 0;
 		GLuint ibo = 0;
+		size_t ibo_data_size = 0;
 		GLuint ibo_size = 0;
 		bool is_up_to_date = false; // reset on window resize or other events when it needs to be reloaded
 	} m_data = {};
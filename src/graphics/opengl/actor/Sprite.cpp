@@ -148,21 +148,23 @@ void Sprite::Draw( shader_program::ShaderProgram* shader_program, Camera* camera
 			glUniformMatrix4fv( sp->uniforms.world, 1, GL_TRUE, (const GLfloat*)&camera->GetMatrix() );
 
 			if ( m_actor->GetType() == scene::Actor::TYPE_SPRITE ) {
-				types::Matrix44 matrix = m_actor->GetWorldMatrix();
-				glUniformMatrix4fv( sp->uniforms.instances, 1, GL_TRUE, (const GLfloat*)( &matrix ) );
+				sp->SetInstanceMatrixAttribute( sp->attributes.instance_matrix, m_actor->GetWorldMatrix() );
+				STAT_INC( opengl_draw_calls );
 				glDrawElements( GL_TRIANGLES, m_ibo_size, GL_UNSIGNED_INT, (void*)( 0 ) );
 			}
 			else if ( m_actor->GetType() == scene::Actor::TYPE_INSTANCED_SPRITE ) {
 				auto* instanced = (scene::actor::Instanced*)m_actor;
-				auto& matrices = instanced->GetInstanceMatrices();
-				const auto sz = matrices.size();
-				GLsizei i = 0;
-				GLsizei c;
-				for ( auto i = 0 ; i < sz ; i += OpenGL::MAX_INSTANCES ) {
-					c = std::min< size_t >( OpenGL::MAX_INSTANCES, sz - i );
-					glUniformMatrix4fv( sp->uniforms.instances, c, GL_TRUE, (const GLfloat*)( matrices.data() + i ) );
-					glDrawElementsInstanced( GL_TRIANGLES, m_ibo_size, GL_UNSIGNED_INT, (void*)( 0 ), c );
+				glBindBuffer( GL_ARRAY_BUFFER, m_instance_vbo );
+				sp->EnableInstanceMatrixAttribute( sp->attributes.instance_matrix );
+				const auto instances_count = LoadInstanceMatrices( instanced );
+				glBindBuffer( GL_ARRAY_BUFFER, m_vbo );
+				STAT_CHANGE_BY( opengl_instances_drawn, instances_count );
+				STAT_CHANGE_BY( opengl_instances_culled, instanced->GetCulledInstancesCount() );
+				if ( instances_count ) {
+					STAT_INC( opengl_draw_calls );
+					glDrawElementsInstanced( GL_TRIANGLES, m_ibo_size, GL_UNSIGNED_INT, (void*)( 0 ), instances_count );
 				}
+				sp->DisableInstanceMatrixAttribute( sp->attributes.instance_matrix );
 			}
 			else {
 				ASSERT( false, "unknown actor type " + std::to_string( m_actor->GetType() ) );
@@ -1,3 +1,6 @@
+#include <cstring>
+#include <atomic>
+
 #include "Text.h"
 
 #include "engine/Engine.h"
@@ -7,11 +10,13 @@ using namespace types;
 namespace graphics {
 namespace opengl {
 
+// shared by all texts, see UpdatedCount()
+static std::atomic< size_t > s_update_counter = 0;
+
 Text::Text( scene::actor::Text* actor, Font* font )
 	: Actor( actor )
 	, m_font( font ) {
 	//Log( "Creating OpenGL text '" + actor->GetText() + "' with font " + font->m_name );
-	glGenBuffers( 1, &m_vbo );
 	auto* text_actor = (const scene::actor::Text*)m_actor;
 	auto position = m_actor->GetPosition();
 	Update( m_font, text_actor->GetText(), position.x, position.y );
@@ -19,7 +24,6 @@ Text::Text( scene::actor::Text* actor, Font* font )
 
 Text::~Text() {
 	//Log( "Destroying OpenGL text" );
-	glDeleteBuffers( 1, &m_vbo );
 	if ( m_texture ) {
 		DELETE( m_texture );
 	}
@@ -40,6 +44,10 @@ void Text::Update( Font* font, const std::string& text, const float x, const flo
 		if ( m_font != font ) {
 			//Log( "Changing font from " + m_font->m_name + " to " + font->m_name );
 			m_font = font;
+			if ( m_texture ) {
+				DELETE( m_texture );
+				m_texture = nullptr;
+			}
 		}
 		if ( m_text != text ) {
 			//Log( "Changing text from " + m_text + " to " + text );
@@ -51,6 +59,8 @@ void Text::Update( Font* font, const std::string& text, const float x, const flo
 			m_last_window_size = window_size;
 		}
 
+		m_boxes.clear();
+
 		if ( m_font ) {
 
 			if ( !m_texture ) {
@@ -60,12 +70,6 @@ void Text::Update( Font* font, const std::string& text, const float x, const flo
 			const float sx = 2.0 / g_engine->GetGraphics()->GetViewportWidth();
 			const float sy = 2.0 / g_engine->GetGraphics()->GetViewportHeight();
 
-			std::vector< vertex_box_t > boxes = {};
-
-			for ( int sym = 32 ; sym < 128 ; sym++ ) {
-				boxes.clear();
-			}
-
 			float cx = 0;
 			float cy = 0;
 
@@ -85,33 +89,25 @@ void Text::Update( Font* font, const std::string& text, const float x, const flo
 				float w = bitmap->width * sx;
 				float h = bitmap->height * sy;
 
-				float tbx1 = m_texture->m_tx[ sym ];
-				float tby1 = m_texture->m_ty[ sym ];
-				float tbx2 = m_texture->m_tx[ sym ] + bitmap->width / m_font->m_dimensions.width;
-				float tby2 = m_texture->m_ty[ sym ] + bitmap->height / m_font->m_dimensions.height;
-
-				boxes.push_back(
+				m_boxes.push_back(
 					{
-						{ x2,     -y2,     tbx1, tby1 },
-						{ x2 + w, -y2,     tbx2, tby1 },
-						{ x2,     -y2 - h, tbx1, tby2 },
-						{ x2 + w, -y2 - h, tbx2, tby2 },
+						x2,
+						-y2,
+						x2 + w,
+						-y2 - h,
+						m_texture->m_tx[ sym ],
+						m_texture->m_ty[ sym ],
+						m_texture->m_tx[ sym ] + bitmap->width / m_font->m_dimensions.width,
+						m_texture->m_ty[ sym ] + bitmap->height / m_font->m_dimensions.height
 					}
 				);
 
 				cx += bitmap->ax * sx;
 				cy += bitmap->ay * sy;
 			}
-
-			glBindBuffer( GL_ARRAY_BUFFER, m_vbo );
-			m_boxes_count = boxes.size();
-
-			if ( !boxes.empty() ) {
-				glBufferData( GL_ARRAY_BUFFER, sizeof( vertex_box_t ) * boxes.size(), boxes.data(), GL_STATIC_DRAW );
-			}
-
-			glBindBuffer( GL_ARRAY_BUFFER, 0 );
 		}
+
+		m_need_vertices_update = true;
 	}
 
 	if ( m_coords.x != x || m_coords.y != y ) {
@@ -120,51 +116,97 @@ void Text::Update( Font* font, const std::string& text, const float x, const flo
 			x,
 			y
 		};
+		m_need_vertices_update = true;
 	}
 }
 
 void Text::Draw( shader_program::ShaderProgram* shader_program, Camera* camera ) {
-	if ( m_boxes_count > 0 ) {
-		auto* sp = (shader_program::Font*)shader_program;
-
-		auto* text_actor = (const scene::actor::Text*)m_actor;
+	ASSERT( false, "text actors are drawn by TextBatch" );
+}
 
-		glBindBuffer( GL_ARRAY_BUFFER, m_vbo );
+void Text::UpdateVertices() {
+	auto* text_actor = (const scene::actor::Text*)m_actor;
 
-		glActiveTexture( GL_TEXTURE0 );
-		glBindTexture( GL_TEXTURE_2D, m_texture->m_texture );
+	const auto flags = text_actor->GetRenderFlags();
+	const auto& color = text_actor->GetColor();
+	const float z_index = text_actor->GetPosition().z;
+
+	if (
+		!m_need_vertices_update &&
+			!memcmp( &m_last_properties.color, &color.value, sizeof( color.value ) ) &&
+			m_last_properties.render_flags == flags &&
+			m_last_properties.z_index == z_index &&
+			(
+				!( flags & actor::Actor::RF_USE_AREA_LIMITS ) ||
+					m_last_properties.area_limits == text_actor->GetAreaLimits()
+			)
+		) {
+		return; // nothing changed
+	}
 
-		sp->Enable();
+	m_last_properties.color = color;
+	m_last_properties.render_flags = flags;
+	m_last_properties.z_index = z_index;
 
-		auto flags = text_actor->GetRenderFlags();
+	// texts without area limits get ones that can't be reached (note that y is inverted)
+	GLfloat area_limits[4] = {
+		-1.0e9f,
+		1.0e9f,
+		1.0e9f,
+		-1.0e9f
+	};
+	if ( flags & actor::Actor::RF_USE_AREA_LIMITS ) {
+		const auto& limits = text_actor->GetAreaLimits();
+		m_last_properties.area_limits = limits;
+		area_limits[ 0 ] = limits.first.x;
+		area_limits[ 1 ] = limits.first.y;
+		area_limits[ 2 ] = limits.second.x;
+		area_limits[ 3 ] = limits.second.y;
+	}
 
-		glUniform1ui( sp->uniforms.flags, flags );
-		if ( flags & actor::Actor::RF_USE_AREA_LIMITS ) {
-			const auto& limits = text_actor->GetAreaLimits();
-			glUniform3fv( sp->uniforms.area_limits.min, 1, (const GLfloat*)&limits.first );
-			glUniform3fv( sp->uniforms.area_limits.max, 1, (const GLfloat*)&limits.second );
-		}
+	Vec2< float > offset = {
+		0.0f,
+		0.0f
+	};
+	if ( flags & actor::Actor::RF_USE_2D_POSITION ) {
+		offset = m_coords;
+	}
 
-		if ( flags & actor::Actor::RF_USE_2D_POSITION ) {
-			glUniform2fv( sp->uniforms.position, 1, (const GLfloat*)&m_coords );
+	m_vertices.clear();
+	m_vertices.reserve( m_boxes.size() * 4 );
+	vertex_t v = {};
+	v.color = color;
+	memcpy( v.area_limits, area_limits, sizeof( area_limits ) );
+	v.z_index = z_index;
+	for ( const auto& box : m_boxes ) {
+		// same order as triangle strip: top left, top right, bottom left, bottom right
+		for ( uint8_t i = 0 ; i < 4 ; i++ ) {
+			v.x = offset.x + ( i & 1 ? box.x2 : box.x1 );
+			v.y = offset.y + ( i & 2 ? box.y2 : box.y1 );
+			v.tx = i & 1 ? box.tx2 : box.tx1;
+			v.ty = i & 2 ? box.ty2 : box.ty1;
+			m_vertices.push_back( v );
 		}
+	}
 
-		glUniform1i( sp->uniforms.texture, 0 );
-		glUniform4fv( sp->uniforms.color, 1, (const GLfloat*)&text_actor->GetColor() );
-		auto position = m_actor->GetPosition();
-		glUniform1f( sp->uniforms.z_index, position.z );
-
-		for ( size_t c = 0 ; c < m_boxes_count ; c++ ) {
-			glDrawArrays( GL_TRIANGLE_STRIP, c * 4, 4 );
-		}
+	m_need_vertices_update = false;
+	m_update_counter = ++s_update_counter;
+}
 
-		sp->Disable();
+const std::vector< Text::vertex_t >& Text::GetVertices() const {
+	return m_vertices;
+}
 
-		glBindTexture( GL_TEXTURE_2D, 0 );
+const size_t Text::UpdatedCount() const {
+	return m_update_counter;
+}
 
-		glBindBuffer( GL_ARRAY_BUFFER, 0 );
-	}
+Font* Text::GetFont() const {
+	return m_font;
+}
 
+const FontTexture* Text::GetFontTexture() const {
+	return m_texture;
 }
 
 } /* namespace opengl */
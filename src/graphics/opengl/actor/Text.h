@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 #include "Actor.h"
 
 #include "scene/actor/Text.h"
@@ -20,28 +22,58 @@ CLASS( Text, Actor )
 	void Update( Font* font, const std::string& text, const float x, const float y );
 	void Draw( shader_program::ShaderProgram* shader_program, Camera* camera = nullptr ) override;
 
-protected:
-
+	// everything that used to be uniforms is stored per vertex, so that texts with same font can be drawn together (see TextBatch)
 	struct vertex_t {
 		GLfloat x;
 		GLfloat y;
 		GLfloat tx;
 		GLfloat ty;
+		Color::color_t color;
+		GLfloat area_limits[4]; // min x, min y, max x, max y
+		GLfloat z_index;
 	};
-	struct vertex_box_t {
-		vertex_t v1;
-		vertex_t v2;
-		vertex_t v3;
-		vertex_t v4;
+
+	// rebuilds vertices if text or any of its render properties changed since last call
+	void UpdateVertices();
+	const std::vector< vertex_t >& GetVertices() const;
+	// changed every time vertices change, taken from global counter so that two texts never have same value
+	// (new text can be allocated at address of deleted one, with same length)
+	const size_t UpdatedCount() const;
+
+	Font* GetFont() const;
+	const FontTexture* GetFontTexture() const;
+
+protected:
+
+	struct glyph_box_t {
+		GLfloat x1;
+		GLfloat y1;
+		GLfloat x2;
+		GLfloat y2;
+		GLfloat tx1;
+		GLfloat ty1;
+		GLfloat tx2;
+		GLfloat ty2;
 	};
+	std::vector< glyph_box_t > m_boxes = {};
+	bool m_need_vertices_update = true;
+
+	std::vector< vertex_t > m_vertices = {};
+	size_t m_update_counter = 0;
+
+	// render properties that are baked into vertices
+	struct {
+		Color::color_t color;
+		actor::Actor::render_flag_t render_flags;
+		actor::Actor::area_limits_t area_limits;
+		float z_index;
+	} m_last_properties = {};
+
 	Vec2< float > m_coords = {
 		0,
 		0
 	};
 
-	GLuint m_vbo = 0;
-	size_t m_boxes_count = 0;
-
 	Font* m_font = nullptr;
 	std::string m_text = "";
 	Vec2< size_t > m_last_window_size = {
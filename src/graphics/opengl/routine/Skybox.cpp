@@ -38,6 +38,7 @@ void Skybox::Start() {
 		//memset( texdata, 100, sizeof( texdata ) );
 
 		//glTexImage2D(target, 0, GL_RGB, texture2d->GetWidth(), texture2d->GetHeight(), 0, GL_RGB, GL_UNSIGNED_BYTE, texture2d->GetRGBData());
+		STAT_INC( opengl_textures_updates );
 		glTexImage2D( target, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, texdata );
 		target++;
 	};
@@ -194,6 +195,7 @@ void Skybox::Iterate() {
 /*				glBindTexture( GL_TEXTURE_CUBE_MAP, m_texture );
 				glActiveTexture( GL_TEXTURE0 );*/
 
+				STAT_INC( opengl_draw_calls );
 				glDrawElements( GL_QUADS, m_ibo_size, GL_UNSIGNED_SHORT, 0 );
 
 				texture->Disable();
@@ -1,3 +1,5 @@
+#include <cstddef>
+
 #include "Font.h"
 
 namespace graphics {
@@ -9,20 +11,20 @@ void Font::AddShaders() {
 		GL_VERTEX_SHADER, "#version 330 \n\
 \
 in vec4 aCoord; \
-uniform uint uFlags; \
-uniform vec2 uPosition; \
-uniform float uZIndex; \
+in vec4 aColor; \
+in vec4 aAreaLimits; \
+in float aZIndex; \
 out vec2 texpos; \
 out vec2 fragpos; \
+out vec4 color; \
+out vec4 arealimits; \
 \
 void main(void) { \
-	vec2 coord = aCoord.xy; \
-	if ( " + S_HasFlag( "uFlags", actor::Actor::RF_USE_2D_POSITION ) + " ) { \
-		coord += uPosition; \
-	}\
-	gl_Position = vec4( coord, uZIndex, 1 ); \
+	gl_Position = vec4( aCoord.xy, aZIndex, 1 ); \
 	texpos = vec2( aCoord.zw ); \
-	fragpos = coord; \
+	fragpos = aCoord.xy; \
+	color = aColor; \
+	arealimits = aAreaLimits; \
 } \
 \
 "
@@ -33,27 +35,23 @@ void main(void) { \
 \
 in vec2 texpos; \
 in vec2 fragpos; \
-uniform uint uFlags; \
+in vec4 color; \
+in vec4 arealimits; \
 uniform sampler2D uTexture; \
-uniform vec4 uColor; \
-uniform vec3 uAreaLimitsMin; \
-uniform vec3 uAreaLimitsMax; \
 out vec4 FragColor; \
 \
 void main(void) { \
-	if ( " + S_HasFlag( "uFlags", actor::Actor::RF_USE_AREA_LIMITS ) + " ) { \
-		if ( \
-			fragpos.x < uAreaLimitsMin.x || \
-			fragpos.x > uAreaLimitsMax.x || \
-			-fragpos.y < -uAreaLimitsMin.y || \
-			-fragpos.y > -uAreaLimitsMax.y \
-			/* TODO: fix Y inversion */ \
-		) { \
-			FragColor = vec4( 0.0, 0.0, 0.0, 0.0 ); \
-			return; \
-		} \
+	if ( \
+		fragpos.x < arealimits.x || \
+		fragpos.x > arealimits.z || \
+		-fragpos.y < -arealimits.y || \
+		-fragpos.y > -arealimits.w \
+		/* TODO: fix Y inversion */ \
+	) { \
+		FragColor = vec4( 0.0, 0.0, 0.0, 0.0 ); \
+		return; \
 	} \
-	FragColor = vec4(1, 1, 1, texture2D(uTexture, texpos).r) * uColor; \
+	FragColor = vec4(1, 1, 1, texture2D(uTexture, texpos).r) * color; \
 } \
 \
 "
@@ -63,22 +61,29 @@ void main(void) { \
 
 void Font::Initialize() {
 	attributes.coord = GetAttributeLocation( "aCoord" );
-	uniforms.flags = GetUniformLocation( "uFlags" );
-	uniforms.position = GetUniformLocation( "uPosition" );
+	attributes.color = GetAttributeLocation( "aColor" );
+	attributes.area_limits = GetAttributeLocation( "aAreaLimits" );
+	attributes.z_index = GetAttributeLocation( "aZIndex" );
 	uniforms.texture = GetUniformLocation( "uTexture" );
-	uniforms.color = GetUniformLocation( "uColor" );
-	uniforms.z_index = GetUniformLocation( "uZIndex" );
-	uniforms.area_limits.min = GetUniformLocation( "uAreaLimitsMin" );
-	uniforms.area_limits.max = GetUniformLocation( "uAreaLimitsMax" );
 };
 
 void Font::EnableAttributes() const {
+	const size_t vsz = sizeof( Text::vertex_t );
 	glEnableVertexAttribArray( attributes.coord );
-	glVertexAttribPointer( attributes.coord, 4, GL_FLOAT, GL_FALSE, 0, 0 );
+	glVertexAttribPointer( attributes.coord, 4, GL_FLOAT, GL_FALSE, vsz, (const GLvoid*)offsetof( Text::vertex_t, x ) );
+	glEnableVertexAttribArray( attributes.color );
+	glVertexAttribPointer( attributes.color, 4, GL_FLOAT, GL_FALSE, vsz, (const GLvoid*)offsetof( Text::vertex_t, color ) );
+	glEnableVertexAttribArray( attributes.area_limits );
+	glVertexAttribPointer( attributes.area_limits, 4, GL_FLOAT, GL_FALSE, vsz, (const GLvoid*)offsetof( Text::vertex_t, area_limits ) );
+	glEnableVertexAttribArray( attributes.z_index );
+	glVertexAttribPointer( attributes.z_index, 1, GL_FLOAT, GL_FALSE, vsz, (const GLvoid*)offsetof( Text::vertex_t, z_index ) );
 };
 
 void Font::DisableAttributes() const {
 	glDisableVertexAttribArray( attributes.coord );
+	glDisableVertexAttribArray( attributes.color );
+	glDisableVertexAttribArray( attributes.area_limits );
+	glDisableVertexAttribArray( attributes.z_index );
 };
 
 } /* namespace shader_program */
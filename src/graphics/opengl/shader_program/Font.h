@@ -5,7 +5,7 @@
 namespace graphics {
 namespace opengl {
 
-class Text;
+class TextBatch;
 
 namespace shader_program {
 
@@ -13,22 +13,17 @@ CLASS( Font, ShaderProgram )
 	Font()
 		: ShaderProgram( TYPE_FONT ) {};
 protected:
-	friend class opengl::Text;
+	friend class opengl::TextBatch;
 
 	struct {
-		GLuint flags;
-		GLuint position;
 		GLuint texture;
-		GLuint color;
-		GLuint z_index;
-		struct {
-			GLuint min;
-			GLuint max;
-		} area_limits;
 	} uniforms;
 
 	struct {
 		GLuint coord;
+		GLuint color;
+		GLuint area_limits;
+		GLuint z_index;
 	} attributes;
 
 	void AddShaders() override;
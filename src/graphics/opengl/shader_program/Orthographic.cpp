@@ -16,9 +16,10 @@ in vec3 aCoord; \
 in vec2 aTexCoord; \
 in vec4 aTintColor; \
 in vec3 aNormal; \
+in mat4 aInstanceMatrix; \
+in vec4 aInstanceTexRect; \
 uniform vec2 uPosition; \
 uniform mat4 uWorld; \
-uniform mat4 uInstances[" + std::to_string( OpenGL::MAX_INSTANCES ) + "]; \
 uniform uint uFlags; \
 out vec2 texpos; \
 out vec4 tintcolor; \
@@ -31,13 +32,13 @@ void main(void) { \
 		position = vec4( aCoord, 1.0 ); \
 	} \
 	else { \
-		position = uWorld * uInstances[ gl_InstanceID ] * vec4( aCoord, 1.0 ); \
+		position = uWorld * ( vec4( aCoord, 1.0 ) * aInstanceMatrix ) /* row-major matrix */; \
 	} \
 	if ( " + S_HasFlag( "uFlags", actor::Actor::RF_USE_2D_POSITION ) + " ) { \
 		position += vec4( uPosition, 0.0, 0.0 ); \
 	}\
 	gl_Position = position; \
-	texpos = vec2( aTexCoord.xy ); \
+	texpos = mix( aInstanceTexRect.xy, aInstanceTexRect.zw, aTexCoord.xy ); \
 	tintcolor = aTintColor; \
 	fragpos = position.xyz; \
 	normal = aNormal; \
@@ -107,6 +108,9 @@ void main(void) { \
 void Orthographic::Initialize() {
 	attributes.tex_coord = GetAttributeLocation( "aTexCoord" );
 	attributes.coord = GetAttributeLocation( "aCoord" );
+	attributes.instance_matrix = GetAttributeLocation( "aInstanceMatrix" );
+	attributes.instance_tex_rect = GetAttributeLocation( "aInstanceTexRect" );
+	ResetInstanceTexRect();
 	attributes.tint_color = GetAttributeLocation( "aTintColor" );
 	attributes.normal = GetAttributeLocation( "aNormal" );
 	uniforms.position = GetUniformLocation( "uPosition" );
@@ -114,13 +118,17 @@ void Orthographic::Initialize() {
 	uniforms.light_pos = GetUniformLocation( "uLightPos" );
 	uniforms.light_color = GetUniformLocation( "uLightColor" );
 	uniforms.world = GetUniformLocation( "uWorld" );
-	uniforms.instances = GetUniformLocation( "uInstances" );
 	uniforms.flags = GetUniformLocation( "uFlags" );
 	uniforms.tint_color = GetUniformLocation( "uTintColor" );
 	uniforms.area_limits.min = GetUniformLocation( "uAreaLimitsMin" );
 	uniforms.area_limits.max = GetUniformLocation( "uAreaLimitsMax" );
 };
 
+void Orthographic::ResetInstanceTexRect() const {
+	// whole texture, so that meshes with own texture coordinates are unaffected
+	glVertexAttrib4f( attributes.instance_tex_rect, 0.0f, 0.0f, 1.0f, 1.0f );
+}
+
 void Orthographic::EnableAttributes() const {
 	const size_t tsz = sizeof( types::mesh::Mesh::coord_t );
 	const size_t vasz = types::mesh::Render::VERTEX_SIZE * tsz;
@@ -9,6 +9,8 @@ class Sprite;
 
 class Mesh;
 
+class SpriteBatch;
+
 namespace shader_program {
 
 CLASS( Orthographic, ShaderProgram )
@@ -19,12 +21,12 @@ CLASS( Orthographic, ShaderProgram )
 protected:
 	friend class opengl::Sprite;
 	friend class opengl::Mesh;
+	friend class opengl::SpriteBatch;
 
 	struct {
 		GLuint position;
 		GLuint texture;
 		GLuint world;
-		GLuint instances;
 		GLuint light_pos;
 		GLuint light_color;
 		GLuint flags;
@@ -37,6 +39,8 @@ protected:
 
 	struct {
 		GLuint coord;
+		GLuint instance_matrix;
+		GLuint instance_tex_rect; // sub-rectangle of texture (left, top, right, bottom), for sprite batches
 		GLuint tex_coord;
 		GLuint tint_color;
 		GLuint normal;
@@ -46,6 +50,9 @@ protected:
 	void Initialize() override;
 	void EnableAttributes() const override;
 	void DisableAttributes() const override;
+
+	// needs to be called after per-instance texture rectangles were used
+	void ResetInstanceTexRect() const;
 };
 
 } /* namespace shader_program */
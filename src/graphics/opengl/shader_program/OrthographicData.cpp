@@ -14,12 +14,12 @@ void OrthographicData::AddShaders() {
 \
 in vec3 aCoord; \
 in uint aData; \
+in mat4 aInstanceMatrix; \
 uniform mat4 uWorld; \
-uniform mat4 uInstances[" + std::to_string( OpenGL::MAX_INSTANCES ) + "]; \
 out float data; \
 \
 void main(void) { \
-	gl_Position = uWorld * uInstances[ gl_InstanceID ] * vec4( aCoord, 1.0 ); \
+	gl_Position = uWorld * ( vec4( aCoord, 1.0 ) * aInstanceMatrix ) /* row-major matrix */; \
 	data = aData; \
 } \
 \
@@ -41,9 +41,9 @@ void main(void) { \
 
 void OrthographicData::Initialize() {
 	attributes.coord = GetAttributeLocation( "aCoord" );
+	attributes.instance_matrix = GetAttributeLocation( "aInstanceMatrix" );
 	attributes.data = GetAttributeLocation( "aData" );
 	uniforms.world = GetUniformLocation( "uWorld" );
-	uniforms.instances = GetUniformLocation( "uInstances" );
 };
 
 void OrthographicData::EnableAttributes() const {
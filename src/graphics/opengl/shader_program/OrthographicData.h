@@ -19,11 +19,11 @@ protected:
 
 	struct {
 		GLuint world;
-		GLuint instances;
 	} uniforms;
 
 	struct {
 		GLuint coord;
+		GLuint instance_matrix;
 		GLuint data;
 	} attributes;
 
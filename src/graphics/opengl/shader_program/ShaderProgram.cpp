@@ -114,6 +114,29 @@ void ShaderProgram::BindAttribLocation( GLuint index, const std::string name ) {
 	glBindAttribLocation( m_gl_shader_program, index, name.c_str() );
 }
 
+void ShaderProgram::EnableInstanceMatrixAttribute( const GLuint attribute, const size_t stride, const size_t offset ) const {
+	// mat4 takes 4 consecutive locations, one per column
+	// matrices are row-major so rows end up as columns, shaders need to multiply by it from the left side
+	for ( GLuint i = 0 ; i < 4 ; i++ ) {
+		glEnableVertexAttribArray( attribute + i );
+		glVertexAttribPointer( attribute + i, 4, GL_FLOAT, GL_FALSE, stride, (const GLvoid*)( offset + i * 4 * sizeof( GLfloat ) ) );
+		glVertexAttribDivisor( attribute + i, 1 );
+	}
+}
+
+void ShaderProgram::DisableInstanceMatrixAttribute( const GLuint attribute ) const {
+	for ( GLuint i = 0 ; i < 4 ; i++ ) {
+		glVertexAttribDivisor( attribute + i, 0 );
+		glDisableVertexAttribArray( attribute + i );
+	}
+}
+
+void ShaderProgram::SetInstanceMatrixAttribute( const GLuint attribute, const types::Matrix44& matrix ) const {
+	for ( GLuint i = 0 ; i < 4 ; i++ ) {
+		glVertexAttrib4fv( attribute + i, matrix.m[ i ] );
+	}
+}
+
 const string ShaderProgram::S_HasFlag( const string& var, const GLuint flag ) const {
 	return "( ( " + var + " & uint( " + to_string( flag ) + " ) ) == uint( " + to_string( flag ) + " ) )";
 }
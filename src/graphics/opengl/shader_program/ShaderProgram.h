@@ -5,6 +5,8 @@
 
 #include "base/Module.h"
 
+#include "types/Matrix44.h"
+
 namespace graphics {
 namespace opengl {
 namespace shader_program {
@@ -28,6 +30,13 @@ CLASS( ShaderProgram, base::Module )
 	void Stop() override;
 	void Enable();
 	void Disable();
+
+	// mat4 attribute with one matrix per instance, sourced from currently bound array buffer (tightly packed matrices by default)
+	void EnableInstanceMatrixAttribute( const GLuint attribute, const size_t stride = sizeof( types::Matrix44 ), const size_t offset = 0 ) const;
+	void DisableInstanceMatrixAttribute( const GLuint attribute ) const;
+	// same matrix for every vertex, for non-instanced draws (attribute array must be disabled)
+	void SetInstanceMatrixAttribute( const GLuint attribute, const types::Matrix44& matrix ) const;
+
 protected:
 	const type_t m_type;
 
@@ -73,6 +73,7 @@ void CubemapTexture::Load() {
 			}
 		}
 
+		STAT_INC( opengl_textures_updates );
 		glTexImage2D( target, 0, GL_RGB, bw, bh, 0, pixel_format, GL_UNSIGNED_BYTE, block_data );
 		target++;
 	};
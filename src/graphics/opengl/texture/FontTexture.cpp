@@ -21,6 +21,7 @@ FontTexture::FontTexture( types::Font* font ) {
 	ASSERT( !glGetError(), "Texture parameter error" );
 	glPixelStorei( GL_UNPACK_ALIGNMENT, 1 );
 
+	STAT_INC( opengl_textures_updates );
 	glTexImage2D( GL_TEXTURE_2D, 0, GL_RED, (GLsizei)font->m_dimensions.width, (GLsizei)font->m_dimensions.height, 0, GL_RED, GL_UNSIGNED_BYTE, 0 );
 	ASSERT( !glGetError(), "Error loading image of font texture" );
 
@@ -33,6 +34,7 @@ FontTexture::FontTexture( types::Font* font ) {
 
 		if ( bitmap->width > 0 && bitmap->height > 0 ) {
 			ASSERT( bitmap->data, "Font bitmap data is null" );
+			STAT_INC( opengl_textures_updates );
 			glTexSubImage2D( GL_TEXTURE_2D, 0, (GLint)ox, (GLint)oy, (GLsizei)bitmap->width, (GLsizei)bitmap->height, GL_RED, GL_UNSIGNED_BYTE, (const GLvoid*)ptr( bitmap->data, 0, bitmap->width * bitmap->height ) );
 			ASSERT( !glGetError(), "Error loading subimage of font texture" );
 		}
@@ -1,11 +1,29 @@
+#include <filesystem>
+
 #include "Loader.h"
 
 #include "engine/Engine.h"
 
+#include "util/FS.h"
+
 namespace loader {
 
-const std::string& Loader::GetRoot() {
+const std::string& Loader::GetRoot() const {
 	return g_engine->GetConfig()->GetSMACPath();
 }
 
+const std::string Loader::CreateCacheDirectory( const std::string& name ) const {
+	const std::string path = "./cache/" + name + "/";
+	try {
+		util::FS::CreateDirectoryIfNotExists( "./cache" );
+		util::FS::CreateDirectoryIfNotExists( path );
+	}
+	catch ( std::filesystem::filesystem_error& e ) {
+		// not critical, everything will be loaded from original files
+		Log( "Unable to create cache directory " + path + ": " + (std::string)e.what() );
+		return "";
+	}
+	return path;
+}
+
 }
@@ -9,7 +9,10 @@ namespace loader {
 CLASS( Loader, base::Module )
 
 protected:
-	const std::string& GetRoot();
+	const std::string& GetRoot() const;
+
+	// returns path (with trailing separator) of directory for on-disk cache, or empty string if it can't be created
+	const std::string CreateCacheDirectory( const std::string& name ) const;
 };
 
 } /* namespace loader */
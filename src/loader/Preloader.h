@@ -0,0 +1,126 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <future>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <algorithm>
+
+namespace loader {
+
+// decodes assets on worker threads so that loaders can later return them without touching disk
+// only decoding happens in workers, anything that depends on loader state (or needs gl) is still done by loader on its own thread
+template< typename RESULT_TYPE >
+class Preloader {
+public:
+	typedef std::function< RESULT_TYPE( const std::string& name ) > f_decode_t;
+	typedef std::function< void( RESULT_TYPE result ) > f_destroy_t;
+
+	Preloader( const f_decode_t& f_decode, const f_destroy_t& f_destroy )
+		: m_f_decode( f_decode )
+		, m_f_destroy( f_destroy ) {}
+
+	~Preloader() {
+		for ( auto& worker : m_workers ) {
+			worker.join();
+		}
+		// results that were never requested
+		for ( auto& it : m_results ) {
+			m_discarded.push_back( std::move( it.second ) );
+		}
+		for ( auto& future : m_discarded ) {
+			try {
+				m_f_destroy( future.get() );
+			}
+			catch ( ... ) {
+				// failed to decode, nothing to destroy
+			}
+		}
+	}
+
+	// starts decoding in background, names that are already being preloaded are skipped
+	void Preload( const std::vector< std::string >& names ) {
+		std::lock_guard< std::mutex > guard( m_results_mutex );
+		std::shared_ptr< batch_t > batch = std::make_shared< batch_t >();
+		for ( const auto& name : names ) {
+			if ( m_results.find( name ) == m_results.end() && find( batch->names.begin(), batch->names.end(), name ) == batch->names.end() ) {
+				batch->names.push_back( name );
+			}
+		}
+		if ( batch->names.empty() ) {
+			return;
+		}
+		// promises must not move after workers start
+		batch->promises.resize( batch->names.size() );
+		for ( size_t i = 0 ; i < batch->names.size() ; i++ ) {
+			m_results[ batch->names[ i ] ] = batch->promises[ i ].get_future();
+		}
+		const size_t workers_count = std::min< size_t >( batch->names.size(), std::max< size_t >( std::thread::hardware_concurrency(), 2 ) - 1 );
+		for ( size_t w = 0 ; w < workers_count ; w++ ) {
+			m_workers.emplace_back(
+				[ this, batch ]() {
+					size_t i;
+					while ( ( i = batch->next_index++ ) < batch->names.size() ) {
+						try {
+							batch->promises[ i ].set_value( m_f_decode( batch->names[ i ] ) );
+						}
+						catch ( ... ) {
+							// will be rethrown on loader thread when result is requested
+							batch->promises[ i ].set_exception( std::current_exception() );
+						}
+					}
+				}
+			);
+		}
+	}
+
+	// returns false if name wasn't preloaded, otherwise waits for it to be decoded (if it's not yet)
+	const bool Take( const std::string& name, RESULT_TYPE& result ) {
+		std::future< RESULT_TYPE > future;
+		{
+			std::lock_guard< std::mutex > guard( m_results_mutex );
+			auto it = m_results.find( name );
+			if ( it == m_results.end() ) {
+				return false;
+			}
+			future = std::move( it->second );
+			m_results.erase( it );
+		}
+		result = future.get();
+		return true;
+	}
+
+	// for when result is no longer needed, doesn't wait for it to be decoded
+	void Discard( const std::string& name ) {
+		std::lock_guard< std::mutex > guard( m_results_mutex );
+		auto it = m_results.find( name );
+		if ( it != m_results.end() ) {
+			m_discarded.push_back( std::move( it->second ) );
+			m_results.erase( it );
+		}
+	}
+
+private:
+	const f_decode_t m_f_decode;
+	const f_destroy_t m_f_destroy;
+
+	struct batch_t {
+		std::vector< std::string > names = {};
+		std::vector< std::promise< RESULT_TYPE > > promises = {};
+		std::atomic< size_t > next_index = 0;
+	};
+	std::vector< std::thread > m_workers = {};
+
+	// loaders may be called from different threads (e.g. map loads textures from game thread)
+	std::mutex m_results_mutex;
+	std::unordered_map< std::string, std::future< RESULT_TYPE > > m_results = {};
+	std::vector< std::future< RESULT_TYPE > > m_discarded = {};
+
+};
+
+} /* namespace loader */
@@ -1,10 +1,47 @@
+#include <cstring>
+#include <cstdio>
+
 #include "FreeType.h"
 
 #include "util/System.h"
+#include "util/FS.h"
+#include "util/MappedFile.h"
+#include "util/Hash.h"
+
+#include "base/Profiler.h"
+
+#define DISK_CACHE_MAGIC "GLSMACFC"
+#define DISK_CACHE_VERSION 1
+
+// only ascii for now
+#define FIRST_GLYPH 32
+#define LAST_GLYPH 127
 
 namespace loader {
 namespace font {
 
+// on-disk layout: header, then glyph entries for whole range, then bitmaps
+struct disk_cache_header_t {
+	char magic[8];
+	uint64_t font_hash;
+	uint32_t version;
+	uint32_t size;
+	uint32_t first_glyph;
+	uint32_t last_glyph;
+	float width;
+	float height;
+};
+
+struct disk_cache_glyph_t {
+	int32_t ax;
+	int32_t ay;
+	uint32_t width;
+	uint32_t height;
+	int32_t left;
+	int32_t top;
+	uint32_t data_offset; // from start of file
+};
+
 FreeType::~FreeType() {
 	for ( auto& it : m_fonts ) {
 		DELETE( it.second );
@@ -14,6 +51,8 @@ FreeType::~FreeType() {
 void FreeType::Start() {
 	auto res = FT_Init_FreeType( &m_freetype );
 	ASSERT( !res, "Unable to initialize FreeType" );
+
+	m_disk_cache_directory = CreateCacheDirectory( "fonts" );
 }
 
 void FreeType::Stop() {
@@ -33,64 +72,208 @@ types::Font* FreeType::LoadFont( const std::string& name, const unsigned char si
 		return it->second;
 	}
 	else {
-		int res = 0;
-
+		PROFILE_ZONE( "LoadFont" );
 		Log( "Loading font \"" + font_key + "\"" );
 
 		NEWV( font, types::Font );
 		font->m_name = name;
 
-		FT_Face ftface;
+		std::string path = "";
 		auto filenames = util::System::GetPossibleFilenames( name );
 		for ( auto& filename : filenames ) {
-			res = FT_New_Face( m_freetype, ( GetRoot() + filename ).c_str(), 0, &ftface );
-			if ( !res ) {
+			if ( util::FS::FileExists( GetRoot() + filename ) ) {
+				path = GetRoot() + filename;
 				break;
 			}
 		}
+		ASSERT( !path.empty(), "Unable to load font \"" + name + "\"" );
 
-		ASSERT( !res, "Unable to load font \"" + name + "\"" );
-		FT_Set_Pixel_Sizes( ftface, 0, size );
+		// whole font file is read every time because cache entry is keyed by its hash, mapping only saves copying it (where mmap is supported)
+		util::MappedFile font_file( path );
+		ASSERT( font_file.IsMapped(), "Unable to load font \"" + name + "\"" );
 
-		font->m_dimensions.width = font->m_dimensions.height = 0;
+		const auto font_hash = util::Hash::Get( font_file.GetData(), font_file.GetSize() );
+		const auto cache_path = GetDiskCachePath( font_hash, size );
 
-		FT_GlyphSlot g = ftface->glyph;
-		types::Font::bitmap_t* bitmap;
-		int sz;
+		if ( !m_disk_cache_directory.empty() && LoadFontFromDiskCache( font, cache_path, font_hash, size ) ) {
+			STAT_INC( fonts_loaded_from_cache );
+		}
+		else {
+			RasterizeFont( font, font_file.GetData(), font_file.GetSize(), size );
+			if ( !m_disk_cache_directory.empty() ) {
+				SaveFontToDiskCache( font, cache_path, font_hash, size );
+			}
+		}
 
-		for ( int i = 32 ; i < 128 ; i++ ) { // only ascii for now
-			res = FT_Load_Char( ftface, i, FT_LOAD_RENDER );
-			ASSERT( !res, "Font \"" + name + "\" bitmap loading failed" );
+		m_fonts[ font_key ] = font;
 
-			bitmap = &font->m_symbols[ i ];
+		STAT_INC( fonts_loaded );
 
-			bitmap->ax = g->advance.x >> 6;
-			bitmap->ay = g->advance.y >> 6;
-			bitmap->width = g->bitmap.width;
-			bitmap->height = g->bitmap.rows;
-			bitmap->left = g->bitmap_left;
-			bitmap->top = g->bitmap_top;
-			sz = bitmap->width * bitmap->height;
-			if ( sz > 0 ) {
-				bitmap->data = (unsigned char*)malloc( sz );
-				memcpy( ptr( bitmap->data, 0, sz ), g->bitmap.buffer, sz );
-			}
-			else {
-				bitmap->data = nullptr;
-			}
+		return font;
+	}
+}
+
+const std::string FreeType::GetDiskCachePath( const uint64_t font_hash, const unsigned char size ) const {
+	return
+		m_disk_cache_directory +
+			util::Hash::ToString( font_hash ) +
+			"_" + std::to_string( size ) +
+			"_" + std::to_string( FIRST_GLYPH ) + "-" + std::to_string( LAST_GLYPH ) +
+			".glyphs";
+}
+
+const bool FreeType::LoadFontFromDiskCache( types::Font* font, const std::string& path, const uint64_t font_hash, const unsigned char size ) const {
+	const util::MappedFile file( path );
+	if ( !file.IsMapped() ) {
+		return false;
+	}
 
-			font->m_dimensions.width += g->bitmap.width;
-			font->m_dimensions.height = std::max( font->m_dimensions.height, (float)g->bitmap.rows );
+	const size_t glyphs_count = LAST_GLYPH - FIRST_GLYPH + 1;
+	const size_t file_size = file.GetSize();
+	if ( file_size < sizeof( disk_cache_header_t ) + glyphs_count * sizeof( disk_cache_glyph_t ) ) {
+		return false;
+	}
+	const auto* data = file.GetData();
+	const auto* header = (const disk_cache_header_t*)data;
+	if (
+		memcmp( header->magic, DISK_CACHE_MAGIC, sizeof( header->magic ) ) ||
+			header->version != DISK_CACHE_VERSION ||
+			header->font_hash != font_hash ||
+			header->size != size ||
+			header->first_glyph != FIRST_GLYPH ||
+			header->last_glyph != LAST_GLYPH
+		) {
+		return false;
+	}
+
+	// validate everything before allocating anything, partially loaded font would need cleanup
+	const auto* glyphs = (const disk_cache_glyph_t*)( data + sizeof( disk_cache_header_t ) );
+	for ( size_t i = 0 ; i < glyphs_count ; i++ ) {
+		const auto& glyph = glyphs[ i ];
+		const size_t sz = (size_t)glyph.width * glyph.height;
+		if ( glyph.data_offset > file_size || sz > file_size - glyph.data_offset ) {
+			return false;
 		}
+	}
 
-		FT_Done_Face( ftface );
+	Log( "Using cached glyphs from " + path );
 
-		m_fonts[ font_key ] = font;
+	font->m_dimensions.width = header->width;
+	font->m_dimensions.height = header->height;
 
-		DEBUG_STAT_INC( fonts_loaded );
+	types::Font::bitmap_t* bitmap;
+	size_t sz;
 
-		return font;
+	for ( size_t i = 0 ; i < glyphs_count ; i++ ) {
+		const auto& glyph = glyphs[ i ];
+
+		bitmap = &font->m_symbols[ FIRST_GLYPH + i ];
+
+		bitmap->ax = glyph.ax;
+		bitmap->ay = glyph.ay;
+		bitmap->width = glyph.width;
+		bitmap->height = glyph.height;
+		bitmap->left = glyph.left;
+		bitmap->top = glyph.top;
+		sz = bitmap->width * bitmap->height;
+		if ( sz > 0 ) {
+			bitmap->data = (unsigned char*)malloc( sz );
+			memcpy( ptr( bitmap->data, 0, sz ), data + glyph.data_offset, sz );
+		}
+		else {
+			bitmap->data = nullptr;
+		}
+	}
+
+	return true;
+}
+
+void FreeType::SaveFontToDiskCache( const types::Font* font, const std::string& path, const uint64_t font_hash, const unsigned char size ) const {
+	const size_t glyphs_count = LAST_GLYPH - FIRST_GLYPH + 1;
+
+	disk_cache_header_t header = {};
+	memcpy( header.magic, DISK_CACHE_MAGIC, sizeof( header.magic ) );
+	header.font_hash = font_hash;
+	header.version = DISK_CACHE_VERSION;
+	header.size = size;
+	header.first_glyph = FIRST_GLYPH;
+	header.last_glyph = LAST_GLYPH;
+	header.width = font->m_dimensions.width;
+	header.height = font->m_dimensions.height;
+
+	std::string data = "";
+	data.append( (const char*)&header, sizeof( header ) );
+
+	size_t data_offset = sizeof( header ) + glyphs_count * sizeof( disk_cache_glyph_t );
+	for ( size_t i = 0 ; i < glyphs_count ; i++ ) {
+		const auto& bitmap = font->m_symbols[ FIRST_GLYPH + i ];
+		const disk_cache_glyph_t glyph = {
+			bitmap.ax,
+			bitmap.ay,
+			bitmap.width,
+			bitmap.height,
+			bitmap.left,
+			bitmap.top,
+			(uint32_t)data_offset
+		};
+		data.append( (const char*)&glyph, sizeof( glyph ) );
+		data_offset += bitmap.width * bitmap.height;
 	}
+	for ( size_t i = 0 ; i < glyphs_count ; i++ ) {
+		const auto& bitmap = font->m_symbols[ FIRST_GLYPH + i ];
+		const size_t sz = bitmap.width * bitmap.height;
+		if ( sz > 0 ) {
+			data.append( (const char*)ptr( bitmap.data, 0, sz ), sz );
+		}
+	}
+
+	// write to temporary file first so that other instances never see partially written cache
+	const std::string tmp_path = path + ".tmp";
+	util::FS::WriteFile( tmp_path, data );
+	if ( std::rename( tmp_path.c_str(), path.c_str() ) ) {
+		Log( "Unable to write font cache to " + path );
+		std::remove( tmp_path.c_str() );
+	}
+}
+
+void FreeType::RasterizeFont( types::Font* font, const unsigned char* font_data, const size_t font_data_size, const unsigned char size ) {
+	FT_Face ftface;
+	int res = FT_New_Memory_Face( m_freetype, font_data, font_data_size, 0, &ftface );
+	ASSERT( !res, "Unable to load font \"" + font->m_name + "\"" );
+	FT_Set_Pixel_Sizes( ftface, 0, size );
+
+	font->m_dimensions.width = font->m_dimensions.height = 0;
+
+	FT_GlyphSlot g = ftface->glyph;
+	types::Font::bitmap_t* bitmap;
+	int sz;
+
+	for ( int i = FIRST_GLYPH ; i <= LAST_GLYPH ; i++ ) {
+		res = FT_Load_Char( ftface, i, FT_LOAD_RENDER );
+		ASSERT( !res, "Font \"" + font->m_name + "\" bitmap loading failed" );
+
+		bitmap = &font->m_symbols[ i ];
+
+		bitmap->ax = g->advance.x >> 6;
+		bitmap->ay = g->advance.y >> 6;
+		bitmap->width = g->bitmap.width;
+		bitmap->height = g->bitmap.rows;
+		bitmap->left = g->bitmap_left;
+		bitmap->top = g->bitmap_top;
+		sz = bitmap->width * bitmap->height;
+		if ( sz > 0 ) {
+			bitmap->data = (unsigned char*)malloc( sz );
+			memcpy( ptr( bitmap->data, 0, sz ), g->bitmap.buffer, sz );
+		}
+		else {
+			bitmap->data = nullptr;
+		}
+
+		font->m_dimensions.width += g->bitmap.width;
+		font->m_dimensions.height = std::max( font->m_dimensions.height, (float)g->bitmap.rows );
+	}
+
+	FT_Done_Face( ftface );
 }
 
 } /* namespace font */
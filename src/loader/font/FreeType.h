@@ -25,6 +25,15 @@ protected:
 	// cache all fonts for future use
 	typedef std::unordered_map< std::string, types::Font* > font_map_t;
 	font_map_t m_fonts;
+
+	// rasterized glyphs are also cached on disk, keyed by font file hash, size and glyph range, so that later launches don't need to rasterize them again
+	std::string m_disk_cache_directory = "";
+	const std::string GetDiskCachePath( const uint64_t font_hash, const unsigned char size ) const;
+	const bool LoadFontFromDiskCache( types::Font* font, const std::string& path, const uint64_t font_hash, const unsigned char size ) const;
+	void SaveFontToDiskCache( const types::Font* font, const std::string& path, const uint64_t font_hash, const unsigned char size ) const;
+
+	void RasterizeFont( types::Font* font, const unsigned char* font_data, const size_t font_data_size, const unsigned char size );
+
 };
 
 } /* namespace font */
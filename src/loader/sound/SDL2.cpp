@@ -11,6 +11,16 @@ using namespace types;
 namespace loader {
 namespace sound {
 
+SDL2::SDL2()
+	: m_preloader(
+		[ this ]( const std::string& name ) -> Sound* {
+			return DecodeSound( name );
+		},
+		[]( Sound* sound ) -> void {
+			DELETE( sound );
+		}
+	) {}
+
 SDL2::~SDL2() {
 	for ( auto& sound : m_sounds ) {
 		DELETE( sound.second );
@@ -27,52 +37,65 @@ Sound* SDL2::LoadSound( const std::string& name ) {
 	}
 	else {
 
-		Log( "Loading sound \"" + name + "\"" );
+		Sound* sound = nullptr;
+		if ( !m_preloader.Take( name, sound ) ) {
+			Log( "Loading sound \"" + name + "\"" );
+			sound = DecodeSound( name );
+		}
+
+		m_sounds[ font_key ] = sound;
+
+		return sound;
+	}
+}
 
-		NEWV( sound, Sound );
-		sound->m_name = name;
+void SDL2::Preload( const std::vector< std::string >& names ) {
+	Log( "Preloading " + std::to_string( names.size() ) + " sounds" );
+	m_preloader.Preload( names );
+}
 
-		Uint8* wav_buffer = nullptr; // buffer containing our audio file
-		Uint32 wav_length = 0; // length of our sample
-		SDL_AudioSpec wav_spec; // the specs of our piece of music
+Sound* SDL2::DecodeSound( const std::string& name ) const {
+	Uint8* wav_buffer = nullptr; // buffer containing our audio file
+	Uint32 wav_length = 0; // length of our sample
+	SDL_AudioSpec wav_spec; // the specs of our piece of music
 
-		SDL_AudioSpec* ret = nullptr;
+	SDL_AudioSpec* ret = nullptr;
 
-		auto dirs = util::System::GetPossibleFilenames( "fx" );
-		auto filenames = util::System::GetPossibleFilenames( name );
-		for ( auto& dir : dirs ) {
-			for ( auto& filename : filenames ) {
-				/* Load the WAV */
-				// the specs, length and buffer of our wav are filled
-				ret = SDL_LoadWAV( ( GetRoot() + dir + "/" + filename ).c_str(), &wav_spec, &wav_buffer, &wav_length );
-				if ( ret ) {
-					break;
-				}
-			}
+	auto dirs = util::System::GetPossibleFilenames( "fx" );
+	auto filenames = util::System::GetPossibleFilenames( name );
+	for ( auto& dir : dirs ) {
+		for ( auto& filename : filenames ) {
+			/* Load the WAV */
+			// the specs, length and buffer of our wav are filled
+			ret = SDL_LoadWAV( ( GetRoot() + dir + "/" + filename ).c_str(), &wav_spec, &wav_buffer, &wav_length );
 			if ( ret ) {
 				break;
 			}
 		}
-		ASSERT( ret, "Unable to load sound \"" + name + "\"" );
+		if ( ret ) {
+			break;
+		}
+	}
+	ASSERT_NOLOG( ret, "Unable to load sound \"" + name + "\"" );
 
-		sound->m_buffer_size = wav_length;
-		sound->m_buffer = (unsigned char*)malloc( sound->m_buffer_size );
-		memcpy( ptr( sound->m_buffer, 0, wav_length ), wav_buffer, wav_length );
+	NEWV( sound, Sound );
+	sound->m_name = name;
 
-		sound->m_spec.channels = wav_spec.channels;
-		sound->m_spec.format = wav_spec.format;
-		sound->m_spec.freq = wav_spec.freq;
-		sound->m_spec.padding = wav_spec.padding;
-		sound->m_spec.samples = wav_spec.samples;
-		sound->m_spec.silence = wav_spec.silence;
-		sound->m_spec.size = wav_spec.size;
+	sound->m_buffer_size = wav_length;
+	sound->m_buffer = (unsigned char*)malloc( sound->m_buffer_size );
+	memcpy( ptr( sound->m_buffer, 0, wav_length ), wav_buffer, wav_length );
 
-		SDL_FreeWAV( wav_buffer );
+	sound->m_spec.channels = wav_spec.channels;
+	sound->m_spec.format = wav_spec.format;
+	sound->m_spec.freq = wav_spec.freq;
+	sound->m_spec.padding = wav_spec.padding;
+	sound->m_spec.samples = wav_spec.samples;
+	sound->m_spec.silence = wav_spec.silence;
+	sound->m_spec.size = wav_spec.size;
 
-		m_sounds[ font_key ] = sound;
+	SDL_FreeWAV( wav_buffer );
 
-		return sound;
-	}
+	return sound;
 }
 
 }
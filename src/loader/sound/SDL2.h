@@ -4,19 +4,28 @@
 
 #include "SoundLoader.h"
 
+#include "../Preloader.h"
+
 namespace loader {
 namespace sound {
 
 CLASS( SDL2, SoundLoader )
 
+	SDL2();
 	virtual ~SDL2();
 
 	types::Sound* LoadSound( const std::string& name ) override;
 
+	void Preload( const std::vector< std::string >& names ) override;
+
 private:
 	// cache all sounds for future use
 	typedef std::unordered_map< std::string, types::Sound* > sound_map_t;
 	sound_map_t m_sounds;
+
+	// doesn't touch loader state so it can run in preloader threads
+	types::Sound* DecodeSound( const std::string& name ) const;
+	Preloader< types::Sound* > m_preloader;
 };
 
 }
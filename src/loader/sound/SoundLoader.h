@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "../Loader.h"
 
@@ -11,6 +12,9 @@ namespace sound {
 
 CLASS( SoundLoader, Loader )
 	virtual types::Sound* LoadSound( const std::string& name ) = 0;
+
+	// start decoding sounds in background, LoadSound() will pick them up when they are needed
+	virtual void Preload( const std::vector< std::string >& names ) = 0;
 };
 
 } /* namespace sound */
@@ -1,12 +1,53 @@
 #include <iostream>
+#include <cstring>
+#include <cstdio>
+#include <filesystem>
+#include <algorithm>
 
 #include "SDL2.h"
 
 #include "util/System.h"
+#include "util/FS.h"
+#include "util/MappedFile.h"
+#include "util/Hash.h"
+
+#include "base/Profiler.h"
+
+#define DISK_CACHE_MAGIC "GLSMACTX"
+#define DISK_CACHE_VERSION 1
+#define DISK_CACHE_EXTENSION ".texture"
 
 namespace loader {
 namespace texture {
 
+// on-disk layout: header, then bitmap
+struct disk_cache_header_t {
+	char magic[8];
+	uint32_t version;
+	uint32_t width;
+	uint32_t height;
+	uint32_t bpp;
+	float aspect_ratio;
+	uint32_t is_tiled;
+	uint64_t bitmap_size;
+};
+
+SDL2::SDL2()
+	: m_preloader(
+		[ this ]( const std::string& name ) -> Texture* {
+			if ( HasDiskCachedVariants( name ) ) {
+				// most likely won't be needed
+				return nullptr;
+			}
+			return DecodeTexture( name );
+		},
+		[]( Texture* texture ) -> void {
+			if ( texture ) {
+				DELETE( texture );
+			}
+		}
+	) {}
+
 SDL2::~SDL2() {
 	for ( auto& it : m_textures ) {
 		DELETE( it.second );
@@ -17,7 +58,7 @@ SDL2::~SDL2() {
 }
 
 void SDL2::Start() {
-
+	m_disk_cache_directory = CreateCacheDirectory( "textures" );
 }
 
 void SDL2::Stop() {
@@ -35,39 +76,30 @@ Texture* SDL2::LoadTexture( const std::string& name ) {
 		return it->second;
 	}
 	else {
-		Log( "Loading texture \"" + name + "\"" );
-		auto filenames = util::System::GetPossibleFilenames( name );
-		SDL_Surface* image = nullptr;
-		for ( auto& filename : filenames ) {
-			image = IMG_Load( ( GetRoot() + name ).c_str() );
-			if ( image ) {
-				break;
-			}
+		PROFILE_ZONE( "LoadTexture" );
+		const auto cache_path = GetDiskCachePath( name, "" );
+		Texture* texture = cache_path.empty()
+			? nullptr
+			: LoadTextureFromDiskCache( cache_path, name );
+		if ( texture ) {
+			m_preloader.Discard( name );
 		}
-		ASSERT( image, IMG_GetError() );
-		if ( image->format->format != SDL_PIXELFORMAT_RGBA32 ) {
-			// we must have all images in same format
-			SDL_Surface* old = image;
-			image = SDL_ConvertSurfaceFormat( old, SDL_PIXELFORMAT_RGBA32, 0 );
-			ASSERT( image, IMG_GetError() );
-			SDL_FreeSurface( old );
-		}
-
-		NEWV( texture, Texture, name, image->w, image->h );
-		texture->m_aspect_ratio = (float)texture->m_height / texture->m_width;
-		texture->m_bpp = image->format->BitsPerPixel / 8;
-		texture->m_bitmap_size = image->w * image->h * texture->m_bpp;
-		texture->m_bitmap = (unsigned char*)malloc( texture->m_bitmap_size );
-		memcpy( ptr( texture->m_bitmap, 0, texture->m_bitmap_size ), image->pixels, texture->m_bitmap_size );
-		SDL_FreeSurface( image );
+		else {
+			if ( !m_preloader.Take( name, texture ) || !texture ) {
+				Log( "Loading texture \"" + name + "\"" );
+				texture = DecodeTexture( name );
+			}
 
-		FixTexture( texture ); // some pcx files have strange artifacts that we need to fix procedurally
+			FixTransparency( texture ); // TODO: base texture should be saved as-is
 
-		FixTransparency( texture ); // TODO: base texture should be saved as-is
+			if ( !cache_path.empty() ) {
+				SaveTextureToDiskCache( texture, cache_path );
+			}
+		}
 
 		m_textures[ name ] = texture;
 
-		DEBUG_STAT_INC( textures_loaded );
+		STAT_INC( textures_loaded );
 
 		return texture;
 	}
@@ -92,10 +124,21 @@ Texture* SDL2::LoadTexture( const std::string& name, const size_t x1, const size
 		return it->second;
 	}
 	else {
+		PROFILE_ZONE( "LoadSubtexture" );
+
+		const auto cache_path = GetDiskCachePath( name, subtexture_key );
+		Texture* subtexture = cache_path.empty()
+			? nullptr
+			: LoadTextureFromDiskCache( cache_path, subtexture_key );
+		if ( subtexture ) {
+			// full texture may not be needed at all
+			m_subtextures[ subtexture_key ] = subtexture;
+			return subtexture;
+		}
 
 		auto* full_texture = LoadTexture( name );
 
-		NEWV( subtexture, Texture, subtexture_key, x2 - x1 + 1, y2 - y1 + 1 );
+		NEW( subtexture, Texture, subtexture_key, x2 - x1 + 1, y2 - y1 + 1 );
 
 		subtexture->AddFrom( full_texture, Texture::AM_DEFAULT, x1, y1, x2, y2 );
 		if ( ( flags & LT_ROTATE ) == LT_ROTATE ) {
@@ -118,12 +161,166 @@ Texture* SDL2::LoadTexture( const std::string& name, const size_t x1, const size
 
 		FixTransparency( subtexture );
 
+		if ( !cache_path.empty() ) {
+			SaveTextureToDiskCache( subtexture, cache_path );
+		}
+
 		m_subtextures[ subtexture_key ] = subtexture;
 
 		return subtexture;
 	}
 }
 
+void SDL2::Preload( const std::vector< std::string >& names ) {
+	Log( "Preloading " + std::to_string( names.size() ) + " textures" );
+	m_preloader.Preload( names );
+}
+
+Texture* SDL2::DecodeTexture( const std::string& name ) const {
+	const auto path = GetSourcePath( name );
+	ASSERT_NOLOG( !path.empty(), "Unable to load texture \"" + name + "\"" );
+	SDL_Surface* image = IMG_Load( path.c_str() );
+	ASSERT_NOLOG( image, IMG_GetError() );
+	if ( image->format->format != SDL_PIXELFORMAT_RGBA32 ) {
+		// we must have all images in same format
+		SDL_Surface* old = image;
+		image = SDL_ConvertSurfaceFormat( old, SDL_PIXELFORMAT_RGBA32, 0 );
+		ASSERT_NOLOG( image, IMG_GetError() );
+		SDL_FreeSurface( old );
+	}
+
+	NEWV( texture, Texture, name, image->w, image->h );
+	texture->m_aspect_ratio = (float)texture->m_height / texture->m_width;
+	ASSERT_NOLOG( texture->m_bpp == image->format->BitsPerPixel / 8, "unexpected texture bpp" );
+	memcpy( ptr( texture->m_bitmap, 0, texture->m_bitmap_size ), image->pixels, texture->m_bitmap_size );
+	SDL_FreeSurface( image );
+
+	FixTexture( texture ); // some pcx files have strange artifacts that we need to fix procedurally
+
+	return texture;
+}
+
+const std::string SDL2::GetSourcePath( const std::string& name ) const {
+	for ( auto& filename : util::System::GetPossibleFilenames( name ) ) {
+		const auto path = GetRoot() + filename;
+		if ( util::FS::FileExists( path ) ) {
+			return path;
+		}
+	}
+	return "";
+}
+
+const std::string SDL2::GetDiskCachePrefix( const std::string& name ) const {
+	if ( m_disk_cache_directory.empty() ) {
+		return "";
+	}
+	const auto source_path = GetSourcePath( name );
+	if ( source_path.empty() ) {
+		return "";
+	}
+
+	// any change of source file invalidates its cache
+	std::string source_stamp = "";
+	try {
+		source_stamp =
+			std::to_string( std::filesystem::last_write_time( source_path ).time_since_epoch().count() ) + ":" +
+				std::to_string( std::filesystem::file_size( source_path ) );
+	}
+	catch ( std::filesystem::filesystem_error& e ) {
+		return "";
+	}
+
+	return
+		m_disk_cache_directory +
+			util::Hash::ToString( util::Hash::Get( name ) ) + "_" +
+			util::Hash::ToString( util::Hash::Get( source_stamp ) ) + "_";
+}
+
+const std::string SDL2::GetDiskCachePath( const std::string& name, const std::string& variant ) const {
+	const auto prefix = GetDiskCachePrefix( name );
+	if ( prefix.empty() ) {
+		return "";
+	}
+
+	// transparency is baked into texture so it's part of key too
+	std::string parameters = variant;
+	if ( m_is_transparent_color_set ) {
+		std::vector< Color::rgba_t > colors( m_transparent_colors.begin(), m_transparent_colors.end() );
+		std::sort( colors.begin(), colors.end() );
+		for ( const auto& c : colors ) {
+			parameters += ":" + std::to_string( c );
+		}
+	}
+
+	return prefix + util::Hash::ToString( util::Hash::Get( parameters ) ) + DISK_CACHE_EXTENSION;
+}
+
+const bool SDL2::HasDiskCachedVariants( const std::string& name ) const {
+	const auto prefix = GetDiskCachePrefix( name );
+	if ( prefix.empty() ) {
+		return false;
+	}
+	const auto file_prefix = prefix.substr( m_disk_cache_directory.size() );
+	for ( const auto& file : util::FS::ListDirectory( m_disk_cache_directory ) ) {
+		if ( file.compare( 0, file_prefix.size(), file_prefix ) == 0 ) {
+			return true;
+		}
+	}
+	return false;
+}
+
+Texture* SDL2::LoadTextureFromDiskCache( const std::string& path, const std::string& texture_name ) const {
+	const util::MappedFile file( path );
+	if ( !file.IsMapped() || file.GetSize() < sizeof( disk_cache_header_t ) ) {
+		return nullptr;
+	}
+	const auto* header = (const disk_cache_header_t*)file.GetData();
+	if (
+		memcmp( header->magic, DISK_CACHE_MAGIC, sizeof( header->magic ) ) ||
+			header->version != DISK_CACHE_VERSION ||
+			!header->width ||
+			!header->height ||
+			header->bpp != 4 ||
+			header->bitmap_size != (uint64_t)header->width * header->height * header->bpp ||
+			header->bitmap_size != file.GetSize() - sizeof( disk_cache_header_t )
+		) {
+		return nullptr;
+	}
+
+	NEWV( texture, Texture, texture_name, header->width, header->height );
+	ASSERT( texture->m_bitmap_size == header->bitmap_size, "cached texture bitmap size mismatch" );
+	memcpy( ptr( texture->m_bitmap, 0, texture->m_bitmap_size ), file.GetData() + sizeof( disk_cache_header_t ), texture->m_bitmap_size );
+	texture->m_aspect_ratio = header->aspect_ratio;
+	texture->m_is_tiled = header->is_tiled;
+
+	return texture;
+}
+
+void SDL2::SaveTextureToDiskCache( const Texture* texture, const std::string& path ) const {
+	disk_cache_header_t header = {};
+	memcpy( header.magic, DISK_CACHE_MAGIC, sizeof( header.magic ) );
+	header.version = DISK_CACHE_VERSION;
+	header.width = texture->m_width;
+	header.height = texture->m_height;
+	header.bpp = texture->m_bpp;
+	header.aspect_ratio = texture->m_aspect_ratio;
+	header.is_tiled = texture->m_is_tiled;
+	header.bitmap_size = texture->m_bitmap_size;
+
+	std::string data = "";
+	data.reserve( sizeof( header ) + texture->m_bitmap_size );
+	data.append( (const char*)&header, sizeof( header ) );
+	data.append( (const char*)ptr( texture->m_bitmap, 0, texture->m_bitmap_size ), texture->m_bitmap_size );
+
+	// write to temporary file first so that other instances never see partially written cache
+	const std::string tmp_path = path + ".tmp";
+	util::FS::WriteFile( tmp_path, data );
+	if ( std::rename( tmp_path.c_str(), path.c_str() ) ) {
+		Log( "Unable to write texture cache to " + path );
+		std::remove( tmp_path.c_str() );
+	}
+}
+
 void SDL2::FixTransparency( Texture* texture ) const {
 	if ( m_is_transparent_color_set ) {
 		void* at = nullptr;
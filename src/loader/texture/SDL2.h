@@ -5,10 +5,13 @@
 
 #include "TextureLoader.h"
 
+#include "../Preloader.h"
+
 namespace loader {
 namespace texture {
 
 CLASS( SDL2, TextureLoader )
+	SDL2();
 	virtual ~SDL2();
 
 	void Start() override;
@@ -18,6 +21,8 @@ CLASS( SDL2, TextureLoader )
 	Texture* LoadTexture( const std::string& name ) override;
 	Texture* LoadTexture( const std::string& name, const size_t x1, const size_t y1, const size_t x2, const size_t y2, const uint8_t flags, const float value = 1.0 ) override;
 
+	void Preload( const std::vector< std::string >& names ) override;
+
 protected:
 	// cache all textures for future use
 	typedef std::unordered_map< std::string, Texture* > texture_map_t;
@@ -25,6 +30,23 @@ protected:
 	texture_map_t m_subtextures = {};
 
 private:
+	// doesn't touch loader state so it can run in preloader threads
+	// transparency is not fixed here because it depends on transparent colors at the time of LoadTexture()
+	Texture* DecodeTexture( const std::string& name ) const;
+	Preloader< Texture* > m_preloader;
+
+	const std::string GetSourcePath( const std::string& name ) const;
+
+	// processed textures and subtextures are also cached on disk, keyed by source file name, mtime and size, and all processing parameters
+	std::string m_disk_cache_directory = "";
+	// same for all variants of texture, doesn't depend on loader state
+	const std::string GetDiskCachePrefix( const std::string& name ) const;
+	// variant is empty for full textures
+	const std::string GetDiskCachePath( const std::string& name, const std::string& variant ) const;
+	const bool HasDiskCachedVariants( const std::string& name ) const;
+	Texture* LoadTextureFromDiskCache( const std::string& path, const std::string& texture_name ) const;
+	void SaveTextureToDiskCache( const Texture* texture, const std::string& path ) const;
+
 	void FixTransparency( Texture* texture ) const;
 
 	void FixTexture( Texture* texture ) const;
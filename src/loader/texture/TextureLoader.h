@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include <unordered_set>
 #include <unordered_map>
 
@@ -39,6 +40,9 @@ CLASS( TextureLoader, Loader )
 
 	Texture* GetColorTexture( const Color& color );
 
+	// start decoding textures in background, LoadTexture() will pick them up when they are needed
+	virtual void Preload( const std::vector< std::string >& names ) = 0;
+
 	// treat specific color as transparent
 	void SetTransparentColor( const Color::rgba_t rgba );
 
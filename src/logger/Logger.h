@@ -1,13 +1,27 @@
 #pragma once
 
 #include <string>
+#include <atomic>
 
 #include "base/Module.h"
 
 namespace logger {
 
 CLASS( Logger, base::Module )
-	virtual void Log( const std::string& text ) = 0;
+	virtual void Log( const base::log_level_t level, const std::string& text ) = 0;
+
+	// writes everything that is still queued, called on fatal errors
+	virtual void Flush() {}
+
+	void SetMinLevel( const base::log_level_t level ) {
+		m_min_level = level;
+	}
+	const bool IsLevelEnabled( const base::log_level_t level ) const {
+		return level >= m_min_level;
+	}
+
+protected:
+	std::atomic< base::log_level_t > m_min_level = LOG_LEVEL_MIN;
 };
 
 } /* namespace logger */
@@ -1,22 +1,254 @@
 #include <cstdio>
+#include <cstring>
+#include <csignal>
+#include <chrono>
+#include <algorithm>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
 
 #include "Stdout.h"
 
 namespace logger {
 
-#ifdef DEBUG
+// for crash handler
+static Stdout* s_instance = nullptr;
 
-void Stdout::Log( const std::string& text ) {
-	g_debug_stats._mutex.lock();
-	if ( !g_debug_stats._readonly ) { // don't spam from debug overlay
-		m_log_mutex.lock();
-		printf( "%s\n", text.c_str() );
-		fflush( stdout ); // we want to flush to have everything printed in case of crash
-		m_log_mutex.unlock();
+// releases ring of current thread when thread exits
+struct ring_owner_t {
+	std::atomic< bool >* is_owned = nullptr;
+	~ring_owner_t() {
+		if ( is_owned ) {
+			*is_owned = false;
+		}
 	}
-	g_debug_stats._mutex.unlock();
-}
+};
+static thread_local void* s_current_ring = nullptr;
+static thread_local ring_owner_t s_ring_owner = {};
 
+// crash handler can't allocate, so it formats output here
+static char s_crash_buffer[ 1 << 16 ];
+
+// async-signal-safe
+static void WriteToStdout( const char* data, size_t size ) {
+	while ( size > 0 ) {
+#ifdef _WIN32
+		const int written = _write( 1, data, size );
+#else
+		const ssize_t written = ::write( STDOUT_FILENO, data, size );
 #endif
+		if ( written <= 0 ) {
+			return;
+		}
+		data += written;
+		size -= written;
+	}
+}
+
+static const char* s_level_prefixes[] = {
+	"", // LL_DEBUG
+	"", // LL_INFO
+	"WARNING: ",
+	"ERROR: ",
+};
+
+Stdout::Stdout() {
+	s_instance = this;
+	m_writer_thread = std::thread( &Stdout::WriterLoop, this );
+	// whatever is still in rings is most useful when something crashes
+	signal( SIGSEGV, OnCrash );
+	signal( SIGABRT, OnCrash );
+	signal( SIGFPE, OnCrash );
+}
+
+Stdout::~Stdout() {
+	{
+		std::lock_guard< std::mutex > guard( m_writer_mutex );
+		m_is_stopping = true;
+	}
+	m_writer_condition.notify_one();
+	m_writer_thread.join();
+	Write();
+	signal( SIGSEGV, SIG_DFL );
+	signal( SIGABRT, SIG_DFL );
+	signal( SIGFPE, SIG_DFL );
+	s_instance = nullptr;
+	// logger is destroyed before thread-locals of main thread
+	s_ring_owner.is_owned = nullptr;
+	for ( size_t i = 0 ; i < m_rings_count ; i++ ) {
+		delete m_rings[ i ];
+	}
+}
+
+void Stdout::Log( const base::log_level_t level, const std::string& text ) {
+	if ( base::Stats::IsSuppressed() ) { // don't spam from debug overlay
+		return;
+	}
+
+	const char* prefix = s_level_prefixes[ level ];
+	const uint32_t prefix_len = strlen( prefix );
+	// very long messages are truncated to fit into ring
+	const uint32_t text_len = std::min< size_t >( text.size(), RING_SIZE / 2 );
+	const uint32_t len = prefix_len + text_len;
+	const size_t record_size = sizeof( len ) + len;
+
+	auto* ring = GetCurrentRing();
+	const size_t head = ring->head.load( std::memory_order_relaxed );
+	while ( RING_SIZE - ( head - ring->tail.load( std::memory_order_acquire ) ) < record_size ) {
+		// full, wait for writer
+		m_writer_condition.notify_one();
+		std::this_thread::yield();
+	}
+
+	const auto f_put = [ ring ]( size_t pos, const char* data, const size_t size ) -> void {
+		const size_t offset = pos % RING_SIZE;
+		const size_t first = std::min( size, RING_SIZE - offset );
+		memcpy( ring->data + offset, data, first );
+		if ( first < size ) {
+			memcpy( ring->data, data + first, size - first );
+		}
+	};
+	f_put( head, (const char*)&len, sizeof( len ) );
+	f_put( head + sizeof( len ), prefix, prefix_len );
+	f_put( head + sizeof( len ) + prefix_len, text.data(), text_len );
+	ring->head.store( head + record_size, std::memory_order_release );
+}
+
+void Stdout::Flush() {
+	Write();
+}
+
+Stdout::ring_t* Stdout::GetCurrentRing() {
+	if ( !s_current_ring ) {
+		ring_t* ring = nullptr;
+		std::lock_guard< std::mutex > guard( m_rings_mutex );
+		const size_t rings_count = m_rings_count.load( std::memory_order_relaxed );
+		for ( size_t i = 0 ; i < rings_count ; i++ ) {
+			bool is_owned = false;
+			if ( m_rings[ i ]->is_owned.compare_exchange_strong( is_owned, true ) ) {
+				ring = m_rings[ i ];
+				break;
+			}
+		}
+		if ( !ring ) {
+			if ( rings_count == MAX_RINGS ) {
+				THROW( "too many logging threads" );
+			}
+			ring = new ring_t;
+			m_rings[ rings_count ] = ring;
+			// crash handler only looks at rings below count
+			m_rings_count.store( rings_count + 1, std::memory_order_release );
+		}
+		s_current_ring = ring;
+		s_ring_owner.is_owned = &ring->is_owned;
+	}
+	return (ring_t*)s_current_ring;
+}
+
+void Stdout::WriterLoop() {
+	while ( !m_is_stopping ) {
+		if ( !Write() ) {
+			std::unique_lock< std::mutex > lock( m_writer_mutex );
+			// producers don't notify on every message, so it's polling with small interval
+			m_writer_condition.wait_for(
+				lock, std::chrono::milliseconds( 10 ), [ this ]() -> bool {
+					return m_is_stopping;
+				}
+			);
+		}
+	}
+}
+
+const bool Stdout::Write() {
+	std::lock_guard< std::mutex > guard( m_write_mutex );
+	std::string output = "";
+	const size_t rings_count = m_rings_count.load( std::memory_order_acquire );
+	for ( size_t i = 0 ; i < rings_count ; i++ ) {
+		DrainRing(
+			m_rings[ i ], [ &output ]( const char* data, const size_t size ) -> void {
+				output.append( data, size );
+				output += '\n';
+			}
+		);
+	}
+	if ( output.empty() ) {
+		return false;
+	}
+	fwrite( output.data(), 1, output.size(), stdout );
+	fflush( stdout );
+	return true;
+}
+
+template< typename OUTPUT >
+const bool Stdout::DrainRing( ring_t* ring, const OUTPUT& f_output ) {
+	if ( ring->is_draining.exchange( true, std::memory_order_acquire ) ) {
+		return false;
+	}
+	const size_t head = ring->head.load( std::memory_order_acquire );
+	size_t tail = ring->tail.load( std::memory_order_relaxed );
+	const auto f_get = [ ring ]( size_t pos, char* data, const size_t size ) -> void {
+		const size_t offset = pos % RING_SIZE;
+		const size_t first = std::min( size, RING_SIZE - offset );
+		memcpy( data, ring->data + offset, first );
+		if ( first < size ) {
+			memcpy( data + first, ring->data, size - first );
+		}
+	};
+	const bool has_messages = tail != head;
+	while ( tail != head ) {
+		uint32_t len;
+		f_get( tail, (char*)&len, sizeof( len ) );
+		const size_t offset = ( tail + sizeof( len ) ) % RING_SIZE;
+		const size_t first = std::min< size_t >( len, RING_SIZE - offset );
+		// message can wrap around end of ring
+		f_output( ring->data + offset, first );
+		if ( first < len ) {
+			f_output( ring->data, len - first );
+		}
+		tail += sizeof( len ) + len;
+	}
+	ring->tail.store( tail, std::memory_order_release );
+	ring->is_draining.store( false, std::memory_order_release );
+	return has_messages;
+}
+
+void Stdout::OnCrash( int signal_number ) {
+	// only async-signal-safe things here: no allocations, no locks, no stdio
+	// rings that writer thread is draining right now are skipped (writer will most likely finish them before process dies)
+	if ( s_instance ) {
+		size_t used = 0;
+		const auto f_flush = [ &used ]() -> void {
+			WriteToStdout( s_crash_buffer, used );
+			used = 0;
+		};
+		const auto f_output = [ &used, &f_flush ]( const char* data, size_t size ) -> void {
+			while ( size > 0 ) {
+				if ( used == sizeof( s_crash_buffer ) ) {
+					f_flush();
+				}
+				const size_t chunk = std::min( size, sizeof( s_crash_buffer ) - used );
+				memcpy( s_crash_buffer + used, data, chunk );
+				used += chunk;
+				data += chunk;
+				size -= chunk;
+			}
+		};
+		const size_t rings_count = s_instance->m_rings_count.load( std::memory_order_acquire );
+		for ( size_t i = 0 ; i < rings_count ; i++ ) {
+			DrainRing(
+				s_instance->m_rings[ i ], [ &f_output ]( const char* data, const size_t size ) -> void {
+					f_output( data, size );
+					f_output( "\n", 1 );
+				}
+			);
+		}
+		f_flush();
+	}
+	std::signal( signal_number, SIG_DFL );
+	std::raise( signal_number );
+}
 
 } /* namespace logger */
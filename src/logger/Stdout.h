@@ -1,21 +1,61 @@
 #pragma once
 
 #include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
 
 #include "Logger.h"
 
 namespace logger {
 
+// every thread formats messages into it's own ring buffer, background thread writes them out in batches
+// so that logging thread never waits for stdout (unless it's ring is full)
 CLASS( Stdout, Logger )
 
-#ifdef DEBUG
-
-	void Log( const std::string& text ) override;
-	std::mutex m_log_mutex;
-
-#else
-	void Log( const std::string &text ) override {}
-#endif
+	Stdout();
+	~Stdout();
+
+	void Log( const base::log_level_t level, const std::string& text ) override;
+	void Flush() override;
+
+private:
+
+	static const size_t RING_SIZE = 1 << 16;
+
+	// one producer (owner thread) and one consumer (whoever is writing)
+	struct ring_t {
+		std::atomic< size_t > head = 0;
+		std::atomic< size_t > tail = 0;
+		// released when owner thread exits, can be reused by new thread
+		std::atomic< bool > is_owned = true;
+		// set by whoever consumes, so that crash handler never reads ring that writer is in the middle of
+		std::atomic< bool > is_draining = false;
+		char data[ RING_SIZE ];
+	};
+
+	// fixed array so that crash handler can walk it without locks (rings are reused, so there are only as many as threads)
+	static const size_t MAX_RINGS = 256;
+	std::mutex m_rings_mutex; // for adding rings
+	ring_t* m_rings[ MAX_RINGS ] = {};
+	std::atomic< size_t > m_rings_count = 0;
+	ring_t* GetCurrentRing();
+
+	std::thread m_writer_thread;
+	std::atomic< bool > m_is_stopping = false;
+	std::mutex m_writer_mutex;
+	std::condition_variable m_writer_condition;
+	void WriterLoop();
+
+	// only one writer at a time
+	std::mutex m_write_mutex;
+	// writes everything that is in rings, returns false if there was nothing
+	const bool Write();
+	// passes every message of ring (without newline) to f_output, skips ring if someone else is draining it
+	template< typename OUTPUT >
+	static const bool DrainRing( ring_t* ring, const OUTPUT& f_output );
+
+	static void OnCrash( int signal_number );
 
 };
 
@@ -26,6 +26,7 @@
 
 #include "input/sdl2/SDL2.h"
 #include "graphics/opengl/OpenGL.h"
+#include "graphics/null/Null.h"
 #include "audio/sdl2/SDL2.h"
 #include "network/simpletcp/SimpleTCP.h"
 
@@ -42,6 +43,7 @@
 
 #include "task/intro/Intro.h"
 #include "task/mainmenu/MainMenu.h"
+#include "task/benchmark/Benchmark.h"
 
 #include "game/Game.h"
 
@@ -65,6 +67,7 @@
 #include "util/FS.h"
 #include "debug/MemoryWatcher.h"
 #include "debug/DebugOverlay.h"
+#include "types/Matrix44.h"
 
 using namespace util;
 #endif
@@ -84,6 +87,11 @@ int main( const int argc, const char* argv[] ) {
 
 	config::Config config( argc, argv );
 
+	if ( config.HasLaunchFlag( config::Config::LF_ALLOC_PROFILE ) ) {
+		// as early as possible so that long-living allocations are sampled too
+		base::AllocationProfiler::Start( config.GetAllocProfileSampleRate() );
+	}
+
 #ifdef DEBUG
 	if ( config.HasDebugFlag( config::Config::DF_GDB ) ) {
 #ifdef __linux__
@@ -117,6 +125,15 @@ int main( const int argc, const char* argv[] ) {
 #endif
 	}
 	debug::MemoryWatcher memory_watcher( config.HasDebugFlag( config::Config::DF_MEMORYDEBUG ) );
+	if ( config.HasDebugFlag( config::Config::DF_MATHCHECK ) ) {
+		const std::string error = types::Matrix44::SelfCheck();
+		if ( !error.empty() ) {
+			cout << "Matrix math check failed: " << error << endl;
+			exit( EXIT_FAILURE );
+		}
+		cout << "Matrix math check passed" << endl;
+		exit( EXIT_SUCCESS );
+	}
 #endif
 
 #ifdef DEBUG
@@ -127,6 +144,9 @@ int main( const int argc, const char* argv[] ) {
 
 	// logger needs to be outside of scope to be destroyed last
 	logger::Stdout logger;
+	logger.SetMinLevel( config.GetLogLevel() );
+	// graphics is chosen at runtime, it must be destroyed after everything that uses it
+	graphics::Graphics* graphics = nullptr;
 	{
 
 #ifdef _WIN32
@@ -167,7 +187,12 @@ int main( const int argc, const char* argv[] ) {
 		if ( config.HasLaunchFlag( config::Config::LF_WINDOWED ) ) {
 			start_fullscreen = false;
 		}
-		graphics::opengl::OpenGL graphics( title, window_size.x, window_size.y, vsync, start_fullscreen );
+		if ( config.HasLaunchFlag( config::Config::LF_HEADLESS ) ) {
+			NEW( graphics, graphics::null::Null, window_size.x, window_size.y );
+		}
+		else {
+			NEW( graphics, graphics::opengl::OpenGL, title, window_size.x, window_size.y, vsync, start_fullscreen );
+		}
 		audio::sdl2::SDL2 audio;
 		network::simpletcp::SimpleTCP network;
 
@@ -197,7 +222,10 @@ int main( const int argc, const char* argv[] ) {
 		}
 		else
 #endif
-		if ( config.HasLaunchFlag( config::Config::LF_SKIPINTRO ) ) {
+		if ( config.HasLaunchFlag( config::Config::LF_BENCHMARK_SCENARIO ) ) {
+			NEW( task, task::benchmark::Benchmark );
+		}
+		else if ( config.HasLaunchFlag( config::Config::LF_SKIPINTRO ) ) {
 			NEW( task, task::mainmenu::MainMenu );
 		}
 		else {
@@ -215,7 +243,7 @@ int main( const int argc, const char* argv[] ) {
 			&sound_loader,
 			&scheduler,
 			&input,
-			&graphics,
+			graphics,
 			&audio,
 			&network,
 			&ui,
@@ -224,6 +252,7 @@ int main( const int argc, const char* argv[] ) {
 
 		result = engine.Run();
 	}
+	DELETE( graphics );
 
 	return result;
 }
@@ -253,7 +253,7 @@ MT_Response SimpleTCP::Disconnect() {
 MT_Response SimpleTCP::DisconnectClient( const size_t cid ) {
 
 	if ( GetCurrentConnectionMode() != CM_SERVER ) {
-		Log( "WARNING: DisconnectClient() on non-server" );
+		Log( LL_WARNING, "DisconnectClient() on non-server" );
 		return Success();
 	}
 
@@ -276,7 +276,7 @@ void SimpleTCP::ProcessEvents() {
 				Log( "Packet event ( cid = " + std::to_string( event.cid ) + " )" );
 				if ( event.cid ) { // presence of cid means we are server
 					if ( GetCurrentConnectionMode() != CM_SERVER ) {
-						Log( "WARNING: got non-zero cid in packet while not being server, ignoring" );
+						Log( LL_WARNING, "got non-zero cid in packet while not being server, ignoring" );
 						break;
 					}
 					m_tmp.tmpint = 0;
@@ -468,9 +468,13 @@ bool SimpleTCP::ReadFromSocket( remote_socket_data_t& socket ) {
 		}
 	}
 
+	if ( m_tmp.tmpint2 > 0 ) {
+		STAT_CHANGE_BY( network_bytes_received, m_tmp.tmpint2 );
+	}
+
 	if ( m_tmp.tmpint2 > 0 ) {
 
-		Log( "Read " + std::to_string( m_tmp.tmpint2 ) + " bytes into buffer " + std::to_string( (long long)socket.buffer.ptr ) + " (size=" + std::to_string( socket.buffer.len ) + ")" );
+		LOG_RATE_LIMITED( LL_DEBUG, 10, "Read " + std::to_string( m_tmp.tmpint2 ) + " bytes into buffer " + std::to_string( (long long)socket.buffer.ptr ) + " (size=" + std::to_string( socket.buffer.len ) + ")" );
 
 		socket.last_data_at = m_tmp.now;
 		socket.ping_needed = false;
@@ -517,6 +521,7 @@ bool SimpleTCP::ReadFromSocket( remote_socket_data_t& socket ) {
 
 		{
 			//Log( "Read packet (" + std::to_string( m_tmp.tmpint ) + " bytes)" );
+			STAT_INC( network_packets_received );
 			m_tmp.event.Clear();
 			m_tmp.event.cid = socket.cid;
 			m_tmp.event.data.remote_address = socket.remote_address;
@@ -527,11 +532,11 @@ bool SimpleTCP::ReadFromSocket( remote_socket_data_t& socket ) {
 				// quick hack to respond to pings without escalating events outside
 				// TODO: refactor
 				if ( p.type == Packet::PT_PING ) {
-					Log( "Ping received" );
+					LOG_RATE_LIMITED( LL_DEBUG, 1, "Ping received" );
 					socket.pong_needed = true;
 				}
 				else if ( p.type == Packet::PT_PONG ) {
-					Log( "Pong received" );
+					LOG_RATE_LIMITED( LL_DEBUG, 1, "Pong received" );
 					socket.ping_sent = false;
 				}
 				else {
@@ -548,7 +553,7 @@ bool SimpleTCP::ReadFromSocket( remote_socket_data_t& socket ) {
 
 		}
 
-		Log( "Processed " + std::to_string( m_tmp.tmpint2 ) + " bytes" );
+		LOG_RATE_LIMITED( LL_DEBUG, 10, "Processed " + std::to_string( m_tmp.tmpint2 ) + " bytes" );
 
 		if ( m_tmp.tmpint2 > 0 ) {
 			ASSERT( socket.buffer.len >= m_tmp.tmpint2, "processed more than total" );
@@ -602,6 +607,8 @@ bool SimpleTCP::WriteToSocket( int fd, const std::string& data ) {
 		return false;
 	}
 	//Log( "Write successful" );
+	STAT_INC( network_packets_sent );
+	STAT_CHANGE_BY( network_bytes_sent, sizeof( m_tmp.tmpint2 ) + data.size() );
 	return true;
 }
 
@@ -609,7 +616,7 @@ bool SimpleTCP::MaybePing( remote_socket_data_t& socket ) {
 	m_tmp.time = m_tmp.now - socket.last_data_at;
 
 	if ( m_tmp.time > SEND_PING_AFTER && !socket.ping_sent ) {
-		Log( "Need ping" );
+		LOG_RATE_LIMITED( LL_DEBUG, 1, "Need ping" );
 		socket.ping_needed = true;
 	}
 
@@ -626,7 +633,7 @@ bool SimpleTCP::MaybePingDo( remote_socket_data_t& socket ) {
 	}
 
 	if ( socket.ping_needed && !socket.ping_sent ) {
-		Log( "Sending ping to " + std::to_string( socket.fd ) + " (cid " + std::to_string( socket.cid ) + ")" );
+		LOG_RATE_LIMITED( LL_DEBUG, 1, "Sending ping to " + std::to_string( socket.fd ) + " (cid " + std::to_string( socket.cid ) + ")" );
 		Packet packet( Packet::PT_PING );
 		std::string data = packet.Serialize().ToString();
 		socket.ping_sent = true;
@@ -65,7 +65,7 @@ void Entity::UpdatePosition() {
 }
 
 void Entity::UpdateMatrix() {
-	m_matrices.matrix = m_matrices.translate * m_matrices.rotate * m_matrices.scale;
+	m_matrices.matrix.TransformTRS( m_position, m_matrices.rotate, m_matrices.scale ); // same as translate * rotate * scale
 }
 
 types::Matrix44& Entity::GetMatrix() {
@@ -1,14 +1,21 @@
+#include <cstring>
+#include <atomic>
+
 #include "Instanced.h"
 
 namespace scene {
 namespace actor {
 
+// shared by all instanced actors, see InstanceMatricesUpdatedCount()
+static std::atomic< size_t > s_instance_matrices_update_counter = 0;
+
 Instanced::Instanced( Actor* actor )
 	: Actor(
 	( type_t )( (uint8_t)actor->GetType() + 1 ), // assume normal type is always followed by instanced type
 	"Instanced" + actor->GetLocalName()
 )
-	, m_actor( actor ) {
+	, m_actor( actor )
+	, m_instance_matrices_update_counter( ++s_instance_matrices_update_counter ) {
 	//
 }
 
@@ -55,45 +62,254 @@ _XYZ_SETTER( Position, position, UpdatePosition(); )
 #undef _XYZ_ASSERT
 
 const Instanced::matrices_t& Instanced::GetInstanceMatrices() {
-	if ( m_need_world_matrix_update ) {
-		//Log( "Updating world matrices" );
-		UpdateWorldMatrix();
+	if ( ( m_need_world_matrix_update || m_need_culling_update ) && m_scene ) {
+		auto* camera = m_scene->GetCamera();
+		if ( camera ) {
+			const bool is_culling_enabled = GetVisibleGridAreas( camera, &m_culling.visible_areas );
+			// camera moves within already collected areas don't need anything to be regenerated
+			if (
+				m_need_world_matrix_update ||
+					is_culling_enabled != m_culling.is_enabled ||
+					( is_culling_enabled && !AreGridAreasWithin( m_culling.visible_areas, m_culling.collected_areas ) )
+				) {
+				//Log( "Updating world matrices" );
+				if ( is_culling_enabled ) {
+					m_culling.collected_areas = m_culling.visible_areas;
+					for ( auto& area : m_culling.collected_areas ) {
+						area.first.first -= CULLING_GRID_MARGIN;
+						area.first.second -= CULLING_GRID_MARGIN;
+						area.second.first += CULLING_GRID_MARGIN;
+						area.second.second += CULLING_GRID_MARGIN;
+					}
+				}
+				m_culling.is_enabled = is_culling_enabled;
+				m_previous_instance_matrices.swap( m_instance_matrices );
+				CollectInstanceMatrices(
+					is_culling_enabled
+						? &m_culling.collected_areas
+						: nullptr, &m_instance_matrices, &m_culled_instances_count
+				);
+				AddUpdatedInstanceRanges( m_previous_instance_matrices, m_instance_matrices );
+			}
+			m_need_world_matrix_update = false;
+			m_need_culling_update = false;
+		}
 	}
 	return m_instance_matrices;
 }
 
+const size_t Instanced::GetCulledInstancesCount() const {
+	return m_culled_instances_count;
+}
+
+const size_t Instanced::InstanceMatricesUpdatedCount() const {
+	return m_instance_matrices_update_counter;
+}
+
+void Instanced::TakeUpdatedInstanceRanges( types::mesh::Mesh::updated_ranges_t* ranges ) {
+	ranges->clear();
+	m_updated_instance_ranges.swap( *ranges );
+}
+
+void Instanced::AddUpdatedInstanceRanges( const matrices_t& old_matrices, const matrices_t& new_matrices ) {
+	if ( old_matrices.size() != new_matrices.size() ) {
+		// buffer will be reallocated anyway
+		m_updated_instance_ranges.clear();
+		types::mesh::Mesh::AddUpdatedRange( m_updated_instance_ranges, 0, new_matrices.size() );
+		m_instance_matrices_update_counter = ++s_instance_matrices_update_counter;
+		return;
+	}
+	// same instances mostly stay at same positions, so usually only few short ranges differ
+	bool is_changed = false;
+	bool is_any_changed = false;
+	size_t begin = 0;
+	for ( size_t i = 0 ; i <= new_matrices.size() ; i++ ) {
+		const bool is_different = i < new_matrices.size() && memcmp( &old_matrices[ i ], &new_matrices[ i ], sizeof( types::Matrix44 ) );
+		if ( is_different && !is_changed ) {
+			begin = i;
+			is_changed = true;
+		}
+		else if ( !is_different && is_changed ) {
+			types::mesh::Mesh::AddUpdatedRange( m_updated_instance_ranges, begin, i );
+			is_changed = false;
+			is_any_changed = true;
+		}
+	}
+	if ( is_any_changed ) {
+		m_instance_matrices_update_counter = ++s_instance_matrices_update_counter;
+	}
+}
+
 types::Matrix44& Instanced::GetWorldMatrix() {
 	ASSERT( false, "use GetInstanceMatrices() for instanced actors" );
 	return m_actor_matrices.world; // just to fix warning
 }
 
-void Instanced::GenerateInstanceMatrices( matrices_t* out_matrices, scene::Camera* camera ) {
+void Instanced::GenerateInstanceMatrices( matrices_t* out_matrices, scene::Camera* camera, size_t* out_culled_count ) {
+	grid_areas_t areas;
+	CollectInstanceMatrices(
+		GetVisibleGridAreas( camera, &areas )
+			? &areas
+			: nullptr, out_matrices, out_culled_count
+	);
+}
+
+void Instanced::UpdateWorldMatrix() {
+	// instance matrices don't depend on camera (it's applied by shader), only set of visible instances may change
+	m_need_culling_update = true;
+}
+
+const bool Instanced::GetVisibleGridAreas( scene::Camera* camera, grid_areas_t* out_areas ) {
+	const auto& cm = camera->GetMatrix().m;
+	if (
+		cm[ 3 ][ 0 ] != 0.0f || cm[ 3 ][ 1 ] != 0.0f || cm[ 3 ][ 2 ] != 0.0f || cm[ 3 ][ 3 ] != 1.0f || // only affine (orthographic) cameras are supported
+			m_grid.cells.empty() ||
+			!UpdateBounds()
+		) {
+		return false;
+	}
+
+	// instance is visible if its bounding box, transformed by camera, overlaps clip space cube
+	// rotation and scale are same for all instances, so box center offset and half-extents in clip space are same too
+	const auto& rs = GetRotateScaleMatrix();
+	const float center[ 3 ] = {
+		( m_bounds.min.x + m_bounds.max.x ) / 2,
+		( m_bounds.min.y + m_bounds.max.y ) / 2,
+		( m_bounds.min.z + m_bounds.max.z ) / 2,
+	};
+	const float extent[ 3 ] = {
+		( m_bounds.max.x - m_bounds.min.x ) / 2,
+		( m_bounds.max.y - m_bounds.min.y ) / 2,
+		( m_bounds.max.z - m_bounds.min.z ) / 2,
+	};
+	float offset[ 2 ];
+	float limit[ 2 ];
+	for ( uint8_t r = 0 ; r < 2 ; r++ ) {
+		offset[ r ] = cm[ r ][ 3 ];
+		limit[ r ] = 1.0f;
+		for ( uint8_t c = 0 ; c < 3 ; c++ ) {
+			const float k = cm[ r ][ 0 ] * rs.m[ 0 ][ c ] + cm[ r ][ 1 ] * rs.m[ 1 ][ c ] + cm[ r ][ 2 ] * rs.m[ 2 ][ c ];
+			offset[ r ] += k * center[ c ];
+			limit[ r ] += fabs( k ) * extent[ c ];
+		}
+	}
+
+	// project corners of clip space rectangle back to xy plane at lowest and highest instance z
+	const float det = cm[ 0 ][ 0 ] * cm[ 1 ][ 1 ] - cm[ 0 ][ 1 ] * cm[ 1 ][ 0 ];
+	if ( det == 0.0f ) {
+		return false;
+	}
+
+	const auto& world_instance_positions = m_scene->GetWorldInstancePositions();
+	out_areas->resize( world_instance_positions.size() );
+	for ( size_t i = 0 ; i < world_instance_positions.size() ; i++ ) {
+		const auto& world_position = world_instance_positions[ i ];
+		float min_x = INFINITY;
+		float min_y = INFINITY;
+		float max_x = -INFINITY;
+		float max_y = -INFINITY;
+		for ( const float z : { m_grid.min_z + world_position.z, m_grid.max_z + world_position.z } ) {
+			for ( const float sx : { -limit[ 0 ], limit[ 0 ] } ) {
+				for ( const float sy : { -limit[ 1 ], limit[ 1 ] } ) {
+					const float bx = sx - cm[ 0 ][ 2 ] * z - offset[ 0 ];
+					const float by = sy - cm[ 1 ][ 2 ] * z - offset[ 1 ];
+					const float x = ( bx * cm[ 1 ][ 1 ] - by * cm[ 0 ][ 1 ] ) / det - world_position.x;
+					const float y = ( by * cm[ 0 ][ 0 ] - bx * cm[ 1 ][ 0 ] ) / det - world_position.y;
+					min_x = std::min( min_x, x );
+					min_y = std::min( min_y, y );
+					max_x = std::max( max_x, x );
+					max_y = std::max( max_y, y );
+				}
+			}
+		}
+		( *out_areas )[ i ] = {
+			{
+				floorf( min_x / CULLING_GRID_CELL_SIZE ),
+				floorf( min_y / CULLING_GRID_CELL_SIZE )
+			},
+			{
+				floorf( max_x / CULLING_GRID_CELL_SIZE ),
+				floorf( max_y / CULLING_GRID_CELL_SIZE )
+			}
+		};
+	}
+	return true;
+}
+
+const bool Instanced::AreGridAreasWithin( const grid_areas_t& areas, const grid_areas_t& outer_areas ) const {
+	if ( areas.size() != outer_areas.size() ) {
+		return false;
+	}
+	for ( size_t i = 0 ; i < areas.size() ; i++ ) {
+		const auto& a = areas[ i ];
+		const auto& o = outer_areas[ i ];
+		if (
+			a.first.first < o.first.first ||
+				a.first.second < o.first.second ||
+				a.second.first > o.second.first ||
+				a.second.second > o.second.second
+			) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void Instanced::CollectInstanceMatrices( const grid_areas_t* areas, matrices_t* out_matrices, size_t* out_culled_count ) {
 	const auto& world_instance_positions = m_scene->GetWorldInstancePositions();
-	out_matrices->resize( world_instance_positions.size() * m_instances.size() );
-	size_t i = 0;
+	const size_t total = world_instance_positions.size() * m_instances.size();
+	out_matrices->clear();
 
 	// SPAMMY
 	//Log( "Updating " + std::to_string( m_instances.size() ) + " instances" );
 
-	for ( auto& id_instance : m_instances ) {
-		auto& instance = id_instance.second;
-		if ( instance.need_update ) {
-			UpdateInstance( instance );
+	if ( !areas ) {
+		// can't cull, draw everything
+		out_matrices->reserve( total );
+		for ( auto& id_instance : m_instances ) {
+			auto& instance = id_instance.second;
+			if ( instance.need_update ) {
+				UpdateInstance( instance );
+			}
+			out_matrices->insert( out_matrices->end(), instance.matrices.begin(), instance.matrices.end() );
 		}
-		for ( auto& matrices : instance.matrices ) {
-			( *out_matrices )[ i ] = matrices.matrix;
-			i++;
+	}
+	else {
+		ASSERT( areas->size() == world_instance_positions.size(), "grid areas count mismatch" );
+		for ( size_t i = 0 ; i < areas->size() ; i++ ) {
+			const auto& area = ( *areas )[ i ];
+			const grid_cell_t from = {
+				std::max( area.first.first, m_grid.min.first ),
+				std::max( area.first.second, m_grid.min.second )
+			};
+			const grid_cell_t to = {
+				std::min( area.second.first, m_grid.max.first ),
+				std::min( area.second.second, m_grid.max.second )
+			};
+			for ( ssize_t cy = from.second ; cy <= to.second ; cy++ ) {
+				for ( ssize_t cx = from.first ; cx <= to.first ; cx++ ) {
+					const auto it = m_grid.cells.find(
+						{
+							cx,
+							cy
+						}
+					);
+					if ( it == m_grid.cells.end() ) {
+						continue;
+					}
+					for ( auto* instance : it->second ) {
+						if ( instance->need_update ) {
+							UpdateInstance( *instance );
+						}
+						out_matrices->push_back( instance->matrices[ i ] );
+					}
+				}
+			}
 		}
 	}
-}
 
-void Instanced::UpdateWorldMatrix() {
-	if ( m_scene && m_need_world_matrix_update ) {
-		auto* camera = m_scene->GetCamera();
-		if ( camera ) {
-			GenerateInstanceMatrices( &m_instance_matrices, camera );
-			m_need_world_matrix_update = false;
-		}
+	if ( out_culled_count ) {
+		*out_culled_count = total - out_matrices->size();
 	}
 }
 
@@ -105,9 +321,18 @@ void Instanced::UpdateMatrix() {
 	for ( auto& instance : m_instances ) {
 		instance.second.need_update = true;
 	}
+	m_need_rotate_scale_matrix_update = true;
 	m_need_world_matrix_update = true;
 }
 
+const types::Matrix44& Instanced::GetRotateScaleMatrix() {
+	if ( m_need_rotate_scale_matrix_update ) {
+		m_rotate_scale_matrix = m_matrices.rotate * m_matrices.scale; // TODO: per-instance rotate and scale too
+		m_need_rotate_scale_matrix_update = false;
+	}
+	return m_rotate_scale_matrix;
+}
+
 const scene::Scene::instance_positions_t* Instanced::GetWorldInstancePositions() {
 	if ( m_scene ) {
 		return &m_scene->GetWorldInstancePositions();
@@ -117,23 +342,16 @@ const scene::Scene::instance_positions_t* Instanced::GetWorldInstancePositions()
 
 void Instanced::UpdateInstance( instance_t& instance ) {
 	const auto& world_instance_positions = GetWorldInstancePositions();
-	const size_t sz = world_instance_positions->size();
 	instance.matrices.resize( world_instance_positions->size() );
 	//Log( "Updating for " + std::to_string( world_instance_positions->size() ) + " world instances" );
-	for ( size_t i = 0 ; i < sz ; i++ ) {
-		auto& matrices = instance.matrices[ i ];
-		auto& world_position = ( *world_instance_positions )[ i ];
-		matrices.translate.TransformTranslate(
-			instance.position.x + world_position.x,
-			instance.position.y + world_position.y,
-			instance.position.z + world_position.z
-		);
-		matrices.matrix =
-			matrices.translate *
-				m_matrices.rotate *
-				m_matrices.scale; // TODO: per-instance rotate and scale too
-	}
-
+	// translate * rotate * scale for every world instance, only translation differs
+	types::Matrix44::TranslateBatch(
+		GetRotateScaleMatrix(),
+		instance.position,
+		world_instance_positions->data(),
+		world_instance_positions->size(),
+		instance.matrices.data()
+	);
 	instance.need_update = false;
 }
 
@@ -148,39 +366,147 @@ Mesh* Instanced::GetMeshActor() const {
 }
 
 const Instanced::instance_id_t Instanced::AddInstance( const types::Vec3& position, const types::Vec3& angle ) {
-	m_instances[ m_next_instance_id ] = {
-		position,
-		angle,
-		{},
-		true
-	};
-	m_need_world_matrix_update = true;
+	SetInstanceData( m_next_instance_id, position, angle );
 	return m_next_instance_id++;
 }
 
 void Instanced::SetInstance( const instance_id_t instance_id, const types::Vec3& position, const types::Vec3& angle ) {
-	m_need_world_matrix_update = true;
-	m_instances[ instance_id ] = {
-		position,
-		angle,
-		{},
-		true
-	};
+	SetInstanceData( instance_id, position, angle );
 	if ( m_next_instance_id <= instance_id ) {
 		m_next_instance_id = instance_id + 1;
 	}
 }
 
 void Instanced::RemoveInstance( const instance_id_t instance_id ) {
-	ASSERT( m_instances.find( instance_id ) != m_instances.end(), "instance " + std::to_string( instance_id ) + " not found" );
+	const auto it = m_instances.find( instance_id );
+	ASSERT( it != m_instances.end(), "instance " + std::to_string( instance_id ) + " not found" );
 	m_need_world_matrix_update = true;
-	m_instances.erase( instance_id );
+	RemoveFromGrid( &it->second );
+	m_instances.erase( it );
 }
 
 const bool Instanced::HasInstance( const instance_id_t instance_id ) {
 	return m_instances.find( instance_id ) != m_instances.end();
 }
 
+void Instanced::SetInstanceData( const instance_id_t instance_id, const types::Vec3& position, const types::Vec3& angle ) {
+	auto it = m_instances.find( instance_id );
+	if ( it == m_instances.end() ) {
+		it = m_instances.insert(
+			{
+				instance_id,
+				{}
+			}
+		).first;
+	}
+	else {
+		RemoveFromGrid( &it->second );
+	}
+	it->second = {
+		position,
+		angle,
+		{},
+		true,
+		{}
+	};
+	AddToGrid( &it->second ); // elements of unordered_map don't move, so pointer stays valid until erased
+	m_need_world_matrix_update = true;
+}
+
+void Instanced::AddToGrid( instance_t* instance ) {
+	const grid_cell_t cell = {
+		floorf( instance->position.x / CULLING_GRID_CELL_SIZE ),
+		floorf( instance->position.y / CULLING_GRID_CELL_SIZE )
+	};
+	instance->grid_cell = cell;
+	if ( m_grid.cells.empty() ) {
+		m_grid.min = m_grid.max = cell;
+		m_grid.min_z = m_grid.max_z = instance->position.z;
+	}
+	else {
+		m_grid.min = {
+			std::min( m_grid.min.first, cell.first ),
+			std::min( m_grid.min.second, cell.second )
+		};
+		m_grid.max = {
+			std::max( m_grid.max.first, cell.first ),
+			std::max( m_grid.max.second, cell.second )
+		};
+		m_grid.min_z = std::min( m_grid.min_z, instance->position.z );
+		m_grid.max_z = std::max( m_grid.max_z, instance->position.z );
+	}
+	m_grid.cells[ cell ].push_back( instance );
+}
+
+void Instanced::RemoveFromGrid( instance_t* instance ) {
+	const auto it = m_grid.cells.find( instance->grid_cell );
+	ASSERT( it != m_grid.cells.end(), "instance grid cell not found" );
+	auto& instances = it->second;
+	for ( auto& i : instances ) {
+		if ( i == instance ) {
+			i = instances.back();
+			instances.pop_back();
+			break;
+		}
+	}
+	if ( instances.empty() ) {
+		m_grid.cells.erase( it );
+	}
+}
+
+const bool Instanced::UpdateBounds() {
+	switch ( m_type ) {
+		case TYPE_INSTANCED_SPRITE: {
+			if ( !m_bounds.is_valid ) {
+				const auto& dimensions = GetSpriteActor()->GetDimensions();
+				m_bounds.min = {
+					-dimensions.x / 2,
+					-dimensions.y / 2,
+					0.0f
+				};
+				m_bounds.max = {
+					dimensions.x / 2,
+					dimensions.y / 2,
+					0.0f
+				};
+				m_bounds.is_valid = true;
+			}
+			return true;
+		}
+		case TYPE_INSTANCED_MESH: {
+			const auto* mesh = GetMeshActor()->GetMesh();
+			if ( !mesh || !mesh->GetVertexCount() ) {
+				return false;
+			}
+			if ( !m_bounds.is_valid || m_bounds.mesh != mesh || m_bounds.mesh_updated_count != mesh->UpdatedCount() ) {
+				types::Vec3 coord;
+				mesh->GetVertexCoord( 0, &coord );
+				m_bounds.min = m_bounds.max = coord;
+				for ( types::mesh::Mesh::index_t i = 1 ; i < mesh->GetVertexCount() ; i++ ) {
+					mesh->GetVertexCoord( i, &coord );
+					m_bounds.min = {
+						std::min( m_bounds.min.x, coord.x ),
+						std::min( m_bounds.min.y, coord.y ),
+						std::min( m_bounds.min.z, coord.z )
+					};
+					m_bounds.max = {
+						std::max( m_bounds.max.x, coord.x ),
+						std::max( m_bounds.max.y, coord.y ),
+						std::max( m_bounds.max.z, coord.z )
+					};
+				}
+				m_bounds.mesh = mesh;
+				m_bounds.mesh_updated_count = mesh->UpdatedCount();
+				m_bounds.is_valid = true;
+			}
+			return true;
+		}
+		default: {
+			return false;
+		}
+	}
+}
+
 const float Instanced::GetZIndex() const {
 	return m_z_index;
 }
@@ -221,14 +547,12 @@ void Instanced::Unserialize( types::Buffer buf ) {
 
 	const size_t count = buf.ReadInt();
 	m_instances.clear();
+	m_grid.cells.clear();
 	for ( size_t i = 0 ; i < count ; i++ ) {
 		const auto id = buf.ReadInt();
-		m_instances[ id ] = {
-			buf.ReadVec3(),
-			buf.ReadVec3(),
-			{},
-			true
-		};
+		const auto position = buf.ReadVec3();
+		const auto angle = buf.ReadVec3();
+		SetInstanceData( id, position, angle );
 	}
 
 	m_next_instance_id = buf.ReadInt();
@@ -6,6 +6,7 @@
 #include "Actor.h"
 
 #include "types/Matrix44.h"
+#include "types/mesh/Mesh.h"
 #include "scene/Scene.h"
 #include "scene/Camera.h"
 
@@ -38,9 +39,17 @@ CLASS( Instanced, Actor )
 #undef _XYZ_SETTER
 
 	typedef std::vector< types::Matrix44 > matrices_t;
+	// returns matrices of instances (and their world copies) that are visible by scene camera
 	const matrices_t& GetInstanceMatrices();
+	// how many instances were skipped by last GetInstanceMatrices() because they were outside of camera view
+	const size_t GetCulledInstancesCount() const;
+	// changed every time GetInstanceMatrices() result changes, taken from global counter so that two actors never have same value
+	// (new actor can be allocated at address of deleted one, with same instances count)
+	const size_t InstanceMatricesUpdatedCount() const;
+	// moves out ranges (in matrices) that changed since last call, to be called by whoever uploads matrices somewhere
+	void TakeUpdatedInstanceRanges( types::mesh::Mesh::updated_ranges_t* ranges );
 	types::Matrix44& GetWorldMatrix() override;
-	void GenerateInstanceMatrices( matrices_t* out_matrices, scene::Camera* camera );
+	void GenerateInstanceMatrices( matrices_t* out_matrices, scene::Camera* camera, size_t* out_culled_count = nullptr );
 
 	void UpdateWorldMatrix() override;
 	void UpdatePosition() override;
@@ -81,22 +90,77 @@ private:
 	float m_z_index = 0.0f;
 
 	matrices_t m_instance_matrices = {};
-
-	struct instanced_matrices_t {
-		types::Matrix44 translate;
-		types::Matrix44 matrix;
-	};
+	matrices_t m_previous_instance_matrices = {}; // kept to find which ranges changed after collecting
+	size_t m_culled_instances_count = 0;
+	size_t m_instance_matrices_update_counter = 0;
+	types::mesh::Mesh::updated_ranges_t m_updated_instance_ranges = {};
+	void AddUpdatedInstanceRanges( const matrices_t& old_matrices, const matrices_t& new_matrices );
+
+	// rotate * scale, same for all instances
+	types::Matrix44 m_rotate_scale_matrix;
+	bool m_need_rotate_scale_matrix_update = true;
+	const types::Matrix44& GetRotateScaleMatrix();
+
+	// uniform grid over instance positions (x and y), to find instances visible by camera without checking all of them
+	// culling is done per cell, so that camera moves that stay within same cells cost nothing
+	static constexpr float CULLING_GRID_CELL_SIZE = 4.0f;
+	static constexpr ssize_t CULLING_GRID_MARGIN = 1; // extra cells collected around visible ones
+	typedef std::pair< ssize_t, ssize_t > grid_cell_t;
+	typedef std::pair< grid_cell_t, grid_cell_t > grid_area_t; // first and last cells, inclusive
+	typedef std::vector< grid_area_t > grid_areas_t; // one per world instance
 
 	typedef struct {
 		types::Vec3 position;
 		types::Vec3 angle;
-		std::vector< instanced_matrices_t > matrices;
+		matrices_t matrices; // one per world instance
 		bool need_update;
+		grid_cell_t grid_cell;
 	} instance_t;
 
 	instance_id_t m_next_instance_id = 0;
 	std::unordered_map< instance_id_t, instance_t > m_instances = {};
 
+	struct grid_cell_hash_t {
+		size_t operator()( const grid_cell_t& cell ) const {
+			return std::hash< ssize_t >()( cell.first ) ^ ( std::hash< ssize_t >()( cell.second ) << 1 );
+		}
+	};
+	struct {
+		std::unordered_map< grid_cell_t, std::vector< instance_t* >, grid_cell_hash_t > cells = {};
+		// grow-only, used to clamp queries
+		grid_cell_t min = {};
+		grid_cell_t max = {};
+		float min_z = 0.0f;
+		float max_z = 0.0f;
+	} m_grid;
+
+	struct {
+		bool is_enabled = false;
+		grid_areas_t visible_areas = {};
+		grid_areas_t collected_areas = {};
+	} m_culling;
+	bool m_need_culling_update = true;
+
+	// returns false if culling isn't possible with this camera
+	const bool GetVisibleGridAreas( scene::Camera* camera, grid_areas_t* out_areas );
+	const bool AreGridAreasWithin( const grid_areas_t& areas, const grid_areas_t& outer_areas ) const;
+	// collects matrices of instances within grid areas, or of all instances if areas are null
+	void CollectInstanceMatrices( const grid_areas_t* areas, matrices_t* out_matrices, size_t* out_culled_count );
+
+	void SetInstanceData( const instance_id_t instance_id, const types::Vec3& position, const types::Vec3& angle );
+	void AddToGrid( instance_t* instance );
+	void RemoveFromGrid( instance_t* instance );
+
+	// local bounds of underlying sprite or mesh, used for culling
+	struct {
+		bool is_valid = false;
+		const types::mesh::Mesh* mesh = nullptr;
+		size_t mesh_updated_count = 0;
+		types::Vec3 min = {};
+		types::Vec3 max = {};
+	} m_bounds;
+	const bool UpdateBounds();
+
 	const scene::Scene::instance_positions_t* GetWorldInstancePositions();
 
 	void UpdateInstance( instance_t& instance );
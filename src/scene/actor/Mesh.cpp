@@ -6,7 +6,7 @@
 namespace scene {
 namespace actor {
 
-Mesh::Mesh( const std::string& name, const mesh::Mesh* mesh, const type_t type )
+Mesh::Mesh( const std::string& name, mesh::Mesh* mesh, const type_t type )
 	: Actor( type, name )
 	, m_mesh( mesh ) {
 	//
@@ -21,7 +21,7 @@ Mesh::~Mesh() {
 	}
 }
 
-void Mesh::SetMesh( const mesh::Mesh* mesh ) {
+void Mesh::SetMesh( mesh::Mesh* mesh ) {
 	ASSERT( !m_mesh, "mesh already set" );
 	m_mesh = mesh;
 }
@@ -31,6 +31,11 @@ const mesh::Mesh* Mesh::GetMesh() const {
 	return m_mesh;
 }
 
+mesh::Mesh* Mesh::GetMesh() {
+	ASSERT( m_mesh, "mesh not set" );
+	return m_mesh;
+}
+
 void Mesh::SetTintColor( const Color tint_color ) {
 	m_render_flags |= RF_USE_TINT;
 	m_tint_color = tint_color;
@@ -44,6 +49,10 @@ const mesh::Data* Mesh::GetDataMesh() const {
 	return m_data_mesh;
 }
 
+mesh::Data* Mesh::GetDataMesh() {
+	return m_data_mesh;
+}
+
 void Mesh::SetTexture( Texture* texture ) {
 	m_texture = texture;
 }
@@ -52,7 +61,7 @@ Texture* Mesh::GetTexture() const {
 	return m_texture;
 }
 
-void Mesh::SetDataMesh( const mesh::Data* data_mesh ) {
+void Mesh::SetDataMesh( mesh::Data* data_mesh ) {
 	ASSERT( !m_data_mesh, "data mesh already set" );
 	m_data_mesh = data_mesh;
 }
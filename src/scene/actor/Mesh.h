@@ -23,13 +23,16 @@ namespace actor {
 CLASS2( Mesh, Actor, RRAware )
 
 	// mesh can also be set in constructor of derived class, but it MUST be set
-	Mesh( const std::string& name, const mesh::Mesh* mesh = nullptr, const Actor::type_t type = Actor::TYPE_MESH );
+	Mesh( const std::string& name, mesh::Mesh* mesh = nullptr, const Actor::type_t type = Actor::TYPE_MESH );
 	virtual ~Mesh();
 
-	void SetMesh( const mesh::Mesh* mesh );
+	void SetMesh( mesh::Mesh* mesh );
 
 	const mesh::Mesh* GetMesh() const;
 	const mesh::Data* GetDataMesh() const;
+	// for graphics backend, which takes updated ranges of meshes when uploading them
+	mesh::Mesh* GetMesh();
+	mesh::Data* GetDataMesh();
 
 	void SetTexture( Texture* texture );
 	Texture* GetTexture() const;
@@ -37,7 +40,7 @@ CLASS2( Mesh, Actor, RRAware )
 	void SetTintColor( const Color tint_color );
 	const Color& GetTintColor() const;
 
-	void SetDataMesh( const mesh::Data* data_mesh );
+	void SetDataMesh( mesh::Data* data_mesh );
 
 	// data mesh stuff
 	typedef std::pair< bool, std::optional< rr::GetData::data_t > > data_response_t;
@@ -51,7 +54,7 @@ CLASS2( Mesh, Actor, RRAware )
 	void CancelCaptureToTextureRequest( const rr::id_t request_id );
 
 protected:
-	const mesh::Mesh* m_mesh = nullptr;
+	mesh::Mesh* m_mesh = nullptr;
 	Texture* m_texture = nullptr;
 
 	Color m_tint_color = {
@@ -62,7 +65,7 @@ protected:
 	};
 
 	// data mesh stuff
-	const mesh::Data* m_data_mesh = nullptr;
+	mesh::Data* m_data_mesh = nullptr;
 };
 
 } /* namespace scene */
@@ -22,9 +22,7 @@ void Simple::Start() {
 		Log( "Starting task [" + ( *it )->GetName() + "]" );
 		( *it )->Start();
 	}
-#ifdef DEBUG
 	m_timer.SetInterval( 1000 );
-#endif
 }
 
 void Simple::Stop() {
@@ -52,11 +50,9 @@ void Simple::Iterate() {
 	}
 	m_tasks_toremove.clear();
 
-#ifdef DEBUG
 	if ( m_timer.HasTicked() ) {
-		DEBUG_STAT_INC( seconds_passed );
+		STAT_INC( seconds_passed );
 	}
-#endif
 }
 
 void Simple::AddTask( Task* task ) {
@@ -23,9 +23,7 @@ CLASS( Simple, Scheduler )
 	
 protected:
 
-#ifdef DEBUG
 	util::Timer m_timer;
-#endif
 
 	std::vector< Task* > m_tasks = {};
 	std::vector< Task* > m_tasks_toadd = {};
@@ -0,0 +1,571 @@
+#include <algorithm>
+#include <cmath>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+#include "Benchmark.h"
+
+#include "base/AllocationProfiler.h"
+#include "engine/Engine.h"
+#include "task/game/Game.h"
+#include "game/map_editor/MapEditor.h"
+#include "util/FS.h"
+
+#include "ui/event/MouseMove.h"
+#include "ui/event/MouseDown.h"
+#include "ui/event/MouseUp.h"
+#include "ui/event/MouseScroll.h"
+#include "ui/event/KeyDown.h"
+#include "ui/event/KeyUp.h"
+
+#include "version.h"
+
+namespace task {
+namespace benchmark {
+
+// let map initialization (texture uploads, minimap, first tile selection) settle before measuring
+static const size_t SETTLE_MS = 1000;
+
+static const size_t PAN_STROKE_MS = 400;
+static const size_t PAN_STROKE_MOVES = 16;
+static const size_t ZOOM_TICK_MS = 60;
+static const size_t EDITOR_STROKE_MS = 1500;
+static const size_t EDITOR_STROKE_MOVES = 30;
+
+static const size_t MAP_CYCLES = 3;
+
+// bytes, -1 if not available
+static const ssize_t GetPeakRSS() {
+#ifndef _WIN32
+	struct rusage usage = {};
+	if ( !getrusage( RUSAGE_SELF, &usage ) ) {
+#ifdef __APPLE__
+		return usage.ru_maxrss; // bytes
+#else
+		return usage.ru_maxrss * 1024; // kilobytes
+#endif
+	}
+#endif
+	return -1;
+}
+
+// all allocations (not only NEW ones) since start, -1 if allocation profiler isn't started
+static const ssize_t GetAllocationsEstimated() {
+	if ( !base::AllocationProfiler::IsEnabled() ) {
+		return -1;
+	}
+	ssize_t allocations = 0;
+	for ( const auto& it : base::AllocationProfiler::GetSnapshot() ) {
+		allocations += it.second.allocated_count;
+	}
+	return allocations;
+}
+
+// {"p50":...,"p95":...,"p99":...,"max":...}
+static const std::string FormatPercentiles( std::vector< uint32_t > values ) {
+	if ( values.empty() ) {
+		return "{\"p50\":0,\"p95\":0,\"p99\":0,\"max\":0}";
+	}
+	const auto f_get_percentile = [ &values ]( const size_t percentile ) -> std::string {
+		const auto it = values.begin() + ( values.size() - 1 ) * percentile / 100;
+		std::nth_element( values.begin(), it, values.end() );
+		return std::to_string( *it );
+	};
+	return "{\"p50\":" + f_get_percentile( 50 ) +
+		",\"p95\":" + f_get_percentile( 95 ) +
+		",\"p99\":" + f_get_percentile( 99 ) +
+		",\"max\":" + std::to_string( *std::max_element( values.begin(), values.end() ) ) + "}";
+}
+
+void Benchmark::Start() {
+	m_memory_stats = {
+		{ base::Stats::ST_arena_reserved_size, 0 },
+		{ base::Stats::ST_arena_blocks_active, 0 },
+		{ base::Stats::ST_objects_active, 0 },
+		{ base::Stats::ST_ui_elements_active, 0 },
+	};
+	AddSteps();
+}
+
+void Benchmark::Stop() {
+	m_steps.clear();
+	m_memory_stats.clear();
+}
+
+void Benchmark::Iterate() {
+
+	if ( m_is_finished ) {
+		return;
+	}
+
+	if ( m_map_cycles.size() < MAP_CYCLES ) {
+		IterateMapCycle();
+		return;
+	}
+
+	if ( !m_game ) {
+		// not from Start() because scheduler is walking its task list at that point
+		Log( "Starting benchmark scenario on " + g_engine->GetConfig()->GetBenchmarkMapSize().ToString() + " map" );
+		NEW( m_game, task::game::Game, CreateState(), UH( this ) {
+			m_is_game_started = true;
+			m_scenario_start = clock_t::now() + std::chrono::milliseconds( SETTLE_MS );
+		}, UH( this ) {
+			Log( LL_ERROR, "Benchmark scenario map could not be started" );
+			m_is_finished = true;
+			g_engine->ShutDown();
+		} );
+		g_engine->GetScheduler()->AddTask( m_game );
+		return;
+	}
+
+	if ( !m_is_game_started ) {
+		return;
+	}
+
+	const auto now = clock_t::now();
+	if ( now < m_scenario_start ) {
+		return;
+	}
+
+	if ( m_last_frame == clock_t::time_point{} ) {
+		// first measured frame
+		const auto mt_stats = g_engine->GetGame()->MT_GetStats();
+		m_mt_processed_at_start = mt_stats.requests_processed;
+		m_mt_canceled_at_start = mt_stats.requests_canceled;
+		const auto* graphics = GetNullGraphics();
+		if ( graphics ) {
+			m_graphics_stats_at_start = graphics->GetStats();
+		}
+		UpdateHeapLiveBytes();
+		m_step_start = now;
+	}
+	else {
+		m_steps[ m_current_step ].frame_times_us.push_back( std::chrono::duration_cast< std::chrono::microseconds >( now - m_last_frame ).count() );
+	}
+	m_last_frame = now;
+
+	UpdateMemoryStats();
+
+	auto* step = &m_steps[ m_current_step ];
+	const size_t elapsed_ms = std::chrono::duration_cast< std::chrono::milliseconds >( now - m_step_start ).count();
+	while ( m_current_action < step->actions_count && elapsed_ms * step->actions_count >= m_current_action * step->duration_ms ) {
+		step->on_action( m_current_action++ );
+	}
+	if ( elapsed_ms >= step->duration_ms && m_current_action == step->actions_count ) {
+		Log( "Benchmark step '" + step->name + "' finished (" + std::to_string( step->frame_times_us.size() ) + " frames)" );
+		UpdateHeapLiveBytes();
+		m_current_step++;
+		m_current_action = 0;
+		m_step_start = now;
+		if ( m_current_step == m_steps.size() ) {
+			Finish();
+		}
+	}
+}
+
+::game::State* Benchmark::CreateState() const {
+	NEWV( state, ::game::State );
+	state->m_settings.global.map.type = ::game::MapSettings::MT_RANDOM;
+	state->m_settings.global.map.size = ::game::MapSettings::MAP_CUSTOM;
+	state->m_settings.global.map.custom_size = g_engine->GetConfig()->GetBenchmarkMapSize();
+	return state;
+}
+
+void Benchmark::IterateMapCycle() {
+	auto* game = g_engine->GetGame();
+	auto& cycle = m_map_cycle;
+
+	if ( !cycle.state ) {
+		Log( "Starting map generation cycle " + std::to_string( m_map_cycles.size() + 1 ) + " of " + std::to_string( MAP_CYCLES ) );
+		g_engine->GetUI()->GetLoader()->Show( "Generating map" );
+		cycle.state = CreateState();
+		cycle.start = clock_t::now();
+		cycle.stats = {};
+		cycle.objects_created_at_start = base::Stats::Get( base::Stats::ST_objects_created );
+		cycle.objects_active_at_start = base::Stats::Get( base::Stats::ST_objects_active );
+		cycle.allocations_at_start = GetAllocationsEstimated();
+		cycle.mt_ids.init = game->MT_Init( cycle.state );
+	}
+	else if ( cycle.mt_ids.init ) {
+		auto response = game->MT_GetResponse( cycle.mt_ids.init );
+		if ( response.result != ::game::R_NONE ) {
+			cycle.mt_ids.init = 0;
+			if ( response.result == ::game::R_SUCCESS ) {
+				cycle.mt_ids.get_map_data = game->MT_GetMapData();
+			}
+			else {
+				Log( LL_ERROR, "Benchmark map could not be generated" );
+			}
+			game->MT_DestroyResponse( response );
+		}
+	}
+	else if ( cycle.mt_ids.get_map_data ) {
+		auto response = game->MT_GetResponse( cycle.mt_ids.get_map_data );
+		if ( response.result != ::game::R_NONE ) {
+			if ( response.result == ::game::R_PENDING ) {
+				cycle.mt_ids.get_map_data = game->MT_GetMapData();
+			}
+			else {
+				cycle.mt_ids.get_map_data = 0;
+				if ( response.result == ::game::R_SUCCESS ) {
+					// map is still alive at this point, terrain texture and meshes are destroyed together with response
+					cycle.stats.arena_reserved_size = base::Stats::Get( base::Stats::ST_arena_reserved_size );
+				}
+				else {
+					Log( LL_ERROR, "Benchmark map data could not be received" );
+				}
+			}
+			game->MT_DestroyResponse( response );
+		}
+	}
+	else if ( cycle.mt_ids.reset ) {
+		auto response = game->MT_GetResponse( cycle.mt_ids.reset );
+		if ( response.result != ::game::R_NONE ) {
+			cycle.mt_ids.reset = 0;
+			game->MT_DestroyResponse( response );
+			DELETE( cycle.state );
+			cycle.state = nullptr;
+			g_engine->GetUI()->GetLoader()->Hide();
+
+			cycle.stats.duration_ms = std::chrono::duration_cast< std::chrono::milliseconds >( clock_t::now() - cycle.start ).count();
+			cycle.stats.objects_created = base::Stats::Get( base::Stats::ST_objects_created ) - cycle.objects_created_at_start;
+			cycle.stats.objects_active_growth = base::Stats::Get( base::Stats::ST_objects_active ) - cycle.objects_active_at_start;
+			cycle.stats.allocations_estimated = cycle.allocations_at_start >= 0
+				? GetAllocationsEstimated() - cycle.allocations_at_start
+				: -1;
+			cycle.stats.peak_rss = GetPeakRSS();
+			if ( !cycle.stats.arena_reserved_size ) {
+				// generation failed, there is nothing to measure
+				m_is_finished = true;
+				g_engine->ShutDown();
+				return;
+			}
+			Log( "Map generation cycle finished in " + std::to_string( cycle.stats.duration_ms ) + "ms, " + std::to_string( cycle.stats.objects_created ) + " objects created" );
+			m_map_cycles.push_back( cycle.stats );
+		}
+	}
+	else {
+		// generated (or failed to), release everything
+		cycle.mt_ids.reset = game->MT_Reset();
+	}
+}
+
+void Benchmark::AddSteps() {
+
+	// select tile at center of map area, it's needed for arrows to work
+	m_steps.push_back(
+		{
+			"select_tile",
+			500,
+			1,
+			[ this ]( const size_t action ) -> void {
+				MouseMove( { 0.5f, 0.35f } );
+				MouseDown( ::ui::event::UIEvent::M_LEFT );
+				MouseUp( ::ui::event::UIEvent::M_LEFT );
+			}
+		}
+	);
+
+	// long enough runs to cross map wraparound
+	{
+		std::vector< ::ui::event::UIEvent::key_code_t > keys = {};
+		const auto f_add_keys = [ &keys ]( const ::ui::event::UIEvent::key_code_t code, const size_t count ) -> void {
+			keys.insert( keys.end(), count, code );
+		};
+		f_add_keys( ::ui::event::UIEvent::K_LEFT, 30 );
+		f_add_keys( ::ui::event::UIEvent::K_UP, 6 );
+		f_add_keys( ::ui::event::UIEvent::K_RIGHT, 30 );
+		f_add_keys( ::ui::event::UIEvent::K_DOWN, 6 );
+		for ( size_t i = 0 ; i < 4 ; i++ ) {
+			f_add_keys( ::ui::event::UIEvent::K_HOME, 1 );
+			f_add_keys( ::ui::event::UIEvent::K_PAGEUP, 1 );
+			f_add_keys( ::ui::event::UIEvent::K_PAGEDOWN, 1 );
+			f_add_keys( ::ui::event::UIEvent::K_END, 1 );
+		}
+		m_steps.push_back(
+			{
+				"select_tile_arrows",
+				keys.size() * 50,
+				keys.size(),
+				[ this, keys ]( const size_t action ) -> void {
+					KeyDown( keys[ action ] );
+					KeyUp( keys[ action ] );
+				}
+			}
+		);
+	}
+
+	AddZoomStep( "zoom_in", 10, 1 );
+	AddPanStep( "pan_zoomed_in", 16, { 0.85f, 0.3f }, { 0.15f, 0.4f } );
+	AddZoomStep( "zoom_out", 30, -1 );
+	AddPanStep( "pan_zoomed_out", 8, { 0.15f, 0.45f }, { 0.85f, 0.2f } );
+	AddZoomStep( "zoom_reset", 10, 1 );
+
+	// several tools and brushes, both drawing modes
+	const struct editor_stroke_t {
+		::game::map_editor::MapEditor::tool_type_t tool;
+		::game::map_editor::MapEditor::brush_type_t brush;
+		::ui::event::UIEvent::mouse_button_t button;
+	} editor_strokes[] = {
+		{ ::game::map_editor::MapEditor::TT_ELEVATIONS, ::game::map_editor::MapEditor::BT_SQUARE_5_5,   ::ui::event::UIEvent::M_LEFT },
+		{ ::game::map_editor::MapEditor::TT_ELEVATIONS, ::game::map_editor::MapEditor::BT_SQUARE_3_3,   ::ui::event::UIEvent::M_RIGHT },
+		{ ::game::map_editor::MapEditor::TT_MOISTURE,   ::game::map_editor::MapEditor::BT_CROSS,        ::ui::event::UIEvent::M_LEFT },
+		{ ::game::map_editor::MapEditor::TT_FOREST,     ::game::map_editor::MapEditor::BT_SQUARE_9_9,   ::ui::event::UIEvent::M_LEFT },
+		{ ::game::map_editor::MapEditor::TT_ROAD,       ::game::map_editor::MapEditor::BT_DOT,          ::ui::event::UIEvent::M_LEFT },
+		{ ::game::map_editor::MapEditor::TT_RIVERS,     ::game::map_editor::MapEditor::BT_DOT,          ::ui::event::UIEvent::M_LEFT },
+		{ ::game::map_editor::MapEditor::TT_FUNGUS,     ::game::map_editor::MapEditor::BT_SQUARE_15_15, ::ui::event::UIEvent::M_LEFT },
+		{ ::game::map_editor::MapEditor::TT_FOREST,     ::game::map_editor::MapEditor::BT_SQUARE_9_9,   ::ui::event::UIEvent::M_RIGHT },
+	};
+	for ( size_t i = 0 ; i < sizeof( editor_strokes ) / sizeof( editor_strokes[ 0 ] ) ; i++ ) {
+		const auto& stroke = editor_strokes[ i ];
+		m_steps.push_back(
+			{
+				"map_editor_" + std::to_string( i ),
+				EDITOR_STROKE_MS,
+				EDITOR_STROKE_MOVES,
+				[ this, stroke ]( const size_t action ) -> void {
+					// circle around top half of viewport, away from bottom bar
+					const float angle = M_PI * 2 * action / ( EDITOR_STROKE_MOVES - 1 );
+					const types::Vec2< float > position = {
+						0.5f + cosf( angle ) * 0.25f,
+						0.35f + sinf( angle ) * 0.15f
+					};
+					if ( action == 0 ) {
+						m_game->SetEditorTool( stroke.tool );
+						m_game->SetEditorBrush( stroke.brush );
+						MouseMove( position );
+						KeyDown( ::ui::event::UIEvent::K_CTRL, ::ui::event::UIEvent::KM_CTRL );
+						MouseDown( stroke.button );
+					}
+					else {
+						MouseMove( position );
+					}
+					if ( action == EDITOR_STROKE_MOVES - 1 ) {
+						MouseUp( stroke.button );
+						KeyUp( ::ui::event::UIEvent::K_CTRL );
+					}
+				}
+			}
+		);
+	}
+}
+
+void Benchmark::AddPanStep( const std::string& name, const size_t strokes_count, const types::Vec2< float >& from, const types::Vec2< float >& to ) {
+	// repeated right button drags in same direction
+	m_steps.push_back(
+		{
+			name,
+			strokes_count * PAN_STROKE_MS,
+			strokes_count * PAN_STROKE_MOVES,
+			[ this, from, to ]( const size_t action ) -> void {
+				const size_t move = action % PAN_STROKE_MOVES;
+				if ( move == 0 ) {
+					MouseMove( from );
+					MouseDown( ::ui::event::UIEvent::M_RIGHT );
+				}
+				const float progress = (float)( move + 1 ) / PAN_STROKE_MOVES;
+				MouseMove(
+					{
+						from.x + ( to.x - from.x ) * progress,
+						from.y + ( to.y - from.y ) * progress
+					}
+				);
+				if ( move == PAN_STROKE_MOVES - 1 ) {
+					MouseUp( ::ui::event::UIEvent::M_RIGHT );
+				}
+			}
+		}
+	);
+}
+
+void Benchmark::AddZoomStep( const std::string& name, const size_t ticks_count, const ssize_t direction ) {
+	m_steps.push_back(
+		{
+			name,
+			ticks_count * ZOOM_TICK_MS,
+			ticks_count,
+			[ this, direction ]( const size_t action ) -> void {
+				if ( action == 0 ) {
+					MouseMove( { 0.5f, 0.35f } );
+				}
+				MouseScroll( direction );
+			}
+		}
+	);
+}
+
+void Benchmark::UpdateMemoryStats() {
+	for ( auto& memory_stat : m_memory_stats ) {
+		const auto value = base::Stats::Get( memory_stat.stat );
+		if ( value > memory_stat.max ) {
+			memory_stat.max = value;
+		}
+	}
+}
+
+void Benchmark::UpdateHeapLiveBytes() {
+	if ( !base::AllocationProfiler::IsEnabled() ) {
+		return;
+	}
+	ssize_t live_bytes = 0;
+	for ( const auto& it : base::AllocationProfiler::GetSnapshot() ) {
+		live_bytes += it.second.live_bytes;
+	}
+	if ( live_bytes > m_heap_live_bytes_max ) {
+		m_heap_live_bytes_max = live_bytes;
+	}
+}
+
+const graphics::null::Null* Benchmark::GetNullGraphics() const {
+	if ( !g_engine->GetConfig()->HasLaunchFlag( config::Config::LF_HEADLESS ) ) {
+		return nullptr;
+	}
+	return (const graphics::null::Null*)g_engine->GetGraphics();
+}
+
+void Benchmark::SendEvent( ::ui::event::UIEvent* event ) {
+	g_engine->GetUI()->ProcessEvent( event );
+	DELETE( event );
+}
+
+void Benchmark::MouseMove( const types::Vec2< float >& position ) {
+	m_mouse_position = position;
+	const auto coords = GetWindowCoordinates( m_mouse_position );
+	NEWV( event, ::ui::event::MouseMove, coords.x, coords.y );
+	SendEvent( event );
+}
+
+void Benchmark::MouseDown( const ::ui::event::UIEvent::mouse_button_t button ) {
+	const auto coords = GetWindowCoordinates( m_mouse_position );
+	NEWV( event, ::ui::event::MouseDown, coords.x, coords.y, button );
+	SendEvent( event );
+}
+
+void Benchmark::MouseUp( const ::ui::event::UIEvent::mouse_button_t button ) {
+	const auto coords = GetWindowCoordinates( m_mouse_position );
+	NEWV( event, ::ui::event::MouseUp, coords.x, coords.y, button );
+	SendEvent( event );
+}
+
+void Benchmark::MouseScroll( const ssize_t scroll_y ) {
+	const auto coords = GetWindowCoordinates( m_mouse_position );
+	NEWV( event, ::ui::event::MouseScroll, coords.x, coords.y, scroll_y );
+	SendEvent( event );
+}
+
+void Benchmark::KeyDown( const ::ui::event::UIEvent::key_code_t code, const ::ui::event::UIEvent::key_modifier_t modifiers ) {
+	NEWV( event, ::ui::event::KeyDown, code, 0, modifiers );
+	SendEvent( event );
+}
+
+void Benchmark::KeyUp( const ::ui::event::UIEvent::key_code_t code, const ::ui::event::UIEvent::key_modifier_t modifiers ) {
+	NEWV( event, ::ui::event::KeyUp, code, 0, modifiers );
+	SendEvent( event );
+}
+
+const types::Vec2< size_t > Benchmark::GetWindowCoordinates( const types::Vec2< float >& position ) const {
+	const auto* graphics = g_engine->GetGraphics();
+	return {
+		(size_t)( position.x * graphics->GetViewportWidth() ),
+		(size_t)( position.y * graphics->GetViewportHeight() )
+	};
+}
+
+void Benchmark::Finish() {
+	m_is_finished = true;
+	WriteReport();
+	m_game->ExitGame(
+		[]() -> void {
+			g_engine->ShutDown();
+		}
+	);
+}
+
+void Benchmark::WriteReport() {
+	const auto* config = g_engine->GetConfig();
+	const auto& map_size = config->GetBenchmarkMapSize();
+	const auto& seed = config->GetBenchmarkSeed();
+	const auto mt_stats = g_engine->GetGame()->MT_GetStats();
+
+	std::vector< uint32_t > frame_times_us = {};
+	std::string steps = "";
+	for ( const auto& step : m_steps ) {
+		frame_times_us.insert( frame_times_us.end(), step.frame_times_us.begin(), step.frame_times_us.end() );
+		if ( !steps.empty() ) {
+			steps += ",\n";
+		}
+		steps += "    {\"name\":\"" + step.name + "\",\"frames\":" + std::to_string( step.frame_times_us.size() ) + ",\"frame_time_us\":" + FormatPercentiles( step.frame_times_us ) + "}";
+	}
+
+	std::string map_cycles = "";
+	for ( const auto& cycle : m_map_cycles ) {
+		if ( !map_cycles.empty() ) {
+			map_cycles += ",\n";
+		}
+		map_cycles += "    {\"duration_ms\":" + std::to_string( cycle.duration_ms ) +
+			",\"objects_created\":" + std::to_string( cycle.objects_created ) +
+			",\"objects_active_growth\":" + std::to_string( cycle.objects_active_growth ) +
+			",\"arena_reserved_size\":" + std::to_string( cycle.arena_reserved_size );
+		if ( cycle.allocations_estimated >= 0 ) {
+			map_cycles += ",\"allocations_estimated\":" + std::to_string( cycle.allocations_estimated );
+		}
+		if ( cycle.peak_rss >= 0 ) {
+			map_cycles += ",\"peak_rss\":" + std::to_string( cycle.peak_rss );
+		}
+		map_cycles += "}";
+	}
+
+	std::string memory = "";
+	const ssize_t peak_rss = GetPeakRSS();
+	if ( peak_rss >= 0 ) {
+		memory += "    \"peak_rss\":" + std::to_string( peak_rss );
+	}
+	for ( const auto& memory_stat : m_memory_stats ) {
+		if ( !memory.empty() ) {
+			memory += ",\n";
+		}
+		memory += "    \"" + std::string( base::Stats::GetName( memory_stat.stat ) ) + "\":" + std::to_string( memory_stat.max );
+	}
+	if ( base::AllocationProfiler::IsEnabled() ) {
+		memory += ",\n    \"heap_live_bytes_estimated\":" + std::to_string( m_heap_live_bytes_max );
+	}
+
+	std::string uploads = "";
+	const auto* graphics = GetNullGraphics();
+	if ( graphics ) {
+		const auto& graphics_stats = graphics->GetStats();
+		uploads = "  \"graphics_uploads\":{\"texture_bytes\":" + std::to_string( graphics_stats.textures_uploaded - m_graphics_stats_at_start.textures_uploaded ) +
+			",\"vertex_bytes\":" + std::to_string( graphics_stats.vertex_buffers_uploaded - m_graphics_stats_at_start.vertex_buffers_uploaded ) +
+			",\"index_bytes\":" + std::to_string( graphics_stats.index_buffers_uploaded - m_graphics_stats_at_start.index_buffers_uploaded ) + "},\n";
+	}
+
+	const std::string report = "{\n"
+		"  \"version\":\"" + GLSMAC_VERSION_FULL + "\",\n"
+#ifdef DEBUG
+		"  \"build\":\"debug\",\n"
+#else
+		"  \"build\":\"release\",\n"
+#endif
+		"  \"map\":{\"width\":" + std::to_string( map_size.x ) + ",\"height\":" + std::to_string( map_size.y ) +
+		",\"seed\":\"" + std::to_string( seed.a ) + ":" + std::to_string( seed.b ) + ":" + std::to_string( seed.c ) + ":" + std::to_string( seed.d ) + "\"},\n"
+		"  \"duration_ms\":" + std::to_string( std::chrono::duration_cast< std::chrono::milliseconds >( m_last_frame - m_scenario_start ).count() ) + ",\n"
+		"  \"frames\":" + std::to_string( frame_times_us.size() ) + ",\n"
+		"  \"frame_time_us\":" + FormatPercentiles( frame_times_us ) + ",\n"
+		"  \"steps\":[\n" + steps + "\n  ],\n"
+		"  \"mt_requests\":{\"processed\":" + std::to_string( mt_stats.requests_processed - m_mt_processed_at_start ) +
+		",\"canceled\":" + std::to_string( mt_stats.requests_canceled - m_mt_canceled_at_start ) +
+		",\"latency_us\":" + FormatPercentiles( g_engine->GetGame()->MT_GetLatencies( m_mt_processed_at_start ) ) + "},\n" +
+		uploads +
+		"  \"map_cycles\":[\n" + map_cycles + "\n  ],\n"
+		"  \"memory_high_water\":{\n" + memory + "\n  }\n"
+		"}\n";
+
+	const auto& path = config->GetBenchmarkReportPath();
+	util::FS::WriteFile( path, report );
+	Log( "Benchmark finished, frame times: " + FormatPercentiles( frame_times_us ) + ", report written to " + path );
+}
+
+}
+}
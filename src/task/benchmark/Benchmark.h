@@ -0,0 +1,125 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <functional>
+#include <chrono>
+
+#include "base/Task.h"
+
+#include "graphics/null/Null.h"
+
+#include "types/Vec2.h"
+#include "ui/event/UIEvent.h"
+
+namespace game {
+class State;
+}
+
+namespace task {
+
+namespace game {
+class Game;
+}
+
+namespace benchmark {
+
+// generates and resets fixed-seed maps few times, then replays scripted input on next one, writes results to json and exits
+// input is sent as ui events (like from real input module) so that same code paths and same MT requests are measured
+CLASS( Benchmark, base::Task )
+
+	void Start() override;
+	void Stop() override;
+	void Iterate() override;
+
+private:
+
+	typedef std::chrono::steady_clock clock_t;
+
+	::game::State* CreateState() const;
+
+	// maps are generated and reset several times before scenario (without displaying them)
+	// to see if allocations and memory keep growing over generate/reset cycles
+	struct map_cycle_t {
+		size_t duration_ms;
+		size_t objects_created;
+		ssize_t objects_active_growth; // after reset, compared to before generation
+		ssize_t arena_reserved_size; // while map was alive
+		ssize_t allocations_estimated; // -1 if allocation profiler isn't started
+		ssize_t peak_rss; // -1 if not available
+	};
+	std::vector< map_cycle_t > m_map_cycles = {};
+	struct {
+		::game::State* state;
+		struct {
+			base::mt_id_t init;
+			base::mt_id_t get_map_data;
+			base::mt_id_t reset;
+		} mt_ids;
+		clock_t::time_point start;
+		map_cycle_t stats;
+		ssize_t objects_created_at_start;
+		ssize_t objects_active_at_start;
+		ssize_t allocations_at_start;
+	} m_map_cycle = {};
+	void IterateMapCycle();
+
+	game::Game* m_game = nullptr;
+	bool m_is_game_started = false;
+	bool m_is_finished = false;
+
+	// actions of step are spread evenly over its duration, frames are measured per step
+	struct step_t {
+		std::string name;
+		size_t duration_ms;
+		size_t actions_count;
+		std::function< void( const size_t action ) > on_action;
+		std::vector< uint32_t > frame_times_us;
+	};
+	std::vector< step_t > m_steps = {};
+	size_t m_current_step = 0;
+	size_t m_current_action = 0;
+	clock_t::time_point m_step_start = {};
+	void AddSteps();
+	void AddPanStep( const std::string& name, const size_t strokes_count, const types::Vec2< float >& from, const types::Vec2< float >& to );
+	void AddZoomStep( const std::string& name, const size_t ticks_count, const ssize_t direction );
+
+	clock_t::time_point m_scenario_start = {};
+	clock_t::time_point m_last_frame = {};
+	size_t m_mt_processed_at_start = 0;
+	size_t m_mt_canceled_at_start = 0;
+
+	// highest values of gauges during scenario (only ones that are maintained in release builds too)
+	struct memory_stat_t {
+		base::Stats::stat_id_t stat;
+		ssize_t max;
+	};
+	std::vector< memory_stat_t > m_memory_stats = {};
+	void UpdateMemoryStats();
+
+	// estimated from allocation profiler samples after every step, only if it was started
+	ssize_t m_heap_live_bytes_max = 0;
+	void UpdateHeapLiveBytes();
+
+	// scenario runs headless, so uploads are counted by null graphics backend instead of opengl stats
+	const graphics::null::Null* GetNullGraphics() const;
+	graphics::null::Null::stats_t m_graphics_stats_at_start = {};
+
+	// scripted input, positions are relative to viewport (0.0 - 1.0)
+	types::Vec2< float > m_mouse_position = {};
+	void SendEvent( ::ui::event::UIEvent* event );
+	void MouseMove( const types::Vec2< float >& position );
+	void MouseDown( const ::ui::event::UIEvent::mouse_button_t button );
+	void MouseUp( const ::ui::event::UIEvent::mouse_button_t button );
+	void MouseScroll( const ssize_t scroll_y );
+	void KeyDown( const ::ui::event::UIEvent::key_code_t code, const ::ui::event::UIEvent::key_modifier_t modifiers = ::ui::event::UIEvent::KM_NONE );
+	void KeyUp( const ::ui::event::UIEvent::key_code_t code, const ::ui::event::UIEvent::key_modifier_t modifiers = ::ui::event::UIEvent::KM_NONE );
+	const types::Vec2< size_t > GetWindowCoordinates( const types::Vec2< float >& position ) const;
+
+	void Finish();
+	void WriteReport();
+
+};
+
+}
+}
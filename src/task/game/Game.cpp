@@ -22,7 +22,7 @@ Game::Game( ::game::State* state, ui_handler_t on_start, ui_handler_t on_cancel
 
 Game::~Game() {
 	if ( m_is_initialized ) {
-		Log( "WARNING: game task destroyed while still running" );
+		Log( LL_WARNING, "game task destroyed while still running" );
 	}
 }
 
@@ -71,6 +71,12 @@ void Game::Start() {
 
 void Game::Stop() {
 
+	if ( m_mt_ids.save_map ) {
+		// callback must not be called after this task is gone
+		g_engine->GetGame()->MT_Cancel( m_mt_ids.save_map );
+		m_mt_ids.save_map = 0;
+	}
+
 	if ( m_is_initialized ) {
 		Deinitialize();
 
@@ -92,6 +98,9 @@ void Game::Iterate() {
 	auto* ui = g_engine->GetUI();
 	auto* config = g_engine->GetConfig();
 
+	// responses of requests that were made with callbacks
+	game->MT_DispatchCallbacks();
+
 	const auto f_handle_nonsuccess_init = [ this, ui ]( const ::game::MT_Response& response ) -> void {
 		switch ( response.result ) {
 			case ::game::R_ABORTED: {
@@ -170,7 +179,6 @@ void Game::Iterate() {
 
 					UpdateCameraRange();
 					UpdateMapInstances();
-					UpdateMinimap();
 				}
 				else {
 					f_handle_nonsuccess_init( response );
@@ -209,29 +217,6 @@ void Game::Iterate() {
 			CancelGame();
 		}
 	}
-	else if ( m_mt_ids.save_map ) {
-		auto response = game->MT_GetResponse( m_mt_ids.save_map );
-		if ( response.result != ::game::R_NONE ) {
-			ui->GetLoader()->Hide();
-			m_mt_ids.save_map = 0;
-			if ( ui->HasPopup() ) {
-				ui->CloseLastPopup();
-			}
-			if ( response.result == ::game::R_SUCCESS ) {
-				m_map_data.last_directory = util::FS::GetDirName( *response.data.save_map.path );
-				m_map_data.filename = util::FS::GetBaseName( *response.data.save_map.path );
-				m_ui.bottom_bar->UpdateMapFileName();
-			}
-			else {
-				ui->GetError()->Show(
-					"Map saving failed.", UH( this ) {
-
-					}
-				);
-			}
-			game->MT_DestroyResponse( response );
-		}
-	}
 	else if ( m_mt_ids.edit_map ) {
 		auto response = game->MT_GetResponse( m_mt_ids.edit_map );
 		if ( response.result != ::game::R_NONE ) {
@@ -274,6 +259,12 @@ void Game::Iterate() {
 			result.instances_to_remove = *response.data.select_tile.instances_to_remove;
 			result.instances_to_add = *response.data.select_tile.instances_to_add;
 			*/
+
+			if ( response.data.edit_map.tiles_to_reload ) {
+				m_minimap_builder->UpdateTiles( *response.data.edit_map.tiles_to_reload );
+			}
+
+			game->MT_DestroyResponse( response );
 		}
 	}
 
@@ -281,7 +272,7 @@ void Game::Iterate() {
 
 		if ( m_editing_draw_timer.HasTicked() ) {
 			if ( m_is_editing_mode && !IsTileAtRequestPending() ) {
-				SelectTileAtPoint( m_map_control.last_mouse_position.x, m_map_control.last_mouse_position.y ); // async
+				SelectTileAtPoint( m_map_control.last_mouse_position.x, m_map_control.last_mouse_position.y );
 			}
 		}
 
@@ -305,11 +296,6 @@ void Game::Iterate() {
 			}
 		}
 
-		auto minimap_texture = GetMinimapTextureResult();
-		if ( minimap_texture ) {
-			m_ui.bottom_bar->SetMinimapTexture( minimap_texture );
-		}
-
 		bool is_camera_position_updated = false;
 		bool is_camera_scale_updated = false;
 		while ( m_map_control.edge_scrolling.timer.HasTicked() ) {
@@ -660,9 +646,29 @@ void Game::SaveMap( const std::string& path ) {
 	g_engine->GetUI()->GetLoader()->Show( "Saving game" );
 	if ( m_mt_ids.save_map ) {
 		game->MT_Cancel( m_mt_ids.save_map );
-
 	}
-	m_mt_ids.save_map = game->MT_SaveMap( path );
+	m_mt_ids.save_map = game->MT_SaveMap(
+		path, [ this ]( const ::game::MT_Response& response ) -> void {
+			auto* ui = g_engine->GetUI();
+			ui->GetLoader()->Hide();
+			m_mt_ids.save_map = 0;
+			if ( ui->HasPopup() ) {
+				ui->CloseLastPopup();
+			}
+			if ( response.result == ::game::R_SUCCESS ) {
+				m_map_data.last_directory = util::FS::GetDirName( *response.data.save_map.path );
+				m_map_data.filename = util::FS::GetBaseName( *response.data.save_map.path );
+				m_ui.bottom_bar->UpdateMapFileName();
+			}
+			else {
+				ui->GetError()->Show(
+					"Map saving failed.", UH( this ) {
+
+					}
+				);
+			}
+		}
+	);
 }
 
 void Game::ConfirmExit( ::ui::ui_handler_t on_confirm ) {
@@ -806,6 +812,12 @@ void Game::Initialize(
 	m_actors.terrain->AddInstance( {} ); // default instance
 	m_world_scene->AddActor( m_actors.terrain );
 
+	ASSERT( !m_terrain_data_index, "terrain data index already set" );
+	NEW( m_terrain_data_index, types::mesh::DataIndex, terrain_data_mesh );
+
+	ASSERT( !m_minimap_builder, "minimap builder already set" );
+	NEW( m_minimap_builder, MinimapBuilder, m_textures.terrain, m_map_data.width, m_map_data.height );
+
 	Log( "Sprites count: " + std::to_string( sprite_actors.size() ) );
 	Log( "Sprites instances: " + std::to_string( sprite_instances.size() ) );
 	for ( auto& a : sprite_actors ) {
@@ -960,13 +972,13 @@ void Game::Initialize(
 					}
 
 				}
-				SelectTileAtPoint( data->mouse.absolute.x, data->mouse.absolute.y ); // async
+				SelectTileAtPoint( data->mouse.absolute.x, data->mouse.absolute.y );
 				m_editing_draw_timer.SetInterval( Game::s_consts.map_editing.draw_frequency_ms ); // keep drawing until mouseup
 			}
 			else {
 				switch ( data->mouse.button ) {
 					case UIEvent::M_LEFT: {
-						SelectTileAtPoint( data->mouse.absolute.x, data->mouse.absolute.y ); // async
+						SelectTileAtPoint( data->mouse.absolute.x, data->mouse.absolute.y );
 						break;
 					}
 					case UIEvent::M_RIGHT: {
@@ -1118,7 +1130,6 @@ void Game::Initialize(
 			UpdateViewport();
 			UpdateCameraRange();
 			UpdateMapInstances();
-			UpdateMinimap();
 		}
 	);
 	m_is_resize_handler_set = true;
@@ -1161,15 +1172,18 @@ void Game::Deinitialize() {
 	x( mousescroll );
 #undef x
 
-	if ( m_tile_at_request_id ) {
-		ASSERT( m_actors.terrain, "tileat request pending but terrain actor not set" );
+	if ( m_tile_at_result.is_set ) {
 		CancelTileAtRequest();
 	}
 
-	if ( m_minimap_texture_request_id ) {
-		ASSERT( m_actors.terrain, "minimap texture request pending but terrain actor not set" );
-		m_actors.terrain->GetMeshActor()->CancelDataRequest( m_minimap_texture_request_id );
-		m_minimap_texture_request_id = 0;
+	if ( m_terrain_data_index ) {
+		DELETE( m_terrain_data_index );
+		m_terrain_data_index = nullptr;
+	}
+
+	if ( m_minimap_builder ) {
+		DELETE( m_minimap_builder );
+		m_minimap_builder = nullptr;
 	}
 
 	if ( m_actors.terrain ) {
@@ -1224,7 +1238,7 @@ void Game::AddMessage( const std::string& text ) {
 
 void Game::SelectTileAtPoint( const size_t x, const size_t y ) {
 	//Log( "Looking up tile at " + std::to_string( x ) + "x" + std::to_string( y ) );
-	GetTileAtScreenCoords( x, m_viewport.window_height - y ); // async
+	GetTileAtScreenCoords( x, m_viewport.window_height - y );
 }
 
 void Game::SelectTile( const tile_data_t& tile_data ) {
@@ -1368,47 +1382,46 @@ void Game::ScrollToTile( const tile_data_t& tile_data ) {
 }
 
 void Game::CancelTileAtRequest() {
-	ASSERT( m_tile_at_request_id, "tileat request not found" );
-	m_actors.terrain->GetMeshActor()->CancelDataRequest( m_tile_at_request_id );
-	m_tile_at_request_id = 0;
+	ASSERT( m_tile_at_result.is_set, "tileat request not found" );
+	m_tile_at_result = {};
 }
 
 void Game::GetTileAtScreenCoords( const size_t screen_x, const size_t screen_inverse_y ) {
-	if ( m_tile_at_request_id ) {
-		m_actors.terrain->GetMeshActor()->CancelDataRequest( m_tile_at_request_id );
+	ASSERT( m_terrain_data_index, "terrain data index not set" );
+
+	m_tile_at_result = {};
+
+	// same transformations as when rendering data mesh, pick closest hit among all world instances
+	const float x = 2.0f * ( screen_x + 0.5f ) / m_viewport.window_width - 1.0f;
+	const float y = 2.0f * ( screen_inverse_y + 0.5f ) / m_viewport.window_height - 1.0f;
+	types::mesh::DataIndex::result_t best = {};
+	for ( auto& instance_matrix : m_actors.terrain->GetInstanceMatrices() ) {
+		const auto result = m_terrain_data_index->GetDataAt( m_camera->GetMatrix() * instance_matrix, x, y );
+		if ( result.is_found && ( !best.is_found || result.depth < best.depth ) ) {
+			best = result;
+		}
+	}
+
+	if ( best.is_found && best.data ) { // some tile was clicked
+		const auto data = best.data - 1; // we used +1 increment to differentiate 'tile at 0,0' from 'no tiles'
+		m_tile_at_result = {
+			true,
+			{
+				data % m_map_data.width,
+				data / m_map_data.width
+			}
+		};
 	}
-	m_tile_at_request_id = m_actors.terrain->GetMeshActor()->GetDataAt( screen_x, screen_inverse_y );
 }
 
 const bool Game::IsTileAtRequestPending() const {
-	return m_tile_at_request_id;
+	return m_tile_at_result.is_set;
 }
 
 const Game::tile_at_result_t Game::GetTileAtScreenCoordsResult() {
-	if ( m_tile_at_request_id ) {
-		auto result = m_actors.terrain->GetMeshActor()->GetDataResponse( m_tile_at_request_id );
-		if ( result.first ) {
-			m_tile_at_request_id = 0;
-
-			if ( result.second ) {
-				auto data = *result.second;
-				if ( data ) { // some tile was clicked
-
-					data--; // we used +1 increment to differentiate 'tile at 0,0' from 'no tiles'
-
-					return {
-						true,
-						{
-							data % m_map_data.width,
-							data / m_map_data.width
-						}
-					};
-				}
-			}
-		}
-	}
-	// no data
-	return {};
+	const auto result = m_tile_at_result;
+	m_tile_at_result = {};
+	return result;
 }
 
 void Game::GetTileAtCoords( const Vec2< size_t >& tile_pos, const ::game::tile_direction_t tile_direction ) {
@@ -1472,71 +1485,10 @@ tile_data_t Game::GetTileAtCoordsResult() {
 	return {};
 }
 
-void Game::GetMinimapTexture( scene::Camera* camera, const Vec2< size_t > texture_dimensions ) {
-	if ( m_minimap_texture_request_id ) {
-		Log( "Canceling minimap texture request" );
-		m_actors.terrain->GetMeshActor()->CancelDataRequest( m_minimap_texture_request_id );
-	}
-	Log( "Requesting minimap texture" );
-	m_minimap_texture_request_id = m_actors.terrain->GetMeshActor()->CaptureToTexture( camera, texture_dimensions );
-}
-
-Texture* Game::GetMinimapTextureResult() {
-	if ( m_minimap_texture_request_id ) {
-		auto result = m_actors.terrain->GetMeshActor()->GetCaptureToTextureResponse( m_minimap_texture_request_id );
-		if ( result ) {
-			Log( "Received minimap texture" );
-			m_minimap_texture_request_id = 0;
-			return result;
-		}
-	}
-	// no texture (yet)
-	return nullptr;
-}
-
 void Game::UpdateMinimap() {
-	NEWV( camera, scene::Camera, scene::Camera::CT_ORTHOGRAPHIC );
-
-	auto mm = m_ui.bottom_bar->GetMinimapDimensions();
-	// 'black grid' artifact workaround
-	// TODO: find reason and fix properly, maybe just keep larger internal viewport
-	Vec2< float > scale = {
-		(float)m_viewport.window_width / mm.x,
-		(float)m_viewport.window_height / mm.y
-	};
-
-	mm.x *= scale.x;
-	mm.y *= scale.y;
-
-	const float sx = (float)mm.x / (float)m_map_data.width / (float)::game::map::s_consts.tc.texture_pcx.dimensions.x;
-	const float sy = (float)mm.y / (float)m_map_data.height / (float)::game::map::s_consts.tc.texture_pcx.dimensions.y;
-	const float sz = ( sx + sy ) / 2;
-	const float ss = ( (float)mm.y / (float)m_viewport.window_height );
-	const float sxy = (float)scale.x / scale.y;
-
-	camera->SetAngle( m_camera->GetAngle() );
-	camera->SetScale(
-		{
-			sx * ss * sxy / scale.x,
-			sy * ss * 1.38f / scale.y,
-			0.01f
-		}
-	);
-
-	camera->SetPosition(
-		{
-			ss * sxy,
-			1.0f - ss * 0.48f,
-			0.5f
-		}
-	);
-
-	GetMinimapTexture(
-		camera, {
-			mm.x,
-			mm.y
-		}
-	);
+	ASSERT( m_minimap_builder, "minimap builder not set" );
+	Log( "Building minimap texture" );
+	m_ui.bottom_bar->SetMinimapTexture( m_minimap_builder->Build( m_ui.bottom_bar->GetMinimapDimensions() ) );
 }
 
 void Game::ResetMapState() {
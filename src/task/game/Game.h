@@ -17,6 +17,7 @@
 #include "types/Texture.h"
 #include "types/mesh/Render.h"
 #include "types/mesh/Data.h"
+#include "types/mesh/DataIndex.h"
 
 #include "util/Clamper.h"
 #include "util/Random.h"
@@ -30,6 +31,7 @@
 #include "ui/bottom_bar/BottomBar.h"
 
 #include "actor/TileSelection.h"
+#include "MinimapBuilder.h"
 #include "game/Game.h"
 
 #include "game/map/Consts.h"
@@ -290,9 +292,11 @@ private:
 	};
 
 	// tile request stuff
-	rr::id_t m_tile_at_request_id = 0;
+	// tiles are picked on cpu from terrain data mesh, result is kept until next GetTileAtScreenCoordsResult() call
+	types::mesh::DataIndex* m_terrain_data_index = nullptr;
+	tile_at_result_t m_tile_at_result = {};
 	void CancelTileAtRequest();
-	void GetTileAtScreenCoords( const size_t screen_x, const size_t screen_inverse_y ); // async, y needs to be upside down
+	void GetTileAtScreenCoords( const size_t screen_x, const size_t screen_inverse_y ); // y needs to be upside down
 	const bool IsTileAtRequestPending() const;
 	const tile_at_result_t GetTileAtScreenCoordsResult();
 
@@ -300,9 +304,8 @@ private:
 	tile_data_t GetTileAtCoordsResult();
 
 	// minimap stuff
-	rr::id_t m_minimap_texture_request_id = 0;
-	void GetMinimapTexture( scene::Camera* camera, const Vec2< size_t > texture_dimensions );
-	Texture* GetMinimapTextureResult();
+	// minimap is built on cpu from terrain texture, bottom bar owns resulting texture
+	MinimapBuilder* m_minimap_builder = nullptr;
 	void UpdateMinimap();
 
 	void ResetMapState();
@@ -0,0 +1,164 @@
+#include <cmath>
+
+#include "MinimapBuilder.h"
+
+#include "game/map/Consts.h"
+#include "game/map/TileState.h"
+
+namespace task {
+namespace game {
+
+using ::game::map::TileState;
+
+MinimapBuilder::MinimapBuilder( const types::Texture* terrain_texture, const size_t map_width, const size_t map_height )
+	: m_terrain_texture( terrain_texture )
+	, m_map_width( map_width )
+	, m_map_height( map_height ) {
+	ASSERT( m_terrain_texture, "terrain texture not set" );
+	ASSERT( m_map_width % 2 == 0, "map width must be even" );
+	ASSERT( ::game::map::s_consts.tc.texture_pcx.dimensions.x % PATCH_SIZE == 0, "tile texture width not divisible by patch size" );
+	ASSERT( ::game::map::s_consts.tc.texture_pcx.dimensions.y % PATCH_SIZE == 0, "tile texture height not divisible by patch size" );
+
+	// only tiles where x + y is even exist, so there are half as many tiles as coordinates per row
+	m_patches.resize( m_map_width / 2 * m_map_height * TileState::LAYER_MAX * PATCH_SIZE * PATCH_SIZE * 4 );
+	for ( size_t y = 0 ; y < m_map_height ; y++ ) {
+		for ( size_t x = y & 1 ; x < m_map_width ; x += 2 ) {
+			ResampleTile( x, y );
+		}
+	}
+}
+
+types::Texture* MinimapBuilder::Build( const types::Vec2< size_t >& dimensions ) {
+	ASSERT( dimensions.x > 0 && dimensions.y > 0, "invalid minimap dimensions" );
+	NEW( m_texture, types::Texture, "Minimap", dimensions.x, dimensions.y );
+	RenderArea( 0, 0, dimensions.x - 1, dimensions.y - 1 );
+	m_texture->FullUpdate();
+	return m_texture;
+}
+
+void MinimapBuilder::UpdateTiles( const std::vector< types::Vec2< size_t > >& tiles ) {
+	for ( auto& tile : tiles ) {
+		ResampleTile( tile.x, tile.y );
+	}
+	if ( !m_texture ) {
+		return;
+	}
+	const float sx = (float)m_texture->m_width / m_map_width;
+	const float sy = (float)m_texture->m_height / m_map_height;
+	const ssize_t max_x = m_texture->m_width - 1;
+	const ssize_t max_y = m_texture->m_height - 1;
+	for ( auto& tile : tiles ) {
+		// tile covers [ x - 1, x + 1 ] x [ y - 1, y + 1 ] in map coordinates, see RenderArea for pixel mapping
+		const ssize_t top = std::max< ssize_t >( 0, floorf( ( tile.y - 0.5f ) * sy - 0.5f ) );
+		const ssize_t bottom = std::min< ssize_t >( max_y, ceilf( ( tile.y + 1.5f ) * sy - 0.5f ) );
+		if ( top > bottom ) {
+			continue;
+		}
+		// map wraps horizontally so tiles at edges also affect pixels at other side
+		for ( const ssize_t shift : { -(ssize_t)m_map_width, (ssize_t)0, (ssize_t)m_map_width } ) {
+			const ssize_t left = std::max< ssize_t >( 0, floorf( ( (ssize_t)tile.x + shift - 0.5f ) * sx - 0.5f ) );
+			const ssize_t right = std::min< ssize_t >( max_x, ceilf( ( (ssize_t)tile.x + shift + 1.5f ) * sx - 0.5f ) );
+			if ( left <= right ) {
+				RenderArea( left, top, right, bottom );
+				m_texture->Update(
+					{
+						(size_t)left,
+						(size_t)top,
+						(size_t)right,
+						(size_t)bottom
+					}
+				);
+			}
+		}
+	}
+}
+
+uint8_t* MinimapBuilder::GetPatch( const size_t x, const size_t y, const size_t layer ) {
+	const size_t tile_index = y * ( m_map_width / 2 ) + x / 2;
+	return m_patches.data() + ( tile_index * TileState::LAYER_MAX + layer ) * PATCH_SIZE * PATCH_SIZE * 4;
+}
+
+void MinimapBuilder::ResampleTile( const size_t x, const size_t y ) {
+	ASSERT( x < m_map_width && y < m_map_height, "tile out of bounds" );
+	ASSERT( ( x + y ) % 2 == 0, "invalid tile coordinates" );
+
+	const auto& tile_dimensions = ::game::map::s_consts.tc.texture_pcx.dimensions;
+	const size_t block_w = tile_dimensions.x / PATCH_SIZE;
+	const size_t block_h = tile_dimensions.y / PATCH_SIZE;
+	const size_t block_area = block_w * block_h;
+	const size_t stride = m_terrain_texture->m_width * 4;
+
+	for ( size_t layer = 0 ; layer < TileState::LAYER_MAX ; layer++ ) {
+		// same layout as in Map::InitTextureAndMesh, layers are stacked vertically
+		const uint8_t* src = m_terrain_texture->m_bitmap +
+			( layer * m_map_height + y ) * tile_dimensions.y * stride +
+			x * tile_dimensions.x * 4;
+		uint8_t* dst = GetPatch( x, y, layer );
+		for ( size_t py = 0 ; py < PATCH_SIZE ; py++ ) {
+			for ( size_t px = 0 ; px < PATCH_SIZE ; px++ ) {
+				// weight colors by alpha so that transparent pixels don't darken edges
+				uint32_t r = 0, g = 0, b = 0, a = 0;
+				const uint8_t* block = src + py * block_h * stride + px * block_w * 4;
+				for ( size_t by = 0 ; by < block_h ; by++ ) {
+					const uint8_t* p = block + by * stride;
+					for ( size_t bx = 0 ; bx < block_w ; bx++, p += 4 ) {
+						r += p[ 0 ] * p[ 3 ];
+						g += p[ 1 ] * p[ 3 ];
+						b += p[ 2 ] * p[ 3 ];
+						a += p[ 3 ];
+					}
+				}
+				*(dst++) = r / ( block_area * 255 );
+				*(dst++) = g / ( block_area * 255 );
+				*(dst++) = b / ( block_area * 255 );
+				*(dst++) = a / block_area;
+			}
+		}
+	}
+}
+
+void MinimapBuilder::RenderArea( const size_t left, const size_t top, const size_t right, const size_t bottom ) {
+	ASSERT( m_texture, "minimap texture not built" );
+	ASSERT( right < m_texture->m_width && bottom < m_texture->m_height, "area out of bounds" );
+
+	const float sx = (float)m_map_width / m_texture->m_width;
+	const float sy = (float)m_map_height / m_texture->m_height;
+
+	for ( size_t py = top ; py <= bottom ; py++ ) {
+		const float v = ( py + 0.5f ) * sy - 0.5f;
+		for ( size_t px = left ; px <= right ; px++ ) {
+			const float u = ( px + 0.5f ) * sx - 0.5f;
+
+			// tiles are diamonds with centers where x + y is even, in rotated coordinates they become squares
+			const float s = u + v;
+			const float t = v - u;
+			const ssize_t sc = 2 * (ssize_t)floorf( s / 2.0f + 0.5f );
+			const ssize_t tc = 2 * (ssize_t)floorf( t / 2.0f + 0.5f );
+			const ssize_t ty = ( sc + tc ) / 2;
+			if ( ty < 0 || ty >= (ssize_t)m_map_height ) {
+				m_texture->SetPixel( px, py, types::Color::RGB( 0, 0, 0 ) );
+				continue;
+			}
+			const ssize_t tx = ( ( ( sc - tc ) / 2 ) % (ssize_t)m_map_width + (ssize_t)m_map_width ) % (ssize_t)m_map_width;
+
+			// position inside tile texture, same orientation as in CalculateCoords (left vertex is at bottom-left of texture)
+			const size_t fx = std::min< size_t >( PATCH_SIZE - 1, ( s - sc + 1.0f ) / 2.0f * PATCH_SIZE );
+			const size_t fy = std::min< size_t >( PATCH_SIZE - 1, ( t - tc + 1.0f ) / 2.0f * PATCH_SIZE );
+			const size_t ofs = ( fy * PATCH_SIZE + fx ) * 4;
+
+			// layers are composited in their rendering order
+			uint32_t r = 0, g = 0, b = 0;
+			for ( size_t layer = 0 ; layer < TileState::LAYER_MAX ; layer++ ) {
+				const uint8_t* p = GetPatch( tx, ty, layer ) + ofs;
+				const uint32_t ia = 255 - p[ 3 ];
+				r = p[ 0 ] + r * ia / 255;
+				g = p[ 1 ] + g * ia / 255;
+				b = p[ 2 ] + b * ia / 255;
+			}
+			m_texture->SetPixel( px, py, types::Color::RGB( r, g, b ) );
+		}
+	}
+}
+
+}
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <vector>
+
+#include "base/Base.h"
+
+#include "types/Texture.h"
+#include "types/Vec2.h"
+
+namespace task {
+namespace game {
+
+// builds minimap on cpu from box-filtered terrain texture tiles, so that gpu never needs to render it or read it back
+// minimap is a top-down approximation (no lighting, no camera tilt)
+CLASS( MinimapBuilder, base::Base )
+
+	static constexpr size_t PATCH_SIZE = 8; // downsampled tile resolution (per axis)
+
+	MinimapBuilder( const types::Texture* terrain_texture, const size_t map_width, const size_t map_height );
+
+	// creates new minimap texture from cached tile patches
+	// caller takes ownership but must keep texture alive while builder exists (or until next Build)
+	types::Texture* Build( const types::Vec2< size_t >& dimensions );
+
+	// resamples given tiles from terrain texture and redraws affected parts of last built minimap texture
+	void UpdateTiles( const std::vector< types::Vec2< size_t > >& tiles );
+
+private:
+	const types::Texture* m_terrain_texture = nullptr;
+	const size_t m_map_width = 0;
+	const size_t m_map_height = 0;
+
+	// premultiplied rgba, PATCH_SIZE * PATCH_SIZE pixels for every layer of every tile
+	std::vector< uint8_t > m_patches = {};
+
+	types::Texture* m_texture = nullptr;
+
+	uint8_t* GetPatch( const size_t x, const size_t y, const size_t layer );
+	void ResampleTile( const size_t x, const size_t y );
+	void RenderArea( const size_t left, const size_t top, const size_t right, const size_t bottom ); // right and bottom are inclusive
+};
+
+}
+}
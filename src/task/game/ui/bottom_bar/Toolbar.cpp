@@ -56,7 +56,7 @@ void Toolbar::Create() {
 			10
 		};
 		uint8_t bx = 0, by = 0;
-		for ( auto b = MapEditor::BT_NONE + 1 ; b < MapEditor::BT_MAX ; b++ ) {
+		for ( auto b = MapEditor::BT_NONE + 1 ; b <= s_last_brush_with_button ; b++ ) {
 			const auto brush = (MapEditor::brush_type_t)b;
 			ASSERT( m_brush_names.find( brush ) != m_brush_names.end(), "brush name not found" );
 			const std::string& brush_name = m_brush_names.at( brush );
@@ -197,7 +197,7 @@ void Toolbar::SelectBrush( MapEditor::brush_type_t brush ) {
 		if ( m_active_brush_button ) {
 			m_active_brush_button->RemoveStyleModifier( Style::M_SELECTED );
 		}
-		if ( brush == MapEditor::BT_NONE ) {
+		if ( brush == MapEditor::BT_NONE || brush > s_last_brush_with_button ) {
 			m_active_brush_button = nullptr;
 		}
 		else {
@@ -80,14 +80,18 @@ private:
 
 	// note: those are also used for button class name
 	const std::unordered_map< MapEditor::brush_type_t, std::string > m_brush_names = {
-		{ MapEditor::BT_NONE,       "None" },
-		{ MapEditor::BT_DOT,        "Dot" },
-		{ MapEditor::BT_CROSS,      "Cross" },
-		{ MapEditor::BT_SQUARE_3_3, "Square 3x3" },
-		{ MapEditor::BT_SQUARE_5_5, "Square 5x5" },
-		{ MapEditor::BT_SQUARE_7_7, "Square 7x7" },
-		{ MapEditor::BT_SQUARE_9_9, "Square 9x9" }
+		{ MapEditor::BT_NONE,         "None" },
+		{ MapEditor::BT_DOT,          "Dot" },
+		{ MapEditor::BT_CROSS,        "Cross" },
+		{ MapEditor::BT_SQUARE_3_3,   "Square 3x3" },
+		{ MapEditor::BT_SQUARE_5_5,   "Square 5x5" },
+		{ MapEditor::BT_SQUARE_7_7,   "Square 7x7" },
+		{ MapEditor::BT_SQUARE_9_9,   "Square 9x9" },
+		{ MapEditor::BT_SQUARE_15_15, "Square 15x15" },
+		{ MapEditor::BT_SQUARE_21_21, "Square 21x21" }
 	};
+	// larger brushes don't have buttons (there are no textures for them in original game)
+	static constexpr MapEditor::brush_type_t s_last_brush_with_button = MapEditor::BT_SQUARE_9_9;
 
 	std::vector< ::ui::object::SimpleButton* > m_brush_buttons = {};
 	::ui::object::SimpleButton* m_active_brush_button = nullptr;
@@ -9,15 +9,41 @@ using namespace ui::object;
 namespace task {
 namespace intro {
 
+// assets needed by main menu and game, they are decoded in background while intro is shown
+static const std::vector< std::string > s_preload_textures = {
+	"openinga.pcx",
+	"interface.pcx",
+	"Icons.pcx",
+	"Jackal.pcx",
+	"palette.pcx",
+	"console_x.pcx",
+	"ter1.pcx",
+	"texture.pcx",
+	"console2_A.pcx",
+	"console_x2_a.pcx",
+	"space_sm.pcx",
+};
+static const std::vector< std::string > s_preload_sounds = {
+	"opening menu.wav",
+	"menu up.wav",
+	"menu down.wav",
+	"menu out.wav",
+	"ok.wav",
+	"amenu2.wav",
+	"mmenu.wav",
+};
+
 void Intro::Start() {
 
+	g_engine->GetTextureLoader()->Preload( s_preload_textures );
+	g_engine->GetSoundLoader()->Preload( s_preload_sounds );
+
 	g_engine->GetUI()->AddTheme( &m_theme );
 
 	NEW( m_logo, Surface, "IntroLogo" );
 	g_engine->GetUI()->AddObject( m_logo );
 
-	m_timer.SetTimeout( 1000 ); // pretend we're loading something
-	// TODO: do all preloading while intro is running?
+	m_timer.SetTimeout( 1000 ); // gives preloading a head start, anything not decoded by then is waited for when it's needed
 }
 
 void Intro::Stop() {
@@ -1,5 +1,10 @@
 #include <cmath>
 #include <cstdint>
+#include <algorithm>
+
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
 
 #include "Matrix44.h"
 
@@ -213,29 +218,164 @@ void Matrix44::ProjectionOrtho2D( const float aspect_ratio, const float znear, c
 	m[ 3 ][ 3 ] = 1.0f;
 };
 
-Matrix44 Matrix44::operator*( const Matrix44 operand ) {
-	Matrix44 ret;
+// out = lhs * rhs, out may be same as lhs or rhs
+// used when there is no simd path, and as reference for SelfCheck()
+static inline void MultiplyScalar( const Matrix44& lhs, const Matrix44& rhs, Matrix44& out ) {
+	// same row-by-row order so that compiler can vectorize it (i.e. for neon)
+	float rows[ 4 ][ 4 ];
+	for ( uint8_t i = 0 ; i < 4 ; i++ ) {
+		for ( uint8_t j = 0 ; j < 4 ; j++ ) {
+			rows[ i ][ j ] =
+				lhs.m[ i ][ 0 ] * rhs.m[ 0 ][ j ] +
+					lhs.m[ i ][ 1 ] * rhs.m[ 1 ][ j ] +
+					lhs.m[ i ][ 2 ] * rhs.m[ 2 ][ j ] +
+					lhs.m[ i ][ 3 ] * rhs.m[ 3 ][ j ];
+		}
+	}
 	for ( uint8_t i = 0 ; i < 4 ; i++ ) {
 		for ( uint8_t j = 0 ; j < 4 ; j++ ) {
-			ret.m[ i ][ j ] = m[ i ][ 0 ] * operand.m[ 0 ][ j ] +
-				m[ i ][ 1 ] * operand.m[ 1 ][ j ] +
-				m[ i ][ 2 ] * operand.m[ 2 ][ j ] +
-				m[ i ][ 3 ] * operand.m[ 3 ][ j ];
+			out.m[ i ][ j ] = rows[ i ][ j ];
 		}
 	}
+}
+
+// out = lhs * rhs, out may be same as lhs or rhs
+static inline void Multiply( const Matrix44& lhs, const Matrix44& rhs, Matrix44& out ) {
+#ifdef __SSE__
+	const __m128 r0 = _mm_load_ps( rhs.m[ 0 ] );
+	const __m128 r1 = _mm_load_ps( rhs.m[ 1 ] );
+	const __m128 r2 = _mm_load_ps( rhs.m[ 2 ] );
+	const __m128 r3 = _mm_load_ps( rhs.m[ 3 ] );
+	__m128 rows[ 4 ];
+	for ( uint8_t i = 0 ; i < 4 ; i++ ) {
+		rows[ i ] = _mm_add_ps(
+			_mm_add_ps(
+				_mm_mul_ps( _mm_set1_ps( lhs.m[ i ][ 0 ] ), r0 ),
+				_mm_mul_ps( _mm_set1_ps( lhs.m[ i ][ 1 ] ), r1 )
+			),
+			_mm_add_ps(
+				_mm_mul_ps( _mm_set1_ps( lhs.m[ i ][ 2 ] ), r2 ),
+				_mm_mul_ps( _mm_set1_ps( lhs.m[ i ][ 3 ] ), r3 )
+			)
+		);
+	}
+	for ( uint8_t i = 0 ; i < 4 ; i++ ) {
+		_mm_store_ps( out.m[ i ], rows[ i ] );
+	}
+#else
+	MultiplyScalar( lhs, rhs, out );
+#endif
+}
+
+Matrix44 Matrix44::operator*( const Matrix44& operand ) const {
+	Matrix44 ret;
+	Multiply( *this, operand, ret );
 	return ret;
 };
 
-void Matrix44::operator*=( const Matrix44 operand ) {
-	for ( uint8_t i = 0 ; i < 4 ; i++ ) {
+void Matrix44::operator*=( const Matrix44& operand ) {
+	Multiply( *this, operand, *this );
+};
+
+void Matrix44::TransformTranslated( const Matrix44& affine, const float x, const float y, const float z ) {
+	// translation only changes last column of affine matrix
+	if ( this != &affine ) {
+		CopyFrom( affine );
+	}
+	m[ 0 ][ 3 ] += x;
+	m[ 1 ][ 3 ] += y;
+	m[ 2 ][ 3 ] += z;
+}
+
+void Matrix44::TransformTRS( const Vec3& translate, const Matrix44& rotate, const Matrix44& scale ) {
+	float rs[ 3 ][ 4 ];
+	for ( uint8_t i = 0 ; i < 3 ; i++ ) {
 		for ( uint8_t j = 0 ; j < 4 ; j++ ) {
-			m[ i ][ j ] = m[ i ][ 0 ] * operand.m[ 0 ][ j ] +
-				m[ i ][ 1 ] * operand.m[ 1 ][ j ] +
-				m[ i ][ 2 ] * operand.m[ 2 ][ j ] +
-				m[ i ][ 3 ] * operand.m[ 3 ][ j ];
+			rs[ i ][ j ] =
+				rotate.m[ i ][ 0 ] * scale.m[ 0 ][ j ] +
+					rotate.m[ i ][ 1 ] * scale.m[ 1 ][ j ] +
+					rotate.m[ i ][ 2 ] * scale.m[ 2 ][ j ];
 		}
+		rs[ i ][ 3 ] += rotate.m[ i ][ 3 ];
 	}
-};
+	for ( uint8_t i = 0 ; i < 3 ; i++ ) {
+		for ( uint8_t j = 0 ; j < 4 ; j++ ) {
+			m[ i ][ j ] = rs[ i ][ j ];
+		}
+	}
+	m[ 0 ][ 3 ] += translate.x;
+	m[ 1 ][ 3 ] += translate.y;
+	m[ 2 ][ 3 ] += translate.z;
+	m[ 3 ][ 0 ] = 0.0f;
+	m[ 3 ][ 1 ] = 0.0f;
+	m[ 3 ][ 2 ] = 0.0f;
+	m[ 3 ][ 3 ] = 1.0f;
+}
+
+void Matrix44::TranslateBatch( const Matrix44& affine, const Vec3& offset, const Vec3* offsets, const size_t count, Matrix44* out ) {
+	const float x = affine.m[ 0 ][ 3 ] + offset.x;
+	const float y = affine.m[ 1 ][ 3 ] + offset.y;
+	const float z = affine.m[ 2 ][ 3 ] + offset.z;
+	for ( size_t i = 0 ; i < count ; i++ ) {
+		auto& o = out[ i ];
+		if ( &o != &affine ) {
+			o.CopyFrom( affine );
+		}
+		o.m[ 0 ][ 3 ] = x + offsets[ i ].x;
+		o.m[ 1 ][ 3 ] = y + offsets[ i ].y;
+		o.m[ 2 ][ 3 ] = z + offsets[ i ].z;
+	}
+}
+
+#ifdef DEBUG
+const std::string Matrix44::SelfCheck() {
+	// reproducible inputs in -10.0 - 10.0 range
+	uint32_t seed = 1;
+	const auto f_random = [ &seed ]() -> float {
+		seed = seed * 1664525 + 1013904223;
+		return (float)( seed >> 8 ) / ( 1 << 24 ) * 20.0f - 10.0f;
+	};
+	const auto f_find_mismatch = []( const Matrix44& actual, const Matrix44& expected ) -> bool {
+		for ( uint8_t i = 0 ; i < 4 ; i++ ) {
+			for ( uint8_t j = 0 ; j < 4 ; j++ ) {
+				// order of additions differs, so allow rounding errors relative to magnitude
+				if ( fabsf( actual.m[ i ][ j ] - expected.m[ i ][ j ] ) > 1e-4f * std::max( 1.0f, fabsf( expected.m[ i ][ j ] ) ) ) {
+					return true;
+				}
+			}
+		}
+		return false;
+	};
+
+	Matrix44 lhs, rhs, expected, actual, translate, rotate, scale, tmp;
+	for ( size_t n = 0 ; n < 1000 ; n++ ) {
+
+		for ( uint8_t i = 0 ; i < 4 ; i++ ) {
+			for ( uint8_t j = 0 ; j < 4 ; j++ ) {
+				lhs.m[ i ][ j ] = f_random();
+				rhs.m[ i ][ j ] = f_random();
+			}
+		}
+		MultiplyScalar( lhs, rhs, expected );
+		actual = lhs * rhs;
+		if ( f_find_mismatch( actual, expected ) ) {
+			return "operator* mismatch for\n" + lhs.ToString() + "\n*\n" + rhs.ToString() + "\nexpected:\n" + expected.ToString() + "\ngot:\n" + actual.ToString();
+		}
+
+		const Vec3 t( f_random(), f_random(), f_random() );
+		translate.TransformTranslate( t.x, t.y, t.z );
+		rotate.TransformRotate( f_random(), f_random(), f_random() );
+		scale.TransformScale( f_random(), f_random(), f_random() );
+		MultiplyScalar( translate, rotate, tmp );
+		MultiplyScalar( tmp, scale, expected );
+		actual.TransformTRS( t, rotate, scale );
+		if ( f_find_mismatch( actual, expected ) ) {
+			return "TransformTRS mismatch for\n" + translate.ToString() + "\n*\n" + rotate.ToString() + "\n*\n" + scale.ToString() + "\nexpected:\n" + expected.ToString() + "\ngot:\n" + actual.ToString();
+		}
+	}
+	return "";
+}
+#endif
 
 const std::string Matrix44::ToString() const {
 	std::string ret = "";
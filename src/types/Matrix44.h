@@ -4,7 +4,8 @@
 
 namespace types {
 
-class Matrix44 {
+// aligned so that rows can be loaded directly into simd registers
+class alignas( 16 ) Matrix44 {
 public:
 
 	Matrix44();
@@ -24,8 +25,25 @@ public:
 	void ProjectionPerspective( const float aspect_ratio, const float fov, const float znear, const float zfar );
 	void ProjectionOrtho2D( const float aspect_ratio, const float znear, const float zfar );
 
-	Matrix44 operator*( const Matrix44 operand );
-	void operator*=( const Matrix44 operand );
+	Matrix44 operator*( const Matrix44& operand ) const;
+	void operator*=( const Matrix44& operand );
+
+	// affine matrices have last row of 0 0 0 1 (all Transform* results and their products)
+	// methods below assume affine inputs and skip unneeded calculations
+	// translate( x, y, z ) * affine
+	void TransformTranslated( const Matrix44& affine, const float x, const float y, const float z );
+	// translate( translate ) * rotate * scale
+	void TransformTRS( const Vec3& translate, const Matrix44& rotate, const Matrix44& scale );
+
+	// batch versions, out may point to same array as in
+	// out[ i ] = translate( offset + offsets[ i ] ) * affine
+	static void TranslateBatch( const Matrix44& affine, const Vec3& offset, const Vec3* offsets, const size_t count, Matrix44* out );
+
+#ifdef DEBUG
+	// compares simd and shortcut paths (operator*, TransformTRS) with plain scalar math on random inputs
+	// returns description of first mismatch or empty string if everything matches
+	static const std::string SelfCheck();
+#endif
 
 	const std::string ToString() const;
 };
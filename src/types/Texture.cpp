@@ -1,6 +1,7 @@
 #include <cstring>
 #include <cmath>
 #include <iostream>
+#include <algorithm>
 
 #include "Texture.h"
 #include "engine/Engine.h"
@@ -774,32 +775,127 @@ Texture* Texture::FromColor( const Color& color ) {
 
 void Texture::Update( const updated_area_t updated_area ) {
 	//Log( "Need texture update [ "+ std::to_string( updated_area.left ) + " " + std::to_string( updated_area.top ) + " " + std::to_string( updated_area.right ) + " " + std::to_string( updated_area.bottom ) + " ]" );
-	m_updated_areas.push_back( updated_area );
 	m_update_counter++;
+	if ( m_is_fully_updated || !m_width || !m_height ) {
+		return;
+	}
+
+	const size_t cells_width = ( m_width + UPDATE_CELL_SIZE - 1 ) >> UPDATE_CELL_SIZE_LOG;
+	const size_t cells_height = ( m_height + UPDATE_CELL_SIZE - 1 ) >> UPDATE_CELL_SIZE_LOG;
+	if ( m_updated_cells_width != cells_width || m_updated_cells_height != cells_height ) {
+		m_updated_cells_width = cells_width;
+		m_updated_cells_height = cells_height;
+		m_updated_cells.assign( ( cells_width * cells_height + 63 ) / 64, 0 );
+		m_has_updated_cells = false;
+	}
+
+	const size_t cx1 = std::min< size_t >( updated_area.left, m_width - 1 ) >> UPDATE_CELL_SIZE_LOG;
+	const size_t cy1 = std::min< size_t >( updated_area.top, m_height - 1 ) >> UPDATE_CELL_SIZE_LOG;
+	const size_t cx2 = std::min< size_t >( updated_area.right, m_width - 1 ) >> UPDATE_CELL_SIZE_LOG;
+	const size_t cy2 = std::min< size_t >( updated_area.bottom, m_height - 1 ) >> UPDATE_CELL_SIZE_LOG;
+	size_t index;
+	for ( size_t cy = cy1 ; cy <= cy2 ; cy++ ) {
+		for ( size_t cx = cx1 ; cx <= cx2 ; cx++ ) {
+			index = cy * m_updated_cells_width + cx;
+			m_updated_cells[ index >> 6 ] |= (uint64_t)1 << ( index & 63 );
+		}
+	}
+	m_has_updated_cells = true;
 }
 
 void Texture::FullUpdate() {
 	ClearUpdatedAreas();
-	Update(
-		{
-			0,
-			0,
-			m_width,
-			m_height
-		}
-	);
+	m_is_fully_updated = true;
+	m_update_counter++;
 }
 
 const size_t Texture::UpdatedCount() const {
 	return m_update_counter;
 }
 
-const Texture::updated_areas_t& Texture::GetUpdatedAreas() const {
-	return m_updated_areas;
+const bool Texture::IsFullyUpdated() const {
+	return m_is_fully_updated;
+}
+
+const Texture::updated_areas_t Texture::GetUpdatedAreas() const {
+	if ( m_is_fully_updated ) {
+		return {
+			{
+				0,
+				0,
+				m_width,
+				m_height
+			}
+		};
+	}
+	updated_areas_t result = {};
+	if ( !m_has_updated_cells ) {
+		return result;
+	}
+
+	// horizontal runs of changed cells, identical runs in consecutive rows are merged into one area
+	struct run_t {
+		size_t begin;
+		size_t end;
+		size_t area_index;
+	};
+	std::vector< run_t > prev_runs = {};
+	std::vector< run_t > runs = {};
+	size_t index;
+	for ( size_t cy = 0 ; cy < m_updated_cells_height ; cy++ ) {
+		runs.clear();
+		auto prev_it = prev_runs.begin();
+		size_t cx = 0;
+		while ( cx < m_updated_cells_width ) {
+			index = cy * m_updated_cells_width + cx;
+			if ( !( m_updated_cells[ index >> 6 ] & ( (uint64_t)1 << ( index & 63 ) ) ) ) {
+				cx++;
+				continue;
+			}
+			const size_t begin = cx;
+			do {
+				cx++;
+				index++;
+			}
+			while ( cx < m_updated_cells_width && ( m_updated_cells[ index >> 6 ] & ( (uint64_t)1 << ( index & 63 ) ) ) );
+			while ( prev_it != prev_runs.end() && prev_it->begin < begin ) {
+				prev_it++;
+			}
+			const size_t bottom = std::min< size_t >( ( cy + 1 ) << UPDATE_CELL_SIZE_LOG, m_height );
+			if ( prev_it != prev_runs.end() && prev_it->begin == begin && prev_it->end == cx ) {
+				result[ prev_it->area_index ].bottom = bottom;
+				runs.push_back( *prev_it );
+			}
+			else {
+				runs.push_back(
+					{
+						begin,
+						cx,
+						result.size()
+					}
+				);
+				result.push_back(
+					{
+						begin << UPDATE_CELL_SIZE_LOG,
+						cy << UPDATE_CELL_SIZE_LOG,
+						std::min< size_t >( cx << UPDATE_CELL_SIZE_LOG, m_width ),
+						bottom
+					}
+				);
+			}
+		}
+		prev_runs.swap( runs );
+	}
+
+	return result;
 }
 
 void Texture::ClearUpdatedAreas() {
-	m_updated_areas.clear();
+	if ( m_has_updated_cells ) {
+		std::fill( m_updated_cells.begin(), m_updated_cells.end(), 0 );
+		m_has_updated_cells = false;
+	}
+	m_is_fully_updated = false;
 }
 
 unsigned char* Texture::CopyBitmap( const size_t x1, const size_t y1, const size_t x2, const size_t y2 ) {
@@ -127,12 +127,18 @@ CLASS( Texture, Serializable )
 		}
 	};
 	typedef std::vector< updated_area_t > updated_areas_t;
-	updated_areas_t m_updated_areas = {};
 
-	void Update( const updated_area_t updated_area );
+	// updates are tracked as bitmap of fixed-size cells instead of list of areas
+	// so that many small or overlapping updates don't need to be merged later
+	static constexpr size_t UPDATE_CELL_SIZE_LOG = 6;
+	static constexpr size_t UPDATE_CELL_SIZE = 1 << UPDATE_CELL_SIZE_LOG;
+
+	void Update( const updated_area_t updated_area ); // right and bottom are inclusive
 	void FullUpdate();
 	const size_t UpdatedCount() const;
-	const updated_areas_t& GetUpdatedAreas() const;
+	const bool IsFullyUpdated() const;
+	// returns changed cells merged into rectangles, right and bottom are exclusive here
+	const updated_areas_t GetUpdatedAreas() const;
 	void ClearUpdatedAreas();
 
 	// allocates and returns copy of bitmap from specified area
@@ -145,6 +151,12 @@ CLASS( Texture, Serializable )
 
 private:
 	size_t m_update_counter = 0;
+
+	bool m_is_fully_updated = false;
+	size_t m_updated_cells_width = 0;
+	size_t m_updated_cells_height = 0;
+	std::vector< uint64_t > m_updated_cells = {};
+	bool m_has_updated_cells = false;
 };
 
 } /* namespace types */
@@ -30,13 +30,13 @@ void Data::SetVertex( const index_t index, const Vec3& coord, const data_t data
 	memcpy( ptr( m_vertex_data, offset, sizeof( coord ) ), &coord, sizeof( coord ) );
 	offset += VERTEX_COORD_SIZE * sizeof( coord_t );
 	memcpy( ptr( m_vertex_data, offset, sizeof( data ) ), &data, sizeof( data ) );
-	Update();
+	UpdateVertices( index, index + 1 );
 }
 
 void Data::SetVertexData( const index_t index, const data_t data ) {
 	ASSERT( index < m_vertex_count, "index out of bounds" );
 	memcpy( ptr( m_vertex_data, index * VERTEX_SIZE * sizeof( coord_t ) + VERTEX_COORD_SIZE * sizeof( coord_t ), sizeof( data ) ), &data, sizeof( data ) );
-	Update();
+	UpdateVertices( index, index + 1 );
 }
 
 }
@@ -0,0 +1,318 @@
+#include <cmath>
+#include <algorithm>
+
+#include "DataIndex.h"
+
+namespace types {
+namespace mesh {
+
+DataIndex::DataIndex( Data* mesh )
+	: m_mesh( mesh ) {
+	ASSERT( m_mesh, "data mesh is null" );
+	m_update_tracker = m_mesh->AddUpdateTracker();
+}
+
+const DataIndex::result_t DataIndex::GetDataAt( const Matrix44& matrix, const float x, const float y ) {
+	ASSERT(
+		matrix.m[ 3 ][ 0 ] == 0.0f &&
+			matrix.m[ 3 ][ 1 ] == 0.0f &&
+			matrix.m[ 3 ][ 2 ] == 0.0f &&
+			matrix.m[ 3 ][ 3 ] == 1.0f,
+		"only affine matrices are supported"
+	);
+
+	if ( !m_is_built ) {
+		Build();
+	}
+	else if ( m_last_mesh_update_counter != m_mesh->UpdatedCount() ) {
+		Update();
+	}
+
+	result_t result = {};
+
+	if ( m_cells.empty() ) {
+		return result;
+	}
+
+	const auto& m = matrix.m;
+
+	// screen x and y depend on mesh x, y and z, so for every z there is one x,y that maps to given screen point
+	// find them for lowest and highest z of mesh, surfaces under screen point can only be between these two points
+	const float det = m[ 0 ][ 0 ] * m[ 1 ][ 1 ] - m[ 0 ][ 1 ] * m[ 1 ][ 0 ];
+	if ( fabs( det ) < 1e-12f ) {
+		return result; // looking at mesh from the side
+	}
+	Vec2< float > segment[2];
+	const float zs[2] = {
+		m_min_z,
+		m_max_z
+	};
+	float rx, ry;
+	for ( uint8_t i = 0 ; i < 2 ; i++ ) {
+		rx = x - m[ 0 ][ 3 ] - m[ 0 ][ 2 ] * zs[ i ];
+		ry = y - m[ 1 ][ 3 ] - m[ 1 ][ 2 ] * zs[ i ];
+		segment[ i ] = {
+			( rx * m[ 1 ][ 1 ] - m[ 0 ][ 1 ] * ry ) / det,
+			( m[ 0 ][ 0 ] * ry - m[ 1 ][ 0 ] * rx ) / det
+		};
+	}
+	const float min_x = std::min< float >( segment[ 0 ].x, segment[ 1 ].x );
+	const float max_x = std::max< float >( segment[ 0 ].x, segment[ 1 ].x );
+	const float min_y = std::min< float >( segment[ 0 ].y, segment[ 1 ].y );
+	const float max_y = std::max< float >( segment[ 0 ].y, segment[ 1 ].y );
+	if ( max_x < m_bounds.min.x || min_x > m_bounds.max.x || max_y < m_bounds.min.y || min_y > m_bounds.max.y ) {
+		return result;
+	}
+
+	const auto f_cell = []( const float value, const float min, const float cell_size, const size_t cells ) -> size_t {
+		return std::min< size_t >( std::max< float >( ( value - min ) / cell_size, 0.0f ), cells - 1 );
+	};
+	const size_t cx1 = f_cell( min_x, m_bounds.min.x, m_cell_size.x, m_cells_width );
+	const size_t cx2 = f_cell( max_x, m_bounds.min.x, m_cell_size.x, m_cells_width );
+	const size_t cy1 = f_cell( min_y, m_bounds.min.y, m_cell_size.y, m_cells_height );
+	const size_t cy2 = f_cell( max_y, m_bounds.min.y, m_cell_size.y, m_cells_height );
+
+	const uint32_t query_id = NextQueryId();
+
+	const auto* indices = (const Mesh::index_t*)m_mesh->GetIndexData();
+	Mesh::index_t vi[3];
+	float sx[3], sy[3], sz[3];
+	Vec3 v;
+	float area, b1, b2, b3, depth;
+	for ( size_t cy = cy1 ; cy <= cy2 ; cy++ ) {
+		for ( size_t cx = cx1 ; cx <= cx2 ; cx++ ) {
+			for ( const auto surface_id : m_cells[ cy * m_cells_width + cx ] ) {
+				if ( m_surface_query_ids[ surface_id ] == query_id ) {
+					continue;
+				}
+				m_surface_query_ids[ surface_id ] = query_id;
+
+				// project surface to screen and check if point is inside
+				for ( uint8_t j = 0 ; j < 3 ; j++ ) {
+					vi[ j ] = indices[ surface_id * Mesh::SURFACE_SIZE + j ];
+					v = GetVertexCoord( vi[ j ] );
+					sx[ j ] = m[ 0 ][ 0 ] * v.x + m[ 0 ][ 1 ] * v.y + m[ 0 ][ 2 ] * v.z + m[ 0 ][ 3 ];
+					sy[ j ] = m[ 1 ][ 0 ] * v.x + m[ 1 ][ 1 ] * v.y + m[ 1 ][ 2 ] * v.z + m[ 1 ][ 3 ];
+					sz[ j ] = m[ 2 ][ 0 ] * v.x + m[ 2 ][ 1 ] * v.y + m[ 2 ][ 2 ] * v.z + m[ 2 ][ 3 ];
+				}
+				area = ( sx[ 1 ] - sx[ 0 ] ) * ( sy[ 2 ] - sy[ 0 ] ) - ( sx[ 2 ] - sx[ 0 ] ) * ( sy[ 1 ] - sy[ 0 ] );
+				if ( fabs( area ) < 1e-12f ) {
+					continue;
+				}
+				b1 = ( ( sx[ 1 ] - x ) * ( sy[ 2 ] - y ) - ( sx[ 2 ] - x ) * ( sy[ 1 ] - y ) ) / area;
+				b2 = ( ( sx[ 2 ] - x ) * ( sy[ 0 ] - y ) - ( sx[ 0 ] - x ) * ( sy[ 2 ] - y ) ) / area;
+				b3 = 1.0f - b1 - b2;
+				if ( b1 < -1e-6f || b2 < -1e-6f || b3 < -1e-6f ) {
+					continue;
+				}
+
+				// same depth test and clipping as when rendering
+				depth = b1 * sz[ 0 ] + b2 * sz[ 1 ] + b3 * sz[ 2 ];
+				if ( depth < -1.0f || depth > 1.0f || ( result.is_found && depth > result.depth ) ) {
+					continue;
+				}
+
+				result.is_found = true;
+				result.depth = depth;
+				const auto d1 = GetVertexData( vi[ 0 ] );
+				const auto d2 = GetVertexData( vi[ 1 ] );
+				const auto d3 = GetVertexData( vi[ 2 ] );
+				if ( d1 == d2 && d2 == d3 ) {
+					result.data = d1;
+				}
+				else {
+					// interpolated like in shader
+					result.data = (Data::data_t)( b1 * d1 + b2 * d2 + b3 * d3 );
+				}
+			}
+		}
+	}
+
+	return result;
+}
+
+void DataIndex::Build() {
+	m_last_mesh_update_counter = m_mesh->UpdatedCount();
+	m_is_built = true;
+
+	// everything is read below anyway, later changes will be in next ranges
+	m_mesh->TakeUpdatedRanges( &m_updated_vertex_ranges, &m_updated_index_ranges, m_update_tracker );
+
+	m_cells.clear();
+	m_surface_cells.clear();
+	m_vertex_surface_offsets.clear();
+	m_vertex_surfaces.clear();
+
+	const size_t vertex_count = m_mesh->GetVertexCount();
+	const size_t surface_count = m_mesh->GetSurfaceCount();
+	if ( !vertex_count || !surface_count ) {
+		return;
+	}
+
+	Vec3 v = GetVertexCoord( 0 );
+	m_bounds.min = m_bounds.max = {
+		v.x,
+		v.y
+	};
+	m_min_z = m_max_z = v.z;
+	for ( Mesh::index_t i = 1 ; i < vertex_count ; i++ ) {
+		v = GetVertexCoord( i );
+		m_bounds.min.x = std::min< float >( m_bounds.min.x, v.x );
+		m_bounds.min.y = std::min< float >( m_bounds.min.y, v.y );
+		m_bounds.max.x = std::max< float >( m_bounds.max.x, v.x );
+		m_bounds.max.y = std::max< float >( m_bounds.max.y, v.y );
+		m_min_z = std::min< float >( m_min_z, v.z );
+		m_max_z = std::max< float >( m_max_z, v.z );
+	}
+
+	// aim for couple of surfaces per cell, with cells roughly square
+	const float width = std::max< float >( m_bounds.max.x - m_bounds.min.x, 1e-6f );
+	const float height = std::max< float >( m_bounds.max.y - m_bounds.min.y, 1e-6f );
+	const float cells = std::max< float >( surface_count / 2, 1 );
+	m_cells_width = std::max< size_t >( ceilf( sqrtf( cells * width / height ) ), 1 );
+	m_cells_height = std::max< size_t >( ceilf( cells / m_cells_width ), 1 );
+	m_cell_size = {
+		width / m_cells_width,
+		height / m_cells_height
+	};
+
+	m_cells.resize( m_cells_width * m_cells_height );
+	m_surface_cells.reserve( surface_count );
+	for ( Mesh::surface_id_t s = 0 ; s < surface_count ; s++ ) {
+		m_surface_cells.push_back( GetSurfaceCells( s ) );
+		AddSurfaceToCells( s, m_surface_cells.back() );
+	}
+
+	// count surfaces per vertex, then place them
+	const auto* indices = (const Mesh::index_t*)m_mesh->GetIndexData();
+	const size_t index_count = surface_count * Mesh::SURFACE_SIZE;
+	m_vertex_surface_offsets.resize( vertex_count + 1, 0 );
+	for ( size_t i = 0 ; i < index_count ; i++ ) {
+		m_vertex_surface_offsets[ indices[ i ] + 1 ]++;
+	}
+	for ( size_t i = 1 ; i < m_vertex_surface_offsets.size() ; i++ ) {
+		m_vertex_surface_offsets[ i ] += m_vertex_surface_offsets[ i - 1 ];
+	}
+	m_vertex_surfaces.resize( m_vertex_surface_offsets.back() );
+	std::vector< uint32_t > positions( m_vertex_surface_offsets.begin(), m_vertex_surface_offsets.end() - 1 );
+	for ( size_t i = 0 ; i < index_count ; i++ ) {
+		m_vertex_surfaces[ positions[ indices[ i ] ]++ ] = i / Mesh::SURFACE_SIZE;
+	}
+
+	m_surface_query_ids.assign( surface_count, 0 );
+	m_query_id = 0;
+}
+
+void DataIndex::Update() {
+	m_last_mesh_update_counter = m_mesh->UpdatedCount();
+
+	m_mesh->TakeUpdatedRanges( &m_updated_vertex_ranges, &m_updated_index_ranges, m_update_tracker );
+
+	if ( !m_updated_index_ranges.empty() || m_cells.empty() ) {
+		// vertices are used by different surfaces now
+		Build();
+		return;
+	}
+
+	size_t updated_vertices_count = 0;
+	for ( const auto& range : m_updated_vertex_ranges ) {
+		updated_vertices_count += range.end - range.begin;
+	}
+	if ( updated_vertices_count > m_mesh->GetVertexCount() / 4 ) {
+		// moving surfaces one by one is slower than placing all of them at once
+		Build();
+		return;
+	}
+
+	// most changes are of data only (i.e. when tile is changed), these don't move surfaces
+	const uint32_t query_id = NextQueryId();
+	Vec3 v;
+	for ( const auto& range : m_updated_vertex_ranges ) {
+		for ( Mesh::index_t i = range.begin ; i < range.end ; i++ ) {
+			v = GetVertexCoord( i );
+			if ( v.x < m_bounds.min.x || v.x > m_bounds.max.x || v.y < m_bounds.min.y || v.y > m_bounds.max.y || v.z < m_min_z || v.z > m_max_z ) {
+				// grid doesn't cover vertex anymore
+				Build();
+				return;
+			}
+			for ( size_t j = m_vertex_surface_offsets[ i ] ; j < m_vertex_surface_offsets[ i + 1 ] ; j++ ) {
+				const auto surface_id = m_vertex_surfaces[ j ];
+				if ( m_surface_query_ids[ surface_id ] == query_id ) {
+					continue;
+				}
+				m_surface_query_ids[ surface_id ] = query_id;
+				const auto cells = GetSurfaceCells( surface_id );
+				auto& old_cells = m_surface_cells[ surface_id ];
+				if ( cells.x1 != old_cells.x1 || cells.y1 != old_cells.y1 || cells.x2 != old_cells.x2 || cells.y2 != old_cells.y2 ) {
+					RemoveSurfaceFromCells( surface_id, old_cells );
+					AddSurfaceToCells( surface_id, cells );
+					old_cells = cells;
+				}
+			}
+		}
+	}
+}
+
+const uint32_t DataIndex::NextQueryId() {
+	if ( ++m_query_id == 0 ) {
+		std::fill( m_surface_query_ids.begin(), m_surface_query_ids.end(), 0 );
+		m_query_id = 1;
+	}
+	return m_query_id;
+}
+
+const DataIndex::cell_range_t DataIndex::GetSurfaceCells( const Mesh::surface_id_t surface_id ) const {
+	const auto* indices = (const Mesh::index_t*)m_mesh->GetIndexData();
+	Vec3 v = GetVertexCoord( indices[ surface_id * Mesh::SURFACE_SIZE ] );
+	float min_x = v.x, max_x = v.x, min_y = v.y, max_y = v.y;
+	for ( uint8_t j = 1 ; j < 3 ; j++ ) {
+		v = GetVertexCoord( indices[ surface_id * Mesh::SURFACE_SIZE + j ] );
+		min_x = std::min< float >( min_x, v.x );
+		max_x = std::max< float >( max_x, v.x );
+		min_y = std::min< float >( min_y, v.y );
+		max_y = std::max< float >( max_y, v.y );
+	}
+	return {
+		std::min< size_t >( ( min_x - m_bounds.min.x ) / m_cell_size.x, m_cells_width - 1 ),
+		std::min< size_t >( ( min_y - m_bounds.min.y ) / m_cell_size.y, m_cells_height - 1 ),
+		std::min< size_t >( ( max_x - m_bounds.min.x ) / m_cell_size.x, m_cells_width - 1 ),
+		std::min< size_t >( ( max_y - m_bounds.min.y ) / m_cell_size.y, m_cells_height - 1 ),
+	};
+}
+
+void DataIndex::AddSurfaceToCells( const Mesh::surface_id_t surface_id, const cell_range_t& cells ) {
+	for ( size_t cy = cells.y1 ; cy <= cells.y2 ; cy++ ) {
+		for ( size_t cx = cells.x1 ; cx <= cells.x2 ; cx++ ) {
+			m_cells[ cy * m_cells_width + cx ].push_back( surface_id );
+		}
+	}
+}
+
+void DataIndex::RemoveSurfaceFromCells( const Mesh::surface_id_t surface_id, const cell_range_t& cells ) {
+	for ( size_t cy = cells.y1 ; cy <= cells.y2 ; cy++ ) {
+		for ( size_t cx = cells.x1 ; cx <= cells.x2 ; cx++ ) {
+			auto& cell = m_cells[ cy * m_cells_width + cx ];
+			const auto it = std::find( cell.begin(), cell.end(), surface_id );
+			ASSERT( it != cell.end(), "surface not found in cell" );
+			// order of surfaces in cell doesn't matter
+			*it = cell.back();
+			cell.pop_back();
+		}
+	}
+}
+
+const Vec3 DataIndex::GetVertexCoord( const Mesh::index_t index ) const {
+	const auto* coords = (const Mesh::coord_t*)( m_mesh->GetVertexData() ) + index * Data::VERTEX_SIZE;
+	return {
+		coords[ 0 ],
+		coords[ 1 ],
+		coords[ 2 ]
+	};
+}
+
+const Data::data_t DataIndex::GetVertexData( const Mesh::index_t index ) const {
+	return *(const Data::data_t*)( (const Mesh::coord_t*)( m_mesh->GetVertexData() ) + index * Data::VERTEX_SIZE + Mesh::VERTEX_COORD_SIZE );
+}
+
+}
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <vector>
+
+#include "base/Base.h"
+
+#include "Data.h"
+#include "../Matrix44.h"
+
+namespace types {
+namespace mesh {
+
+/**
+ * Spatial index over data mesh, to find data value at screen point on cpu (without rendering data mesh and reading pixels back)
+ * Triangles are bucketed into uniform grid by their x/y bounds, query unprojects screen point into segment in mesh space
+ * and only checks triangles in cells along it. When vertices of mesh are changed, only triangles that use them are moved
+ * between cells, whole index is rebuilt only if mesh bounds or surfaces themselves were changed.
+ * Only affine (orthographic) matrices are supported.
+ */
+CLASS( DataIndex, base::Base )
+
+	DataIndex( Data* mesh );
+
+	struct result_t {
+		bool is_found = false;
+		Data::data_t data = 0;
+		float depth = 0.0f; // in normalized device coordinates, smaller is closer
+	};
+
+	// matrix is full mesh-to-screen matrix (i.e. camera * instance), x and y are in normalized device coordinates
+	const result_t GetDataAt( const Matrix44& matrix, const float x, const float y );
+
+private:
+	Data* m_mesh = nullptr;
+	Mesh::update_tracker_t m_update_tracker = 0;
+
+	size_t m_last_mesh_update_counter = 0;
+	bool m_is_built = false;
+
+	struct {
+		Vec2< float > min;
+		Vec2< float > max;
+	} m_bounds = {};
+	float m_min_z = 0.0f;
+	float m_max_z = 0.0f;
+
+	size_t m_cells_width = 0;
+	size_t m_cells_height = 0;
+	Vec2< float > m_cell_size = {};
+
+	struct cell_range_t {
+		size_t x1;
+		size_t y1;
+		size_t x2;
+		size_t y2;
+	};
+	std::vector< std::vector< Mesh::surface_id_t > > m_cells = {};
+	// cells that every surface is currently in, to remove it from them when it's moved
+	std::vector< cell_range_t > m_surface_cells = {};
+
+	// surfaces that use each vertex, vertex i owns range m_vertex_surface_offsets[ i ] .. m_vertex_surface_offsets[ i + 1 ]
+	std::vector< uint32_t > m_vertex_surface_offsets = {};
+	std::vector< Mesh::surface_id_t > m_vertex_surfaces = {};
+
+	// to avoid checking same surface twice if it spans over multiple cells (or uses multiple changed vertices)
+	std::vector< uint32_t > m_surface_query_ids = {};
+	uint32_t m_query_id = 0;
+	const uint32_t NextQueryId();
+
+	Mesh::updated_ranges_t m_updated_vertex_ranges = {};
+	Mesh::updated_ranges_t m_updated_index_ranges = {};
+
+	void Build();
+	void Update();
+	const cell_range_t GetSurfaceCells( const Mesh::surface_id_t surface_id ) const;
+	void AddSurfaceToCells( const Mesh::surface_id_t surface_id, const cell_range_t& cells );
+	void RemoveSurfaceFromCells( const Mesh::surface_id_t surface_id, const cell_range_t& cells );
+	const Vec3 GetVertexCoord( const Mesh::index_t index ) const;
+	const Data::data_t GetVertexData( const Mesh::index_t index ) const;
+};
+
+}
+}
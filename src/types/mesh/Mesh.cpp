@@ -1,4 +1,5 @@
 #include <cstring>
+#include <algorithm>
 
 #include "Mesh.h"
 
@@ -15,6 +16,7 @@ Mesh::Mesh( const mesh_type_t mesh_type, const uint8_t vertex_size, const size_t
 	, m_index_count( surface_count * SURFACE_SIZE ) {
 	m_vertex_data = (uint8_t*)malloc( GetVertexDataSize() );
 	m_index_data = (uint8_t*)malloc( GetIndexDataSize() );
+	AddUpdateTracker(); // UT_UPLOADER
 }
 
 Mesh::Mesh( const Mesh& other )
@@ -25,7 +27,7 @@ Mesh::Mesh( const Mesh& other )
 	, m_index_count( other.m_index_count )
 	, m_vertex_i( other.m_vertex_i )
 	, m_surface_i( other.m_surface_i )
-	, m_update_counter( other.m_update_counter )
+	, m_update_counter( other.m_update_counter.load() )
 	, m_is_final( other.m_is_final ) {
 	size_t sz = GetVertexDataSize();
 	m_vertex_data = (uint8_t*)malloc( sz );
@@ -33,6 +35,8 @@ Mesh::Mesh( const Mesh& other )
 	sz = GetIndexDataSize();
 	m_index_data = (uint8_t*)malloc( sz );
 	memcpy( ptr( m_index_data, 0, sz ), ptr( other.m_index_data, 0, sz ), sz );
+	// other trackers belong to consumers of original mesh
+	AddUpdateTracker(); // UT_UPLOADER
 }
 
 Mesh::~Mesh() {
@@ -67,7 +71,7 @@ Mesh::surface_id_t Mesh::AddSurface( const surface_t& surface ) {
 void Mesh::SetVertexCoord( const index_t index, const Vec3& coord ) {
 	ASSERT( index < m_vertex_count, "index out of bounds" );
 	memcpy( ptr( m_vertex_data, index * VERTEX_SIZE * sizeof( coord_t ), sizeof( coord ) ), &coord, sizeof( coord ) );
-	Update();
+	UpdateVertices( index, index + 1 );
 }
 
 void Mesh::SetVertexCoord( const index_t index, const Vec2< coord_t >& coord ) {
@@ -84,6 +88,7 @@ void Mesh::SetSurface( const index_t index, const surface_t& surface ) {
 	ASSERT( index < m_surface_count, "surface out of bounds" );
 	// add triangle
 	memcpy( ptr( m_index_data, index * SURFACE_SIZE * sizeof( index_t ), sizeof( surface ) ), &surface, sizeof( surface ) );
+	UpdateIndices( index * SURFACE_SIZE, ( index + 1 ) * SURFACE_SIZE );
 }
 
 void Mesh::Finalize() {
@@ -128,11 +133,171 @@ const uint8_t* Mesh::GetIndexData() const {
 }
 
 void Mesh::Update() {
-	m_update_counter++;
+	UpdateVertices( 0, m_vertex_count );
+	UpdateIndices( 0, m_index_count );
+}
+
+void Mesh::UpdateVertices( const index_t begin, const index_t end ) {
+	ASSERT( begin <= end, "invalid vertex range" );
+	ASSERT( end <= m_vertex_count, "vertex range out of bounds" );
+	const update_tracker_t trackers_count = m_update_trackers_count.load( std::memory_order_acquire );
+	for ( update_tracker_t tracker = 0 ; tracker < trackers_count ; tracker++ ) {
+		SetUpdatedBits( m_update_trackers[ tracker ].vertices, begin, end );
+	}
+	// after bits so that whoever sees new counter also sees bits
+	m_update_counter.fetch_add( 1, std::memory_order_release );
+}
+
+void Mesh::UpdateIndices( const index_t begin, const index_t end ) {
+	ASSERT( begin <= end, "invalid index range" );
+	ASSERT( end <= m_index_count, "index range out of bounds" );
+	const update_tracker_t trackers_count = m_update_trackers_count.load( std::memory_order_acquire );
+	for ( update_tracker_t tracker = 0 ; tracker < trackers_count ; tracker++ ) {
+		SetUpdatedBits( m_update_trackers[ tracker ].indices, begin, end );
+	}
+	m_update_counter.fetch_add( 1, std::memory_order_release );
+}
+
+const Mesh::update_tracker_t Mesh::AddUpdateTracker() {
+	const update_tracker_t tracker = m_update_trackers_count.load( std::memory_order_relaxed );
+	ASSERT( tracker < MAX_UPDATE_TRACKERS, "too many update trackers" );
+	auto& bits = m_update_trackers[ tracker ];
+	// atomics can't be moved, so vectors can't be resized
+	updated_bits_t( ( m_vertex_count + 63 ) / 64 ).swap( bits.vertices );
+	updated_bits_t( ( m_index_count + 63 ) / 64 ).swap( bits.indices );
+	// writers start marking bits of tracker only after it's fully allocated
+	m_update_trackers_count.store( tracker + 1, std::memory_order_release );
+	return tracker;
+}
+
+void Mesh::TakeUpdatedRanges( updated_ranges_t* vertex_ranges, updated_ranges_t* index_ranges, const update_tracker_t tracker ) {
+	ASSERT( tracker < m_update_trackers_count.load( std::memory_order_acquire ), "update tracker does not exist" );
+	auto& bits = m_update_trackers[ tracker ];
+	TakeUpdatedBits( bits.vertices, m_vertex_count, vertex_ranges );
+	TakeUpdatedBits( bits.indices, m_index_count, index_ranges );
+}
+
+void Mesh::SetUpdatedBits( updated_bits_t& bits, const size_t begin, const size_t end ) {
+	size_t i = begin;
+	size_t bit, count;
+	uint64_t mask;
+	while ( i < end ) {
+		bit = i % 64;
+		count = std::min< size_t >( 64 - bit, end - i );
+		mask = count == 64
+			? ~(uint64_t)0
+			: ( ( (uint64_t)1 << count ) - 1 ) << bit;
+		auto& word = bits[ i / 64 ];
+		// same vertices are often changed repeatedly before upload, don't write to shared cache line if bits are already set
+		if ( ( word.load( std::memory_order_relaxed ) & mask ) != mask ) {
+			word.fetch_or( mask, std::memory_order_release );
+		}
+		i += count;
+	}
+}
+
+void Mesh::TakeUpdatedBits( updated_bits_t& bits, const size_t count, updated_ranges_t* ranges ) {
+	ranges->clear();
+	bool is_in_range = false;
+	size_t range_begin = 0;
+	uint64_t word;
+	for ( size_t w = 0 ; w < bits.size() ; w++ ) {
+		word = bits[ w ].load( std::memory_order_relaxed );
+		if ( word ) {
+			// bits set after this are kept for next call
+			word = bits[ w ].exchange( 0, std::memory_order_acquire );
+		}
+		if ( !word || word == ~(uint64_t)0 ) {
+			// whole word continues or ends current range
+			if ( !word && is_in_range ) {
+				AddUpdatedRange( *ranges, range_begin, w * 64 );
+				is_in_range = false;
+			}
+			else if ( word && !is_in_range ) {
+				range_begin = w * 64;
+				is_in_range = true;
+			}
+			continue;
+		}
+		for ( size_t bit = 0 ; bit < 64 ; bit++ ) {
+			if ( word & ( (uint64_t)1 << bit ) ) {
+				if ( !is_in_range ) {
+					range_begin = w * 64 + bit;
+					is_in_range = true;
+				}
+			}
+			else if ( is_in_range ) {
+				AddUpdatedRange( *ranges, range_begin, w * 64 + bit );
+				is_in_range = false;
+			}
+		}
+	}
+	if ( is_in_range ) {
+		AddUpdatedRange( *ranges, range_begin, count );
+	}
+}
+
+void Mesh::AddUpdatedRange( updated_ranges_t& ranges, const size_t begin, const size_t end ) {
+	if ( begin == end ) {
+		return;
+	}
+
+	// fast path for sequential writes
+	if ( !ranges.empty() ) {
+		auto& last = ranges.back();
+		if ( begin >= last.begin && begin <= last.end ) {
+			if ( end > last.end ) {
+				last.end = end;
+			}
+			return;
+		}
+	}
+
+	// ranges are kept sorted and non-overlapping, find first range that ends at or after new one begins
+	auto it = std::lower_bound(
+		ranges.begin(), ranges.end(), begin, []( const updated_range_t& range, const size_t value ) -> bool {
+			return range.end < value;
+		}
+	);
+	if ( it == ranges.end() || it->begin > end ) {
+		// doesn't touch anything, insert as is
+		ranges.insert(
+			it, {
+				begin,
+				end
+			}
+		);
+	}
+	else {
+		// merge with all touching ranges
+		it->begin = std::min( it->begin, begin );
+		it->end = std::max( it->end, end );
+		auto next = it + 1;
+		while ( next != ranges.end() && next->begin <= it->end ) {
+			it->end = std::max( it->end, next->end );
+			next++;
+		}
+		ranges.erase( it + 1, next );
+	}
+
+	if ( ranges.size() > MAX_UPDATED_RANGES ) {
+		// merge two closest neighbours
+		size_t best = 0;
+		size_t best_gap = SIZE_MAX;
+		for ( size_t i = 0 ; i < ranges.size() - 1 ; i++ ) {
+			const size_t gap = ranges[ i + 1 ].begin - ranges[ i ].end;
+			if ( gap < best_gap ) {
+				best_gap = gap;
+				best = i;
+			}
+		}
+		ranges[ best ].end = ranges[ best + 1 ].end;
+		ranges.erase( ranges.begin() + best + 1 );
+	}
 }
 
 const size_t Mesh::UpdatedCount() const {
-	return m_update_counter;
+	return m_update_counter.load( std::memory_order_acquire );
 }
 
 const Mesh::mesh_type_t Mesh::GetType() const {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <vector>
+#include <atomic>
 
 #include "types/Serializable.h"
 
@@ -57,9 +58,32 @@ CLASS( Mesh, Serializable )
 	const size_t GetIndexDataSize() const;
 	const uint8_t* GetIndexData() const;
 
-	void Update();
+	// ranges of vertices or indices that were changed since last TakeUpdatedRanges() call
+	// begin is inclusive, end is exclusive
+	struct updated_range_t {
+		size_t begin;
+		size_t end;
+	};
+	typedef std::vector< updated_range_t > updated_ranges_t;
+	// adds range while keeping ranges sorted, merged and limited in count
+	static void AddUpdatedRange( updated_ranges_t& ranges, const size_t begin, const size_t end );
+
+	// only mark changes (without locking), so they are cheap enough to be called for every single vertex, even from multiple threads
+	void Update(); // everything changed
+	void UpdateVertices( const index_t begin, const index_t end ); // only some vertices changed
+	void UpdateIndices( const index_t begin, const index_t end ); // only some indices changed
 	const size_t UpdatedCount() const;
 
+	// every consumer of updated ranges has its own tracker, ranges taken from one tracker are still pending in others
+	typedef uint8_t update_tracker_t;
+	static constexpr update_tracker_t UT_UPLOADER = 0; // exists always
+	// for other consumers (i.e. cpu side indices of mesh), must not be called while someone else adds tracker too
+	const update_tracker_t AddUpdateTracker();
+
+	// moves ranges accumulated since previous call with same tracker out of mesh
+	// there is exactly one uploader per mesh (graphics backend that renders it) and exactly one consumer per other tracker
+	void TakeUpdatedRanges( updated_ranges_t* vertex_ranges, updated_ranges_t* index_ranges, const update_tracker_t tracker = UT_UPLOADER );
+
 	const mesh_type_t GetType() const;
 
 	const Buffer Serialize() const override;
@@ -81,7 +105,24 @@ protected:
 	surface_id_t m_surface_i = 0;
 	uint8_t* m_index_data = nullptr;
 
-	size_t m_update_counter = 0;
+	std::atomic< size_t > m_update_counter = 0;
+
+private:
+
+	// too many small ranges cost more (in draw calls) than uploading some unchanged data in between
+	static constexpr size_t MAX_UPDATED_RANGES = 32;
+
+	// one bit per vertex or index, converted to ranges only when they are taken
+	typedef std::vector< std::atomic< uint64_t > > updated_bits_t;
+	static constexpr update_tracker_t MAX_UPDATE_TRACKERS = 4;
+	struct update_tracker_bits_t {
+		updated_bits_t vertices;
+		updated_bits_t indices;
+	};
+	update_tracker_bits_t m_update_trackers[ MAX_UPDATE_TRACKERS ] = {};
+	std::atomic< update_tracker_t > m_update_trackers_count = 0;
+	static void SetUpdatedBits( updated_bits_t& bits, const size_t begin, const size_t end );
+	static void TakeUpdatedBits( updated_bits_t& bits, const size_t count, updated_ranges_t* ranges );
 };
 
 }
@@ -45,7 +45,7 @@ void Render::SetVertex( const index_t index, const Vec3& coord, const Vec2< coor
 	memcpy( ptr( m_vertex_data, offset, sizeof( tint ) ), &tint, sizeof( tint ) );
 	offset += VERTEX_TINT_SIZE * sizeof( coord_t );
 	memcpy( ptr( m_vertex_data, offset, sizeof( normal ) ), &normal, sizeof( normal ) );
-	Update();
+	UpdateVertices( index, index + 1 );
 }
 
 void Render::SetVertex( const index_t index, const Vec2< coord_t >& coord, const Vec2< coord_t >& tex_coord, const Color tint, const Vec3& normal ) {
@@ -61,17 +61,19 @@ void Render::SetVertex( const index_t index, const Vec2< coord_t >& coord, const
 void Render::SetVertexTexCoord( const index_t index, const Vec2< coord_t >& tex_coord ) {
 	ASSERT( index < m_vertex_count, "index out of bounds" );
 	memcpy( ptr( m_vertex_data, index * VERTEX_SIZE * sizeof( coord_t ) + VERTEX_COORD_SIZE * sizeof( coord_t ), sizeof( tex_coord ) ), &tex_coord, sizeof( tex_coord ) );
-	Update();
+	UpdateVertices( index, index + 1 );
 }
 
 void Render::SetVertexTint( const index_t index, const Color tint ) {
 	ASSERT( index < m_vertex_count, "index out of bounds" );
 	memcpy( ptr( m_vertex_data, index * VERTEX_SIZE * sizeof( coord_t ) + ( VERTEX_COORD_SIZE + VERTEX_TEXCOORD_SIZE ) * sizeof( coord_t ), sizeof( Color ) ), &tint, sizeof( tint ) );
+	UpdateVertices( index, index + 1 );
 }
 
 void Render::SetVertexNormal( const index_t index, const Vec3& normal ) {
 	ASSERT( index < m_vertex_count, "index out of bounds" );
 	memcpy( ptr( m_vertex_data, index * VERTEX_SIZE * sizeof( coord_t ) + ( VERTEX_COORD_SIZE + VERTEX_TEXCOORD_SIZE + VERTEX_TINT_SIZE ) * sizeof( coord_t ), sizeof( normal ) ), &normal, sizeof( normal ) );
+	UpdateVertices( index, index + 1 );
 }
 
 void Render::GetVertexTexCoord( const index_t index, Vec2< coord_t >* coord ) const {
@@ -147,9 +149,11 @@ void Render::UpdateNormals( const std::vector< surface_id_t >& surfaces ) {
 		*(Vec3*)ptr( m_vertex_data, ( surface->v3 * VERTEX_SIZE + vo ) * sizeof( coord_t ), sizeof( Vec3 ) )
 			=
 			Math::Normalize( *(Vec3*)ptr( m_vertex_data, ( surface->v3 * VERTEX_SIZE + vo ) * sizeof( coord_t ), sizeof( Vec3 ) ) );
-	}
 
-	Update();
+		UpdateVertices( surface->v1, surface->v1 + 1 );
+		UpdateVertices( surface->v2, surface->v2 + 1 );
+		UpdateVertices( surface->v3, surface->v3 + 1 );
+	}
 }
 
 void Render::UpdateAllNormals() {
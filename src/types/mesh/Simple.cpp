@@ -34,7 +34,7 @@ void Simple::SetVertex( const index_t index, const Vec3& coord, const Vec2< coor
 	memcpy( ptr( m_vertex_data, offset, sizeof( coord ) ), &coord, sizeof( coord ) );
 	offset += VERTEX_COORD_SIZE * sizeof( coord_t );
 	memcpy( ptr( m_vertex_data, offset, sizeof( tex_coord ) ), &tex_coord, sizeof( tex_coord ) );
-	Update();
+	UpdateVertices( index, index + 1 );
 }
 
 void Simple::SetVertex( const index_t index, const Vec2< coord_t >& coord, const Vec2< coord_t >& tex_coord ) {
@@ -50,7 +50,7 @@ void Simple::SetVertex( const index_t index, const Vec2< coord_t >& coord, const
 void Simple::SetVertexTexCoord( const index_t index, const Vec2< coord_t >& tex_coord ) {
 	ASSERT( index < m_vertex_count, "index out of bounds" );
 	memcpy( ptr( m_vertex_data, index * VERTEX_SIZE * sizeof( coord_t ) + VERTEX_COORD_SIZE * sizeof( coord_t ), sizeof( tex_coord ) ), &tex_coord, sizeof( tex_coord ) );
-	Update();
+	UpdateVertices( index, index + 1 );
 }
 
 void Simple::GetVertexTexCoord( const index_t index, Vec2< coord_t >* coord ) const {
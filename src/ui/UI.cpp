@@ -189,8 +189,23 @@ void UI::Iterate() {
 		m_iterative_objects_to_remove.clear();
 	}
 
+	auto* frame_scheduler = Thread::GetCurrent()
+		? Thread::GetCurrent()->GetFrameScheduler()
+		: nullptr;
 	for ( auto& it : m_iterative_objects ) {
-		it.second();
+		auto& o = it.second;
+		if (
+			o.is_deferrable &&
+				o.deferred_frames_count < MAX_DEFERRED_FRAMES &&
+				frame_scheduler &&
+				frame_scheduler->IsOverBudget()
+			) {
+			o.deferred_frames_count++;
+			STAT_INC( ui_iterative_deferred );
+			continue;
+		}
+		o.deferred_frames_count = 0;
+		o.handler();
 	}
 
 	if ( m_is_redraw_needed ) {
@@ -234,6 +249,16 @@ void UI::ProcessEvent( UIEvent* event ) {
 		return;
 	}
 
+	// toggle profiler
+	if (
+		event->m_type == UIEvent::EV_KEY_DOWN &&
+			( event->m_data.key.modifiers & UIEvent::KM_CTRL ) &&
+			event->m_data.key.code == UIEvent::K_GRAVE
+		) {
+		g_engine->ToggleProfiler();
+		return;
+	}
+
 	// modules block other ui when active
 	if (
 		m_active_module
@@ -438,8 +463,12 @@ const theme::Style* UI::GetStyle( const std::string& style_class ) const {
 	return nullptr;
 }
 
-void UI::AddIterativeObject( void* object, const ui_handler_t handler ) {
-	m_iterative_objects[ object ] = handler;
+void UI::AddIterativeObject( void* object, const ui_handler_t handler, const bool is_deferrable ) {
+	m_iterative_objects[ object ] = {
+		handler,
+		is_deferrable,
+		0
+	};
 }
 
 void UI::RemoveIterativeObject( void* object ) {
@@ -83,7 +83,8 @@ CLASS( UI, base::Module )
 
 	const theme::Style* GetStyle( const std::string& style_class ) const;
 
-	void AddIterativeObject( void* object, const ui_handler_t handler );
+	// deferrable handlers are skipped while frame is over budget (for cosmetic stuff like animations)
+	void AddIterativeObject( void* object, const ui_handler_t handler, const bool is_deferrable = false );
 	void RemoveIterativeObject( void* object );
 
 	module::Error* GetError() const;
@@ -163,7 +164,14 @@ private:
 	module::Error* m_error = nullptr;
 	module::Loader* m_loader = nullptr;
 
-	std::unordered_map< void*, ui_handler_t > m_iterative_objects = {};
+	struct iterative_object_t {
+		ui_handler_t handler;
+		bool is_deferrable;
+		uint8_t deferred_frames_count;
+	};
+	// deferrable handler is still called if it was skipped this many frames in row
+	static const uint8_t MAX_DEFERRED_FRAMES = 10;
+	std::unordered_map< void*, iterative_object_t > m_iterative_objects = {};
 	std::vector< void* > m_iterative_objects_to_remove = {};
 
 	std::vector< Popup* > m_popups = {};
@@ -99,7 +99,7 @@ void Loader::Start() {
 			if ( m_label ) {
 				m_label->SetText( m_loading_text + GetDots() );
 			}
-		}
+		}, true // loading text can wait
 	);
 
 	Activate();
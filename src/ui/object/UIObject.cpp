@@ -50,8 +50,8 @@ UIObject::~UIObject() {
 
 void UIObject::Create() {
 
-	DEBUG_STAT_INC( ui_elements_created );
-	DEBUG_STAT_INC( ui_elements_active );
+	STAT_INC( ui_elements_created );
+	STAT_INC( ui_elements_active );
 
 	m_style_modifiers = Style::M_NONE;
 
@@ -69,8 +69,8 @@ void UIObject::Destroy() {
 		g_engine->GetUI()->RemoveFromFocusableObjects( this );
 	}
 
-	DEBUG_STAT_INC( ui_elements_destroyed );
-	DEBUG_STAT_DEC( ui_elements_active );
+	STAT_INC( ui_elements_destroyed );
+	STAT_DEC( ui_elements_active );
 }
 
 void UIObject::Iterate() {
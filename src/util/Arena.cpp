@@ -0,0 +1,98 @@
+#include <cstring>
+#include <algorithm>
+
+#include "Arena.h"
+
+namespace util {
+
+Arena::Arena( const size_t block_size )
+	: m_block_size( block_size ) {
+	ASSERT( m_block_size > 0, "arena block size is zero" );
+}
+
+Arena::~Arena() {
+	for ( auto& block : m_blocks ) {
+		free( block.data );
+	}
+	STAT_CHANGE_BY( arena_blocks_active, -(ssize_t)m_blocks.size() );
+	STAT_CHANGE_BY( arena_reserved_size, -(ssize_t)m_reserved_size );
+}
+
+void* Arena::Allocate( const size_t size, const size_t alignment ) {
+	ASSERT( alignment && !( alignment & ( alignment - 1 ) ), "arena alignment must be power of two" );
+
+	const auto f_get_offset = [ alignment ]( const block_t& block ) -> size_t {
+		return ( ( (size_t)block.data + block.used + alignment - 1 ) & ~( alignment - 1 ) ) - (size_t)block.data;
+	};
+
+	if ( !m_blocks.empty() ) {
+		auto* block = &m_blocks[ m_block_index ];
+		size_t offset = f_get_offset( *block );
+		// blocks after current one are either unused or were rewound
+		while ( offset + size > block->size && m_block_index + 1 < m_blocks.size() ) {
+			block = &m_blocks[ ++m_block_index ];
+			offset = f_get_offset( *block );
+		}
+		if ( offset + size <= block->size ) {
+			m_used_size += offset - block->used + size;
+			block->used = offset + size;
+			unsigned char* result = block->data + offset;
+			memset( result, 0, size );
+			return result;
+		}
+	}
+
+	// oversized allocations get their own block
+	const size_t block_size = std::max( m_block_size, size + alignment );
+	block_t block = {
+		(unsigned char*)malloc( block_size ),
+		block_size,
+		0
+	};
+	m_blocks.push_back( block );
+	m_block_index = m_blocks.size() - 1;
+	m_reserved_size += block_size;
+	STAT_INC( arena_blocks_active );
+	STAT_CHANGE_BY( arena_reserved_size, block_size );
+
+	return Allocate( size, alignment );
+}
+
+void Arena::Reset() {
+	Rewind( 0, 0, 0 );
+}
+
+const size_t Arena::GetUsedSize() const {
+	return m_used_size;
+}
+
+const size_t Arena::GetReservedSize() const {
+	return m_reserved_size;
+}
+
+void Arena::Rewind( const size_t block_index, const size_t block_used, const size_t used_size ) {
+	if ( !m_blocks.empty() ) {
+		for ( size_t i = block_index + 1 ; i <= m_block_index ; i++ ) {
+			m_blocks[ i ].used = 0;
+		}
+		m_blocks[ block_index ].used = block_used;
+	}
+	m_block_index = block_index;
+	m_used_size = used_size;
+}
+
+Arena::Scope::Scope( Arena* arena )
+	: m_arena( arena )
+	, m_block_index( arena->m_block_index )
+	, m_block_used(
+		arena->m_blocks.empty()
+			? 0
+			: arena->m_blocks[ arena->m_block_index ].used
+	)
+	, m_used_size( arena->m_used_size ) {}
+
+Arena::Scope::~Scope() {
+	m_arena->Rewind( m_block_index, m_block_used, m_used_size );
+}
+
+} /* namespace util */
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+#include "Util.h"
+
+namespace util {
+
+// bump allocator, everything allocated from it is released at once (by Reset() or destruction)
+// destructors of objects placed into arena are never called, so only use it for plain data (or call them manually)
+CLASS( Arena, Util )
+
+	Arena( const size_t block_size = 1024 * 1024 );
+	~Arena();
+
+	// returned memory is zeroed
+	void* Allocate( const size_t size, const size_t alignment = alignof( std::max_align_t ) );
+	template< typename T >
+	T* AllocateArray( const size_t count ) {
+		return (T*)Allocate( sizeof( T ) * count, alignof( T ) );
+	}
+
+	// forgets all allocations, blocks are kept for reuse
+	void Reset();
+
+	const size_t GetUsedSize() const;
+	const size_t GetReservedSize() const;
+
+	// everything allocated from arena during lifetime of scope is forgotten when scope ends (for scratch data)
+	class Scope {
+	public:
+		Scope( Arena* arena );
+		~Scope();
+	private:
+		Arena* const m_arena;
+		const size_t m_block_index;
+		const size_t m_block_used;
+		const size_t m_used_size;
+	};
+
+private:
+
+	struct block_t {
+		unsigned char* data;
+		size_t size;
+		size_t used;
+	};
+
+	const size_t m_block_size;
+	std::vector< block_t > m_blocks = {};
+	size_t m_block_index = 0;
+	size_t m_used_size = 0;
+	size_t m_reserved_size = 0;
+
+	void Rewind( const size_t block_index, const size_t block_used, const size_t used_size );
+
+};
+
+// lets standard containers allocate from arena, memory of shrunk or reallocated containers is only reclaimed when arena is reset
+template< typename T >
+class ArenaAllocator {
+public:
+	typedef T value_type;
+
+	ArenaAllocator( Arena* arena )
+		: m_arena( arena ) {}
+	template< typename U >
+	ArenaAllocator( const ArenaAllocator< U >& other )
+		: m_arena( other.m_arena ) {}
+
+	T* allocate( const size_t count ) {
+		return m_arena->AllocateArray< T >( count );
+	}
+	void deallocate( T* ptr, const size_t count ) {}
+
+	template< typename U >
+	const bool operator==( const ArenaAllocator< U >& other ) const {
+		return m_arena == other.m_arena;
+	}
+	template< typename U >
+	const bool operator!=( const ArenaAllocator< U >& other ) const {
+		return m_arena != other.m_arena;
+	}
+
+private:
+	template< typename U >
+	friend class ArenaAllocator;
+
+	Arena* m_arena;
+};
+
+} /* namespace util */
@@ -0,0 +1,27 @@
+#include <sstream>
+#include <iomanip>
+
+#include "Hash.h"
+
+namespace util {
+
+const uint64_t Hash::Get( const unsigned char* data, const size_t size ) {
+	uint64_t hash = 0xcbf29ce484222325;
+	for ( size_t i = 0 ; i < size ; i++ ) {
+		hash ^= data[ i ];
+		hash *= 0x100000001b3;
+	}
+	return hash;
+}
+
+const uint64_t Hash::Get( const std::string& data ) {
+	return Get( (const unsigned char*)data.data(), data.size() );
+}
+
+const std::string Hash::ToString( const uint64_t hash ) {
+	std::stringstream result;
+	result << std::hex << std::setw( 16 ) << std::setfill( '0' ) << hash;
+	return result.str();
+}
+
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <string>
+
+#include "Util.h"
+
+namespace util {
+
+// non-cryptographic, for cache keys and such
+CLASS( Hash, Util )
+
+	// FNV-1a
+	static const uint64_t Get( const unsigned char* data, const size_t size );
+	static const uint64_t Get( const std::string& data );
+
+	static const std::string ToString( const uint64_t hash );
+
+};
+
+}
@@ -0,0 +1,61 @@
+#ifndef _WIN32
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#endif
+
+#include "MappedFile.h"
+
+#include "FS.h"
+
+namespace util {
+
+MappedFile::MappedFile( const std::string& path ) {
+#ifdef _WIN32
+	if ( FS::FileExists( path ) ) {
+		m_buffer = FS::ReadFile( path );
+		m_data = (const unsigned char*)m_buffer.data();
+		m_size = m_buffer.size();
+	}
+#else
+	const int fd = open( path.c_str(), O_RDONLY );
+	if ( fd < 0 ) {
+		return;
+	}
+	struct stat st = {};
+	if ( !fstat( fd, &st ) && S_ISREG( st.st_mode ) && st.st_size > 0 ) {
+		void* data = mmap( nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+		if ( data != MAP_FAILED ) {
+			m_data = (const unsigned char*)data;
+			m_size = st.st_size;
+		}
+	}
+	// mapping stays valid after descriptor is closed
+	close( fd );
+#endif
+}
+
+MappedFile::~MappedFile() {
+#ifndef _WIN32
+	if ( m_data ) {
+		munmap( (void*)m_data, m_size );
+	}
+#endif
+}
+
+const bool MappedFile::IsMapped() const {
+	return m_data != nullptr;
+}
+
+const unsigned char* MappedFile::GetData() const {
+	return m_data;
+}
+
+const size_t MappedFile::GetSize() const {
+	return m_size;
+}
+
+}
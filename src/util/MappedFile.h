@@ -0,0 +1,36 @@
+#pragma once
+
+#include <string>
+
+#include "Util.h"
+
+namespace util {
+
+// read-only view of whole file, memory-mapped where supported so that pages are loaded lazily by os
+CLASS( MappedFile, Util )
+
+	MappedFile( const std::string& path );
+	~MappedFile();
+
+	// mapping would be unmapped twice
+	MappedFile( const MappedFile& other ) = delete;
+	MappedFile& operator=( const MappedFile& other ) = delete;
+
+	// false if file does not exist or can't be read
+	const bool IsMapped() const;
+
+	const unsigned char* GetData() const;
+	const size_t GetSize() const;
+
+private:
+	const unsigned char* m_data = nullptr;
+	size_t m_size = 0;
+
+#ifdef _WIN32
+	// no mmap, file is read into memory instead
+	std::string m_buffer = "";
+#endif
+
+};
+
+}